@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Render target that only does the active-target bookkeeping,
+    // so that nothing else shows in the measurements
+    class BookkeepingTarget : public sf::RenderTarget
+    {
+    public:
+
+        BookkeepingTarget()
+        {
+            initialize();
+        }
+
+        virtual sf::Vector2u getSize() const
+        {
+            return sf::Vector2u(0, 0);
+        }
+
+        virtual bool setActive(bool active)
+        {
+            return sf::RenderTarget::setActive(active);
+        }
+    };
+
+    // Activates its own targets in a loop, like a thread drawing to its own render textures
+    struct Worker
+    {
+        Worker(unsigned int iterations, bool switchTargets) :
+        iterations   (iterations),
+        switchTargets(switchTargets)
+        {
+        }
+
+        void run()
+        {
+            BookkeepingTarget targets[2];
+
+            for (unsigned int i = 0; i < iterations; ++i)
+                targets[switchTargets ? (i & 1) : 0].setActive(true);
+
+            targets[0].setActive(false);
+        }
+
+        unsigned int iterations;
+        bool         switchTargets;
+    };
+
+    // Run the workers on the given number of threads, return the wall-clock time per activation
+    // (it decreases with more threads as long as they don't serialize each other)
+    double measure(unsigned int threadCount, unsigned int iterations, bool switchTargets)
+    {
+        std::vector<Worker*> workers;
+        std::vector<sf::Thread*> threads;
+
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            workers.push_back(new Worker(iterations, switchTargets));
+            threads.push_back(new sf::Thread(&Worker::run, workers.back()));
+        }
+
+        sf::Clock clock;
+
+        for (unsigned int i = 0; i < threadCount; ++i)
+            threads[i]->launch();
+
+        for (unsigned int i = 0; i < threadCount; ++i)
+            threads[i]->wait();
+
+        sf::Time elapsed = clock.getElapsedTime();
+
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            delete threads[i];
+            delete workers[i];
+        }
+
+        return elapsed.asMicroseconds() * 1000.0 / (static_cast<double>(iterations) * threadCount);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    const unsigned int iterations = 1000000;
+    const unsigned int threadCounts[] = {1, 2, 4, 8};
+
+    std::cout << "Wall-clock cost of RenderTarget::setActive(true), in nanoseconds per call" << std::endl;
+    std::cout << std::endl;
+    std::cout << "threads   same target   alternating targets" << std::endl;
+
+    for (std::size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); ++i)
+    {
+        double same = measure(threadCounts[i], iterations, false);
+        double alternating = measure(threadCounts[i], iterations, true);
+
+        std::cout << std::setw(7) << threadCounts[i]
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << same
+                  << std::setw(22) << alternating << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
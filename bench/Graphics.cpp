@@ -0,0 +1,596 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <SFML/OpenGL.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+// Running headless
+//
+// The benchmarks only draw to render textures, but SFML still
+// needs a display to create OpenGL contexts. On a Linux box
+// without GPU or display, run them on Mesa's software renderer
+// inside a virtual framebuffer:
+//
+//   export LIBGL_ALWAYS_SOFTWARE=1 GALLIUM_DRIVER=llvmpipe
+//   xvfb-run -a ./sfml-bench-graphics --json > results.json
+//
+// The renderer reported in the results tells which driver was
+// actually used, so that runs on different machines or drivers
+// are not compared with each other by mistake.
+//
+// With --core, the render textures use an OpenGL 3.2 core
+// profile context, which exercises the shader based backend.
+// Errors reported by SFML during the run (e.g. a shader of the
+// backend or of the distance field fonts that fails to compile
+// or link) make the benchmark exit with a failure, so that it
+// can be used as a check of that backend:
+//
+//   xvfb-run -a ./sfml-bench-graphics --core --time 0.1
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_BENCH_FONT
+    #define SFML_BENCH_FONT "resources/sansation.ttf"
+#endif
+
+
+namespace
+{
+    // Resources shared by the benchmarks, created once
+    struct Fixture
+    {
+        sf::RenderTexture       target;
+        sf::RenderTexture       smallTargets[2];
+        sf::Texture             texture;
+        sf::Font                font;
+        sf::Font                fieldFont;
+        bool                    fontLoaded;
+        sf::Text                text;
+        sf::Text                fieldText;
+        sf::TextBatch           textBatch;
+        sf::VertexBuffer        vertexBuffer;
+        std::vector<sf::Vertex> vertices;
+        unsigned int            frame;
+    };
+
+    // Draws one frame of a benchmark, returns the number of items processed
+    typedef double (*FrameFunction)(Fixture& fixture);
+
+    struct Benchmark
+    {
+        const char*   name;
+        const char*   unit;
+        double        scale; // Divides the number of items, to get the unit
+        FrameFunction frame;
+        bool          needsFont;
+    };
+
+    struct Result
+    {
+        std::string  name;
+        std::string  unit;
+        double       rate;
+        unsigned int frames;
+        double       seconds;
+        bool         skipped;
+    };
+
+    const unsigned int targetWidth  = 1024;
+    const unsigned int targetHeight = 768;
+
+    // Position of the index-th item of a frame, scattered over the target
+    sf::Vector2f scatter(unsigned int index, unsigned int frame)
+    {
+        unsigned int hash = (index + frame) * 2654435761u;
+        return sf::Vector2f(static_cast<float>(hash % targetWidth),
+                            static_cast<float>((hash >> 16) % targetHeight));
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    double drawSprites(Fixture& fixture, bool batched)
+    {
+        const unsigned int count = 2000;
+
+        sf::Sprite sprite(fixture.texture, sf::IntRect(0, 0, 32, 32));
+
+        fixture.target.setBatchingEnabled(batched);
+        fixture.target.clear();
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            sprite.setPosition(scatter(i, fixture.frame));
+            sprite.setRotation(static_cast<float>(i % 360));
+            fixture.target.draw(sprite);
+        }
+
+        fixture.target.display();
+        fixture.target.setBatchingEnabled(false);
+
+        return count;
+    }
+
+    double sprites(Fixture& fixture)
+    {
+        return drawSprites(fixture, false);
+    }
+
+    double spritesBatched(Fixture& fixture)
+    {
+        return drawSprites(fixture, true);
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    double textDraw(Fixture& fixture)
+    {
+        const unsigned int count = 200;
+
+        fixture.target.clear();
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            fixture.text.setPosition(scatter(i, fixture.frame));
+            fixture.target.draw(fixture.text);
+        }
+
+        fixture.target.display();
+
+        return static_cast<double>(count) * fixture.text.getString().getSize();
+    }
+
+    double textDistanceField(Fixture& fixture)
+    {
+        const unsigned int count = 200;
+
+        // Same labels as text-draw, with a distance field font (drawn with a shader)
+        fixture.fieldText.setString(fixture.text.getString());
+
+        fixture.target.clear();
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            fixture.fieldText.setPosition(scatter(i, fixture.frame));
+            fixture.target.draw(fixture.fieldText);
+        }
+
+        fixture.target.display();
+
+        return static_cast<double>(count) * fixture.fieldText.getString().getSize();
+    }
+
+    double textBatchDraw(Fixture& fixture)
+    {
+        const unsigned int count = 200;
+
+        // Same labels as text-draw, but drawn from a single batch
+        if (fixture.textBatch.getEntryCount() != count)
+        {
+            fixture.textBatch.clear();
+            for (unsigned int i = 0; i < count; ++i)
+                fixture.textBatch.add(fixture.text.getString(), sf::Vector2f());
+        }
+
+        for (unsigned int i = 0; i < count; ++i)
+            fixture.textBatch.setEntryPosition(i, scatter(i, fixture.frame));
+
+        fixture.target.clear();
+        fixture.target.draw(fixture.textBatch);
+        fixture.target.display();
+
+        return static_cast<double>(count) * fixture.text.getString().getSize();
+    }
+
+    double textUpdate(Fixture& fixture)
+    {
+        const unsigned int count = 200;
+
+        fixture.target.clear();
+
+        // Change the string of every text, as a HUD or a chat box would
+        std::ostringstream stream;
+        double glyphs = 0.0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            stream.str("");
+            stream << "Score " << (fixture.frame * count + i) << " - the quick brown fox jumps over the lazy dog";
+
+            fixture.text.setString(stream.str());
+            fixture.text.setPosition(scatter(i, fixture.frame));
+            fixture.target.draw(fixture.text);
+
+            glyphs += fixture.text.getString().getSize();
+        }
+
+        fixture.target.display();
+
+        return glyphs;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    double shapes(Fixture& fixture)
+    {
+        const unsigned int count = 500;
+
+        sf::CircleShape circle(12.f, 30);
+        circle.setFillColor(sf::Color(255, 128, 0));
+        circle.setOutlineColor(sf::Color::White);
+        circle.setOutlineThickness(1.f);
+
+        sf::RectangleShape rectangle(sf::Vector2f(24.f, 16.f));
+        rectangle.setFillColor(sf::Color(0, 128, 255));
+
+        fixture.target.clear();
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            circle.setPosition(scatter(i, fixture.frame));
+            fixture.target.draw(circle);
+
+            rectangle.setPosition(scatter(i + count, fixture.frame));
+            rectangle.setRotation(static_cast<float>(i % 360));
+            fixture.target.draw(rectangle);
+        }
+
+        fixture.target.display();
+
+        return count * 2;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    double vertexBufferUpload(Fixture& fixture)
+    {
+        // Touch the data so that the driver can't skip redundant uploads
+        fixture.vertices[fixture.frame % fixture.vertices.size()].color.r = static_cast<sf::Uint8>(fixture.frame);
+
+        fixture.vertexBuffer.update(&fixture.vertices[0]);
+
+        // Draw a few vertices, so that the upload can't be deferred forever
+        fixture.target.clear();
+        fixture.target.draw(fixture.vertexBuffer, 0, 3);
+        fixture.target.display();
+
+        return static_cast<double>(sizeof(sf::Vertex) * fixture.vertices.size());
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    double renderTextureSwitches(Fixture& fixture)
+    {
+        const unsigned int count = 100;
+
+        sf::Sprite sprite(fixture.texture, sf::IntRect(0, 0, 32, 32));
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            sf::RenderTexture& target = fixture.smallTargets[i & 1];
+
+            sprite.setPosition(static_cast<float>(i % 32), 0.f);
+
+            target.clear();
+            target.draw(sprite);
+            target.display();
+        }
+
+        return count;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    const Benchmark benchmarks[] =
+    {
+        {"sprites",                "sprites/s",   1.0,  sprites,               false},
+        {"sprites-batched",        "sprites/s",   1.0,  spritesBatched,        false},
+        {"text-draw",              "glyphs/s",    1.0,  textDraw,              true},
+        {"text-distance-field",    "glyphs/s",    1.0,  textDistanceField,     true},
+        {"text-batch-draw",        "glyphs/s",    1.0,  textBatchDraw,         true},
+        {"text-update",            "glyphs/s",    1.0,  textUpdate,            true},
+        {"shapes",                 "shapes/s",    1.0,  shapes,                false},
+        {"vertex-buffer-upload",   "MB/s",        1e6,  vertexBufferUpload,    false},
+        {"render-texture-switch",  "switches/s",  1.0,  renderTextureSwitches, false}
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    bool createFixture(Fixture& fixture, const std::string& fontPath, bool core)
+    {
+        sf::ContextSettings settings;
+        if (core)
+        {
+            settings.majorVersion = 3;
+            settings.minorVersion = 2;
+            settings.attributeFlags = sf::ContextSettings::Core;
+        }
+
+        if (!fixture.target.create(targetWidth, targetHeight, settings) ||
+            !fixture.smallTargets[0].create(64, 64, settings) ||
+            !fixture.smallTargets[1].create(64, 64, settings))
+            return false;
+
+        // Generate a texture rather than loading one, to avoid depending on resources
+        sf::Image image;
+        image.create(256, 256);
+        for (unsigned int y = 0; y < 256; ++y)
+            for (unsigned int x = 0; x < 256; ++x)
+                image.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x), static_cast<sf::Uint8>(y), static_cast<sf::Uint8>(x ^ y), ((x / 8 + y / 8) % 2) ? 255 : 128));
+
+        if (!fixture.texture.loadFromImage(image))
+            return false;
+
+        fixture.fontLoaded = fixture.font.loadFromFile(fontPath);
+        if (fixture.fontLoaded)
+        {
+            fixture.text.setFont(fixture.font);
+            fixture.text.setCharacterSize(16);
+            fixture.textBatch.setFont(fixture.font);
+            fixture.textBatch.setCharacterSize(16);
+
+            // Shares the face of the first font, with its own glyph cache
+            fixture.fieldFont.loadFromFile(fontPath);
+            fixture.fieldFont.setDistanceField(true);
+            fixture.fieldText.setFont(fixture.fieldFont);
+            fixture.fieldText.setCharacterSize(16);
+        }
+
+        fixture.vertices.resize(65536);
+        for (std::size_t i = 0; i < fixture.vertices.size(); ++i)
+            fixture.vertices[i] = sf::Vertex(scatter(static_cast<unsigned int>(i), 0), sf::Color::White);
+
+        if (sf::VertexBuffer::isAvailable())
+        {
+            fixture.vertexBuffer.setPrimitiveType(sf::Triangles);
+            fixture.vertexBuffer.setUsage(sf::VertexBuffer::Stream);
+            fixture.vertexBuffer.create(fixture.vertices.size());
+        }
+
+        fixture.frame = 0;
+
+        return true;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    Result run(Fixture& fixture, const Benchmark& benchmark, sf::Time duration)
+    {
+        Result result;
+        result.name    = benchmark.name;
+        result.unit    = benchmark.unit;
+        result.rate    = 0.0;
+        result.frames  = 0;
+        result.seconds = 0.0;
+        result.skipped = (benchmark.needsFont && !fixture.fontLoaded) ||
+                         ((benchmark.frame == vertexBufferUpload) && !sf::VertexBuffer::isAvailable());
+
+        if (result.skipped)
+            return result;
+
+        // The text benchmarks share the same text object
+        if (benchmark.needsFont)
+            fixture.text.setString("The quick brown fox jumps over the lazy dog 0123456789");
+
+        // Warm up caches, glyph pages and driver state
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            benchmark.frame(fixture);
+            ++fixture.frame;
+        }
+
+        fixture.target.setActive(true);
+        glFinish();
+
+        double items = 0.0;
+        sf::Clock clock;
+
+        do
+        {
+            items += benchmark.frame(fixture);
+            ++fixture.frame;
+            ++result.frames;
+        }
+        while (clock.getElapsedTime() < duration);
+
+        // Include the work still queued on the GPU
+        fixture.target.setActive(true);
+        glFinish();
+
+        result.seconds = clock.getElapsedTime().asSeconds();
+        result.rate = items / benchmark.scale / result.seconds;
+
+        return result;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    std::string escape(const std::string& string)
+    {
+        std::string escaped;
+
+        for (std::string::const_iterator it = string.begin(); it != string.end(); ++it)
+        {
+            if ((*it == '"') || (*it == '\\'))
+                escaped += '\\';
+
+            if (static_cast<unsigned char>(*it) >= 0x20)
+                escaped += *it;
+        }
+
+        return escaped;
+    }
+
+    std::string glString(GLenum name)
+    {
+        const GLubyte* string = glGetString(name);
+        return string ? reinterpret_cast<const char*>(string) : "unknown";
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    void printJson(const std::vector<Result>& results, const std::string& renderer, const std::string& version, sf::Time duration)
+    {
+        std::cout << "{" << std::endl;
+        std::cout << "  \"sfml\": \"" << SFML_VERSION_MAJOR << "." << SFML_VERSION_MINOR << "." << SFML_VERSION_PATCH << "\"," << std::endl;
+        std::cout << "  \"renderer\": \"" << escape(renderer) << "\"," << std::endl;
+        std::cout << "  \"glVersion\": \"" << escape(version) << "\"," << std::endl;
+        std::cout << "  \"secondsPerBenchmark\": " << duration.asSeconds() << "," << std::endl;
+        std::cout << "  \"benchmarks\": [" << std::endl;
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+
+            std::cout << "    {\"name\": \"" << result.name << "\", \"unit\": \"" << result.unit << "\", ";
+
+            if (result.skipped)
+                std::cout << "\"skipped\": true}";
+            else
+                std::cout << std::fixed << std::setprecision(2)
+                          << "\"value\": " << result.rate << ", \"frames\": " << result.frames
+                          << ", \"seconds\": " << std::setprecision(3) << result.seconds << "}";
+
+            std::cout << (i + 1 < results.size() ? "," : "") << std::endl;
+        }
+
+        std::cout << "  ]" << std::endl;
+        std::cout << "}" << std::endl;
+    }
+
+    void printTable(const std::vector<Result>& results, const std::string& renderer, const std::string& version)
+    {
+        std::cout << "Renderer: " << renderer << " (OpenGL " << version << ")" << std::endl;
+        std::cout << std::endl;
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+
+            std::cout << std::left << std::setw(24) << result.name << std::right;
+
+            if (result.skipped)
+                std::cout << std::setw(16) << "skipped" << std::endl;
+            else
+                std::cout << std::fixed << std::setprecision(1) << std::setw(16) << result.rate
+                          << " " << result.unit << std::endl;
+        }
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    void printUsage()
+    {
+        std::cout << "Usage: sfml-bench-graphics [options]" << std::endl;
+        std::cout << std::endl;
+        std::cout << "  --json            print the results as JSON" << std::endl;
+        std::cout << "  --time <seconds>  duration of each benchmark (default: 2)" << std::endl;
+        std::cout << "  --filter <text>   only run the benchmarks whose name contains <text>" << std::endl;
+        std::cout << "  --font <path>     font used by the text benchmarks" << std::endl;
+        std::cout << "  --core            draw with an OpenGL 3.2 core profile context" << std::endl;
+        std::cout << "  --list            list the benchmarks and exit" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    const std::size_t benchmarkCount = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    bool json = false;
+    bool core = false;
+    sf::Time duration = sf::seconds(2.f);
+    std::string filter;
+    std::string fontPath = SFML_BENCH_FONT;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (argument == "--json")
+        {
+            json = true;
+        }
+        else if (argument == "--core")
+        {
+            core = true;
+        }
+        else if ((argument == "--time") && hasValue)
+        {
+            duration = sf::seconds(static_cast<float>(std::atof(argv[++i])));
+        }
+        else if ((argument == "--filter") && hasValue)
+        {
+            filter = argv[++i];
+        }
+        else if ((argument == "--font") && hasValue)
+        {
+            fontPath = argv[++i];
+        }
+        else if (argument == "--list")
+        {
+            for (std::size_t j = 0; j < benchmarkCount; ++j)
+                std::cout << benchmarks[j].name << std::endl;
+
+            return EXIT_SUCCESS;
+        }
+        else
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Collect the errors reported by SFML, they make the run fail
+    std::ostringstream errors;
+    std::streambuf* previousErrorBuffer = sf::err().rdbuf(errors.rdbuf());
+
+    Fixture fixture;
+    if (!createFixture(fixture, fontPath, core))
+    {
+        sf::err().rdbuf(previousErrorBuffer);
+        std::cerr << errors.str();
+        std::cerr << "Failed to create the render targets, is a display available?" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    fixture.target.setActive(true);
+    std::string renderer = glString(GL_RENDERER);
+    std::string version = glString(GL_VERSION);
+
+    std::vector<Result> results;
+    for (std::size_t i = 0; i < benchmarkCount; ++i)
+    {
+        if (filter.empty() || std::strstr(benchmarks[i].name, filter.c_str()))
+            results.push_back(run(fixture, benchmarks[i], duration));
+    }
+
+    if (json)
+        printJson(results, renderer, version, duration);
+    else
+        printTable(results, renderer, version);
+
+    sf::err().rdbuf(previousErrorBuffer);
+    if (!errors.str().empty())
+    {
+        std::cerr << errors.str();
+        std::cerr << "SFML reported errors during the benchmarks" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
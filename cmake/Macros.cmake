@@ -331,6 +331,37 @@ function(sfml_add_test target SOURCES DEPENDS)
     endif()
 endfunction()
 
+# add a new target which is a SFML benchmark
+# example: sfml_add_benchmark(sfml-bench-graphics
+#                             SOURCES Graphics.cpp ...
+#                             DEPENDS sfml-graphics)
+macro(sfml_add_benchmark target)
+
+    # parse the arguments
+    cmake_parse_arguments(THIS "" "" "SOURCES;DEPENDS" ${ARGN})
+
+    # set a source group for the source files
+    source_group("" FILES ${THIS_SOURCES})
+
+    # create the target
+    add_executable(${target} ${THIS_SOURCES})
+
+    # set the debug suffix
+    set_target_properties(${target} PROPERTIES DEBUG_POSTFIX -d)
+
+    # set the target's folder (for IDEs that support it, e.g. Visual Studio)
+    set_target_properties(${target} PROPERTIES FOLDER "Benchmarks")
+
+    # set the target flags to use the appropriate C++ standard library
+    sfml_set_stdlib(${target})
+
+    # link the target to its SFML dependencies
+    if(THIS_DEPENDS)
+        target_link_libraries(${target} PRIVATE ${THIS_DEPENDS})
+    endif()
+
+endmacro()
+
 # Create an interface library for an external dependency. This virtual target can provide
 # link specifications and include directories to be used by dependees.
 # The created INTERFACE library is tagged for export to be part of the generated SFMLConfig
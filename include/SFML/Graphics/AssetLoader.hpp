@@ -0,0 +1,321 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ASSETLOADER_HPP
+#define SFML_ASSETLOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Thread;
+
+////////////////////////////////////////////////////////////
+/// \brief Loads many images and textures in the background
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AssetLoader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Loading status of an asset
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Pending, ///< The asset is being decoded or uploaded
+        Ready,   ///< The asset is loaded and can be used
+        Failed   ///< The asset couldn't be loaded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param threadCount Maximum number of threads decoding the files
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit AssetLoader(unsigned int threadCount = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The files that are not decoded yet are abandoned, the
+    /// destructor only waits for those currently being decoded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AssetLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading an image from a file
+    ///
+    /// The file is decoded by a worker thread, this function
+    /// returns immediately.
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return Index of the asset, to use with getStatus and getImage
+    ///
+    /// \see loadTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t loadImage(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading a texture from a file
+    ///
+    /// The file is decoded by a worker thread, then uploaded to
+    /// the graphics card by uploadTextures, which must be called
+    /// regularly by the thread that renders.
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return Index of the asset, to use with getStatus and getTexture
+    ///
+    /// \see loadImage, uploadTextures
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t loadTexture(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the decoded textures, within a time budget
+    ///
+    /// The pixels are uploaded in strips of rows, so that large
+    /// textures are spread over several calls rather than
+    /// causing a long stall. At least one strip is uploaded per
+    /// call, whatever the budget. Textures become ready once all
+    /// their rows are uploaded.
+    ///
+    /// This function must be called with an active OpenGL
+    /// context, typically once per frame by the rendering thread.
+    ///
+    /// \param budget Time after which no more pixels are uploaded
+    ///
+    /// \return True if all the assets are loaded (or failed)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool uploadTextures(Time budget);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the files are decoded
+    ///
+    /// Textures still need to be uploaded with uploadTextures
+    /// afterwards.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the status of an asset
+    ///
+    /// \param asset Index of the asset
+    ///
+    /// \return Loading status of the asset
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getStatus(std::size_t asset) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of assets not loaded yet
+    ///
+    /// \return Number of assets which are still pending
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a loaded image
+    ///
+    /// The image is empty until the asset is ready. The images
+    /// of texture assets are released once they are uploaded.
+    ///
+    /// \param asset Index of the asset, returned by loadImage
+    ///
+    /// \return Loaded image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getImage(std::size_t asset) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a loaded texture
+    ///
+    /// The texture is empty until its first pixels are uploaded,
+    /// and complete once the asset is ready. It can be copied,
+    /// or used directly as long as the loader exists.
+    ///
+    /// \param asset Index of the asset, returned by loadTexture
+    ///
+    /// \return Loaded texture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(std::size_t asset) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Progress of an asset
+    ///
+    ////////////////////////////////////////////////////////////
+    enum State
+    {
+        Queued,   ///< Waiting for a worker thread
+        Decoding, ///< Being decoded by a worker thread
+        Decoded,  ///< Decoded, waiting to be uploaded
+        Done,     ///< Loaded
+        Error     ///< Failed to load
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief File to load, and its result
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Asset
+    {
+        Asset();
+
+        std::string  filename;     ///< Path of the file
+        bool         isTexture;    ///< Is the image uploaded to a texture?
+        State        state;        ///< Loading progress, protected by the mutex
+        Image        image;        ///< Decoded pixels
+        Texture*     texture;      ///< Texture receiving the pixels, created by uploadTextures for texture assets
+        unsigned int uploadedRows; ///< Number of rows already uploaded to the texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Thread decoding the queued files
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Worker
+    {
+        AssetLoader* loader;  ///< Loader owning the worker
+        Thread*      thread;  ///< Thread running the worker
+        bool         running; ///< Is the thread decoding files? Protected by the mutex
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a file to be decoded
+    ///
+    /// \param filename  Path of the file
+    /// \param isTexture Must the image be uploaded to a texture?
+    ///
+    /// \return Index of the asset
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t load(const std::string& filename, bool isTexture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the queued files until there are none left
+    ///
+    /// \param worker Worker running the function
+    ///
+    ////////////////////////////////////////////////////////////
+    static void decode(Worker* worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark an asset as finished
+    ///
+    /// The mutex must be locked.
+    ///
+    /// \param asset  Asset to update
+    /// \param state  Final state (Done or Error)
+    ///
+    ////////////////////////////////////////////////////////////
+    void finish(Asset& asset, State state);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Asset>    m_assets;       ///< Assets, which must not move when new ones are added
+    std::deque<Asset*>   m_queue;        ///< Assets waiting to be decoded
+    std::deque<Asset*>   m_uploads;      ///< Decoded texture assets waiting to be uploaded
+    std::vector<Worker*> m_workers;      ///< Threads decoding the files
+    std::size_t          m_pendingCount; ///< Number of assets not finished yet
+    bool                 m_cancelled;    ///< Must the workers stop?
+    mutable Mutex        m_mutex;        ///< Mutex protecting the shared state
+};
+
+} // namespace sf
+
+
+#endif // SFML_ASSETLOADER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AssetLoader
+/// \ingroup graphics
+///
+/// sf::AssetLoader loads a list of image files in the
+/// background. The files are decoded in parallel by a pool
+/// of worker threads, while the application keeps running.
+///
+/// The textures have to be uploaded by the thread which owns
+/// the OpenGL context, which is usually the rendering thread:
+/// uploadTextures uploads the decoded pixels within a time
+/// budget, so that it can be called every frame during a
+/// loading screen without stalling it.
+///
+/// Assets are identified by the index returned when they are
+/// requested. Their status tells when they are ready to use.
+/// The loaded images and textures belong to the loader, and
+/// can be used directly or copied.
+///
+/// Usage example:
+/// \code
+/// sf::AssetLoader loader;
+///
+/// std::vector<std::size_t> tiles;
+/// for (std::size_t i = 0; i < tileFiles.size(); ++i)
+///     tiles.push_back(loader.loadTexture(tileFiles[i]));
+///
+/// std::size_t heightMap = loader.loadImage("heightmap.png");
+///
+/// // Loading screen: upload for at most 4 ms per frame
+/// while (!loader.uploadTextures(sf::milliseconds(4)))
+/// {
+///     drawProgress(window, loader.getPendingCount());
+///     window.display();
+/// }
+///
+/// if (loader.getStatus(heightMap) == sf::AssetLoader::Ready)
+///     buildTerrain(loader.getImage(heightMap));
+///
+/// sf::Sprite sprite(loader.getTexture(tiles[0]));
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DRAWQUEUE_HPP
+#define SFML_DRAWQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+class Drawable;
+class RenderTarget;
+class IndexBuffer;
+class InstanceBuffer;
+class VertexBuffer;
+
+namespace priv
+{
+    template <typename T> class DrawRecorder;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Deferred list of draw calls, sorted by layer and render states
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DrawQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty queue, with the current layer set to 0.
+    ///
+    ////////////////////////////////////////////////////////////
+    DrawQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~DrawQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the layer of the next draw calls
+    ///
+    /// Draw calls of lower layers are replayed before those of
+    /// higher layers, i.e. they appear below them. The layer
+    /// applies to all the draw calls recorded until it is
+    /// changed again.
+    ///
+    /// \param layer Layer of the next draw calls
+    ///
+    /// \see getLayer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLayer(Int16 layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layer of the next draw calls
+    ///
+    /// \return Current layer
+    ///
+    /// \see setLayer
+    ///
+    ////////////////////////////////////////////////////////////
+    Int16 getLayer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a drawable object
+    ///
+    /// The primitives that the drawable produces are captured
+    /// right away, so the drawable itself may be modified or
+    /// destroyed after this call.
+    ///
+    /// \param drawable Object to draw
+    /// \param states   Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Drawable& drawable, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices
+    ///
+    /// The vertices are copied into the queue.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer
+    ///
+    /// Only a reference to the vertex buffer is stored, it must
+    /// stay alive until the queue is replayed.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer
+    ///
+    /// Only a reference to the vertex buffer is stored, it must
+    /// stay alive until the queue is replayed.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer and an index buffer
+    ///
+    /// Only references to the buffers are stored, they must
+    /// stay alive until the queue is replayed.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer referencing the vertices of \a vertexBuffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer and a range of an index buffer
+    ///
+    /// Only references to the buffers are stored, they must
+    /// stay alive until the queue is replayed.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer referencing the vertices of \a vertexBuffer
+    /// \param firstIndex   Position of the first index to render
+    /// \param indexCount   Number of indices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record instances of a vertex buffer
+    ///
+    /// Only references to the buffers are stored, they must
+    /// stay alive until the queue is replayed, where the instances
+    /// are drawn with sf::RenderTarget::drawInstanced.
+    ///
+    /// \param vertexBuffer   Vertex buffer holding the geometry of a single instance
+    /// \param instanceBuffer Attributes of the instances to draw
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of recorded draw calls
+    ///
+    /// \return Number of draw calls in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDrawCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded draw calls
+    ///
+    /// The memory is kept, so that recording the next frame
+    /// doesn't involve reallocating it. The current layer
+    /// is reset to 0.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the recorded draw calls to a render target
+    ///
+    /// The draw calls are sorted by layer first, then by shader,
+    /// texture and blend mode, so that consecutive draw calls
+    /// share as many states as possible. Draw calls with the
+    /// same layer and states are replayed in the order in which
+    /// they were recorded.
+    ///
+    /// The queue is left untouched, it can be replayed again.
+    ///
+    /// \param target Render target to draw to
+    ///
+    ////////////////////////////////////////////////////////////
+    void replay(RenderTarget& target) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        RenderStates          states;         ///< Render states of the draw call
+        PrimitiveType         type;           ///< Type of primitives to draw
+        const VertexBuffer*   vertexBuffer;   ///< Vertex buffer to draw, or null to draw the queue's vertices
+        const IndexBuffer*    indexBuffer;    ///< Index buffer of the vertex buffer, or null to draw it without indices
+        const InstanceBuffer* instanceBuffer; ///< Instances of the vertex buffer to draw, or null to draw it once
+        std::size_t           firstVertex;    ///< Index of the first vertex, in the vertex buffer or the queue's vertices; first index if there is an index buffer
+        std::size_t           vertexCount;    ///< Number of vertices to draw; number of indices if there is an index buffer
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the sort key of a draw call
+    ///
+    /// \param states Render states of the draw call
+    ///
+    /// \return Key packing the layer, shader, texture and blend mode
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 computeKey(const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::pair<Uint64, std::size_t> SortEntry; ///< Sort key and index of a command
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::DrawRecorder<DrawQueue>*   m_recorder;   ///< Render target used to capture drawables
+    Int16                            m_layer;      ///< Layer of the next draw calls
+    std::vector<Command>             m_commands;   ///< Recorded draw calls
+    std::vector<Vertex>              m_vertices;   ///< Vertices of the recorded vertex arrays
+    std::map<const Shader*, Uint16>  m_shaders;    ///< Sort index of each shader, by first use
+    std::map<const Texture*, Uint16> m_textures;   ///< Sort index of each texture, by first use
+    std::vector<BlendMode>           m_blendModes; ///< Blend modes, by first use
+    mutable std::vector<SortEntry>   m_order;      ///< Sort key and index of each command
+    mutable bool                     m_sorted;     ///< Is m_order sorted?
+};
+
+} // namespace sf
+
+
+#endif // SFML_DRAWQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DrawQueue
+/// \ingroup graphics
+///
+/// sf::DrawQueue records draw calls, and replays them into
+/// a render target later, in an order that minimizes the
+/// changes of render states.
+///
+/// Every draw call belongs to a layer (see setLayer). Layers
+/// are replayed from the lowest to the highest, so they play
+/// the role of a depth value. Within a layer, draw calls are
+/// grouped by shader, then texture, then blend mode; this is
+/// where the savings come from, but it also means that two
+/// draw calls of the same layer that use different states
+/// may not be drawn in the order in which they were recorded.
+/// Put objects that must overlap in a specific order on
+/// different layers.
+///
+/// Vertex arrays and drawables are copied into the queue when
+/// recorded. Textures, shaders, vertex buffers and instance
+/// buffers are only referenced, and must stay alive and
+/// unchanged until the queue is replayed.
+///
+/// Replaying into a target that has batching enabled (see
+/// sf::RenderTarget::setBatchingEnabled) lets consecutive
+/// draw calls with the same states be merged into a single
+/// one.
+///
+/// Example:
+/// \code
+/// sf::DrawQueue queue;
+///
+/// // Submit in game-logic order
+/// for (std::size_t i = 0; i < entities.size(); ++i)
+/// {
+///     queue.setLayer(entities[i].layer);
+///     queue.draw(entities[i].sprite);
+/// }
+///
+/// window.setBatchingEnabled(true);
+/// window.clear();
+/// queue.replay(window);
+/// window.display();
+///
+/// queue.clear();
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
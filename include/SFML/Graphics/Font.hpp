@@ -34,6 +34,7 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
+#include <deque>
 #include <map>
 #include <string>
 #include <vector>
@@ -42,6 +43,13 @@
 namespace sf
 {
 class InputStream;
+class Mutex;
+class Shader;
+
+namespace priv
+{
+    class AtlasPacker;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
@@ -60,6 +68,36 @@ public:
         std::string family; ///< The font family
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Algorithms used to pack glyphs into the font textures
+    ///
+    ////////////////////////////////////////////////////////////
+    enum AtlasPacking
+    {
+        Skyline, ///< Skyline packing: fast, good occupancy (default)
+        MaxRects ///< Maximal rectangles packing: densest, slower to insert glyphs
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics about the occupancy of the glyph textures
+    ///
+    ////////////////////////////////////////////////////////////
+    struct AtlasStats
+    {
+        AtlasStats();
+
+        unsigned int pageCount;         ///< Number of glyph textures
+        unsigned int glyphCount;        ///< Number of glyphs in the cache
+        Uint64       usedPixels;        ///< Number of texture pixels allocated to glyphs
+        Uint64       texturePixels;     ///< Total number of pixels in the glyph textures
+        float        fillRatio;         ///< usedPixels / texturePixels
+        unsigned int regrowthCount;     ///< Number of times a glyph texture had to be enlarged
+        Uint64       hitCount;          ///< Number of glyph lookups found in the cache
+        Uint64       missCount;         ///< Number of glyph lookups that had to load the glyph
+        Uint64       evictionCount;     ///< Number of glyphs evicted to stay within the memory budget
+        unsigned int pageEvictionCount; ///< Number of glyph textures cleared to stay within the memory budget
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -73,6 +111,9 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Copy constructor
     ///
+    /// The copy shares the font face and the glyph cache of
+    /// \a copy, until one of them changes its atlas settings.
+    ///
     /// \param copy Instance to copy
     ///
     ////////////////////////////////////////////////////////////
@@ -95,6 +136,12 @@ public:
     /// fonts installed on the user's system, thus you can't
     /// load them directly.
     ///
+    /// If another font already loaded the same file, its font
+    /// face is shared instead of opening the file again, as well
+    /// as its glyph cache if both fonts have the same atlas
+    /// settings. Fonts sharing a face can be used from different
+    /// threads: the glyph loading is serialized.
+    ///
     /// \warning SFML cannot preload all the font data in this
     /// function, so the file has to remain accessible until
     /// the sf::Font object loads a new font or is destroyed.
@@ -114,6 +161,9 @@ public:
     /// The supported font formats are: TrueType, Type 1, CFF,
     /// OpenType, SFNT, X11 PCF, Windows FNT, BDF, PFR and Type 42.
     ///
+    /// Like with loadFromFile, fonts loaded from the same buffer
+    /// share their font face and, if possible, their glyph cache.
+    ///
     /// \warning SFML cannot preload all the font data in this
     /// function, so the buffer pointed by \a data has to remain
     /// valid until the sf::Font object loads a new font or
@@ -169,6 +219,10 @@ public:
     /// Be aware that using a negative value for the outline
     /// thickness will cause distorted rendering.
     ///
+    /// When a memory budget is set, loading a glyph may evict
+    /// other glyphs, which invalidates the references previously
+    /// returned by this function.
+    ///
     /// \param codePoint        Unicode code point of the character to get
     /// \param characterSize    Reference character size
     /// \param bold             Retrieve the bold version or the regular one?
@@ -179,6 +233,30 @@ public:
     ////////////////////////////////////////////////////////////
     const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness = 0) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs ahead of time
+    ///
+    /// Glyphs are normally rasterized the first time they are
+    /// requested, which can cause a visible hitch when a lot of
+    /// new characters appear at once. This function rasterizes
+    /// all the glyphs of \a charset that are not loaded yet, on
+    /// several threads (each one with its own FreeType face), and
+    /// then writes them to the font textures with one batched
+    /// upload per page.
+    ///
+    /// Fonts loaded from a stream can't be opened several times,
+    /// so their glyphs are rasterized by the calling thread only.
+    ///
+    /// \param charset          Characters to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Load the bold versions or the regular ones?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    ///
+    /// \see getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preload(const String& charset, unsigned int characterSize, bool bold, float outlineThickness = 0) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the kerning offset of two glyphs
     ///
@@ -244,7 +322,8 @@ public:
     ///
     /// The contents of the returned texture changes as more glyphs
     /// are requested, thus it is not very relevant. It is mainly
-    /// used internally by sf::Text.
+    /// used internally by sf::Text. When the atlas is shared, this
+    /// is the texture of the first page.
     ///
     /// \param characterSize Reference character size
     ///
@@ -253,6 +332,172 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the texture of a page of glyphs
+    ///
+    /// Each glyph stores the index of the page that contains
+    /// its pixels (see sf::Glyph::page). Without a shared atlas,
+    /// every character size has its own page; with a shared
+    /// atlas, glyphs of all sizes and styles are spread over
+    /// as few pages as possible.
+    ///
+    /// \param page Index of the page
+    ///
+    /// \return Texture of the requested page
+    ///
+    /// \see getPageCount, setSharedAtlas
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getPageTexture(unsigned int page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of pages of glyphs
+    ///
+    /// \return Number of pages (textures) currently allocated
+    ///
+    /// \see getPageTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the shared glyph atlas
+    ///
+    /// By default, each character size gets its own texture, so
+    /// texts of different sizes can't be drawn with the same
+    /// texture binding. When the shared atlas is enabled, glyphs
+    /// of all sizes, styles and outline thicknesses are packed
+    /// together into a common set of pages, and texts of
+    /// different sizes can be batched together.
+    ///
+    /// Changing this option discards all the glyphs loaded so far.
+    ///
+    /// \param shared True to share the pages between all the character sizes
+    ///
+    /// \see isSharedAtlas
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSharedAtlas(bool shared);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether glyphs of all sizes share the same pages
+    ///
+    /// \return True if the shared atlas is enabled
+    ///
+    /// \see setSharedAtlas
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSharedAtlas() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable signed distance field glyphs
+    ///
+    /// In distance field mode, each glyph is rasterized only once,
+    /// at a reference size, as a signed distance field instead of
+    /// a coverage bitmap. sf::Text then renders it at any size,
+    /// scale or rotation with a built-in shader, which also
+    /// derives the bold style and the outline from the distance
+    /// field. This removes the per-size textures and the
+    /// rasterization spikes when text is animated, at the price
+    /// of slightly less sharp small text (no hinting).
+    ///
+    /// The outline thickness is limited to one eighth of the
+    /// character size. Shaders must be supported by the system
+    /// (see sf::Shader::isAvailable), otherwise the glyphs look
+    /// blurry.
+    ///
+    /// Changing this option discards all the glyphs loaded so far.
+    ///
+    /// \param enabled True to use distance field glyphs
+    ///
+    /// \see isDistanceField
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceField(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether glyphs are signed distance fields
+    ///
+    /// \return True if the distance field mode is enabled
+    ///
+    /// \see setDistanceField
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceField() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the algorithm used to pack glyphs into the textures
+    ///
+    /// The new algorithm is only used by the glyph textures
+    /// created after this call, so it should be set before
+    /// requesting any glyph. The default is Skyline.
+    ///
+    /// \param packing Packing algorithm to use
+    ///
+    /// \see getAtlasPacking
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAtlasPacking(AtlasPacking packing);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the algorithm used to pack glyphs into the textures
+    ///
+    /// \return Packing algorithm
+    ///
+    /// \see setAtlasPacking
+    ///
+    ////////////////////////////////////////////////////////////
+    AtlasPacking getAtlasPacking() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit the memory used by the glyph textures and the kerning cache
+    ///
+    /// When enlarging the glyph textures or the kerning cache would
+    /// exceed the budget, the least recently used textures and
+    /// kerning tables are cleared first: their glyphs and kerning
+    /// pairs are evicted, and loaded again (compactly) the next
+    /// time they are needed. Texts drawn with the evicted glyphs
+    /// update their geometry automatically.
+    ///
+    /// The budget is a soft limit: the glyphs used by the text being
+    /// laid out are never evicted, if they need more memory the
+    /// textures still grow. It should therefore be large enough for
+    /// the glyphs needed by a single frame, to avoid evicting glyphs
+    /// that are immediately loaded again.
+    ///
+    /// The default budget, 0, means no limit.
+    ///
+    /// \param bytes Maximum size of the glyph textures and kerning tables, in bytes (0 for no limit)
+    ///
+    /// \see getMemoryBudget, getAtlasStats
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMemoryBudget(std::size_t bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the limit of memory used by the glyph textures and the kerning cache
+    ///
+    /// \return Maximum size of the glyph textures and kerning tables, in bytes (0 for no limit)
+    ///
+    /// \see setMemoryBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMemoryBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the glyph textures
+    ///
+    /// This is mostly useful to tune the packing algorithm and the
+    /// memory budget, or to find out why a font uses more video
+    /// memory than expected. The cache counters are reset when
+    /// a new font is loaded, and include the glyph lookups of
+    /// the other fonts sharing the same glyph cache.
+    ///
+    /// \return Occupancy statistics and cache counters, summed over all the character sizes
+    ///
+    ////////////////////////////////////////////////////////////
+    AtlasStats getAtlasStats() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -265,36 +510,92 @@ public:
 
 private:
 
+    friend class Text;
+    friend class TextBatch;
+    friend class TextLayout;
+
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
+    /// \brief Parameters of the distance field glyphs
     ///
     ////////////////////////////////////////////////////////////
-    struct Row
+    enum
     {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
-
-        unsigned int width;  ///< Current width of the row
-        unsigned int top;    ///< Y position of the row into the texture
-        unsigned int height; ///< Height of the row
+        DistanceFieldSize   = 48, ///< Reference character size at which the fields are computed
+        DistanceFieldSpread = 6   ///< Maximum distance encoded in the fields, in pixels at the reference size
     };
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint64, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    ////////////////////////////////////////////////////////////
+    /// \brief Hash table mapping a code point and style to its glyph
+    ///
+    /// The table uses open addressing with linear probing. The
+    /// glyphs themselves are stored in a deque, so that references
+    /// returned by getGlyph stay valid when the table grows. The
+    /// regular and bold ASCII glyphs without outline are also
+    /// indexed directly, to skip hashing in the most common case.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphTable
+    {
+        GlyphTable();
+        const Glyph* find(Uint64 key) const;
+        const Glyph& insert(Uint64 key, const Glyph& glyph);
+        std::size_t removePage(unsigned int page);
+        std::size_t size() const;
+
+        std::vector<Uint64> keys;          ///< Key of each slot
+        std::vector<Uint32> slots;         ///< Index of the glyph of each slot plus one, 0 for empty slots
+        std::deque<Glyph>   glyphs;        ///< Glyphs of the table
+        Uint32              ascii[2][128]; ///< Index plus one of the regular and bold glyphs of the ASCII characters
+    };
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a page of glyphs
+    /// \brief Hash table caching the kerning of pairs of characters
     ///
     ////////////////////////////////////////////////////////////
-    struct Page
+    struct KerningTable
+    {
+        KerningTable();
+        bool find(Uint64 pair, float& kerning) const;
+        void insert(Uint64 pair, float kerning);
+        Uint64 getMemoryUsage() const;
+
+        std::vector<Uint64> pairs;   ///< Pair of code points of each slot, 0 for empty slots
+        std::vector<float>  values;  ///< Kerning of each slot
+        std::size_t         count;   ///< Number of used slots
+        Uint64              lastUse; ///< Time (in lookups) of the last use of the table
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining the glyphs of a character size
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphSet
     {
-        Page();
+        GlyphSet() : page(0) {}
 
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        Texture          texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        GlyphTable   glyphs; ///< Table mapping code points to their corresponding glyph
+        unsigned int page;   ///< Index of the page containing the glyphs (unused with a shared atlas)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a page (texture) of glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        Page(AtlasPacking packing = Skyline);
+        Page(const Page& copy);
+        ~Page();
+        Page& operator =(const Page& right);
+
+        Texture            texture;       ///< Texture containing the pixels of the glyphs
+        priv::AtlasPacker* packer;        ///< Allocator of the texture space
+        unsigned int       regrowthCount; ///< Number of times the texture was enlarged
+        unsigned int       evictionCount; ///< Number of times the page was cleared to free memory
+        Uint64             lastUse;       ///< Time (in glyph lookups) of the last use of the page, 0 if it is empty
     };
 
     ////////////////////////////////////////////////////////////
@@ -303,6 +604,116 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a font face, or share it if it is already open
+    ///
+    /// Faces opened from a file or from memory are registered,
+    /// so that the fonts loaded from the same source share the
+    /// face, and the glyph cache if their settings match.
+    ///
+    /// \param fileName Path of the font file, empty if loaded from memory or from a stream
+    /// \param data     Font data, if loaded from memory
+    /// \param size     Size of the font data, if loaded from memory
+    /// \param stream   Stream rec instance, if loaded from a stream (faces opened from streams are not shared)
+    /// \param source   Description of the font source, for error messages
+    ///
+    /// \return True if the face was opened or shared successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFace(const std::string& fileName, const void* data, std::size_t size, void* stream, const std::string& source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the font its own glyph cache, if it is shared
+    ///
+    /// This must be done before changing the atlas settings, so that
+    /// the other fonts sharing the cache keep theirs. The new cache
+    /// has the same settings, but no glyph.
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the glyphs of a character size, creating them if needed
+    ///
+    /// Without a shared atlas, this also creates the page of the size.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Glyph set of the requested size
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphSet& getGlyphSet(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a new page
+    ///
+    /// \return Index of the new page
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int addPage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enlarge the texture of a page
+    ///
+    /// \param page        Page to enlarge
+    /// \param maximumSize Maximum width and height of the texture
+    ///
+    /// \return True on success, false if the page can't grow anymore
+    ///
+    ////////////////////////////////////////////////////////////
+    bool growPage(Page& page, unsigned int maximumSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a page as used by the current glyph lookup
+    ///
+    /// \param page Index of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    void usePage(unsigned int page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evict the least recently used pages and kerning tables
+    ///        until the memory budget allows to allocate more memory
+    ///
+    /// Pages and tables used by the layouts in progress are
+    /// never evicted, even if the budget is exceeded.
+    ///
+    /// \param extraBytes Amount of memory about to be allocated
+    /// \param keepPage   Page that must not be evicted (an invalid index for none)
+    /// \param keepTable  Kerning table that must not be evicted (NULL for none)
+    ///
+    /// \return True if at least one page was evicted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool reduceMemory(Uint64 extraBytes, unsigned int keepPage, const KerningTable* keepTable = NULL) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start protecting the glyphs used by a text layout
+    ///
+    /// Until the matching call to endLayout, the pages and kerning
+    /// tables used are not evicted to stay within the memory budget,
+    /// so that the glyphs of the text remain valid while it is laid
+    /// out. The face is locked meanwhile, so that the fonts sharing
+    /// it on other threads can't change the glyph cache either.
+    /// Layouts can be nested.
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginLayout() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop protecting the glyphs used by a text layout
+    ///
+    ////////////////////////////////////////////////////////////
+    void endLayout() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear a page and evict all its glyphs
+    ///
+    /// \param page Index of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    void evictPage(unsigned int page) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
@@ -317,16 +728,52 @@ private:
     Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Find a suitable rectangle within the texture for a glyph
+    /// \brief Get the number of pixels left around the glyphs in the textures
+    ///
+    /// \return Padding, in pixels
     ///
-    /// \param page   Page of glyphs to search in
-    /// \param width  Width of the rectangle
-    /// \param height Height of the rectangle
+    ////////////////////////////////////////////////////////////
+    unsigned int getGlyphPadding() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Derive a distance field glyph from its reference glyph
+    ///
+    /// \param codePoint        Unicode code point of the character to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline
+    ///
+    /// \return The glyph corresponding to \a codePoint and \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph scaleDistanceFieldGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader rendering distance field glyphs
+    ///
+    /// Each threshold gets its own shader instead of a uniform,
+    /// so that texts with different styles can be batched or
+    /// recorded without overwriting each other's parameters.
+    ///
+    /// \param threshold Distance field value at the edge of the glyphs
+    ///
+    /// \return Shader, or NULL if shaders are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getDistanceFieldShader(float threshold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a suitable rectangle within the textures for a glyph
+    ///
+    /// \param glyphSet Glyph set of the character size
+    /// \param width    Width of the rectangle
+    /// \param height   Height of the rectangle
+    /// \param page     Receives the index of the page containing the rectangle
     ///
     /// \return Found rectangle within the texture
     ///
     ////////////////////////////////////////////////////////////
-    IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
+    IntRect findGlyphRect(const GlyphSet& glyphSet, unsigned int width, unsigned int height, unsigned int& page) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
@@ -341,19 +788,59 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, GlyphSet>     GlyphSetTable;     ///< Table mapping a character size to its glyphs
+    typedef std::map<unsigned int, KerningTable> KerningTableTable; ///< Table mapping a character size to its kerning cache
+    typedef std::deque<Page>                     PageArray;         ///< Pages of glyphs, which must not move when new ones are added
+    typedef std::map<int, Shader*>               ShaderTable;       ///< Table mapping a quantized threshold to its distance field shader
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyphs, pages and atlas settings of a font
+    ///
+    /// The cache is shared by copies of a font, and by the fonts
+    /// loaded from the same file or memory with the same settings.
+    /// A font changing its settings gets its own cache.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Cache
+    {
+        Cache();
+        bool hasSettingsOf(const Cache& other) const;
+        void copySettings(const Cache& other);
+        void clear();
+
+        GlyphSetTable     glyphSets;     ///< Table containing the glyphs by character size
+        KerningTableTable kerningTables; ///< Table containing the cached kerning by character size
+        PageArray         pages;         ///< Pages (textures) containing the pixels of the glyphs
+        AtlasPacking      packing;       ///< Algorithm used to pack the glyphs of new pages
+        bool              sharedAtlas;   ///< Are the pages shared by all the character sizes?
+        bool              distanceField; ///< Are the glyphs signed distance fields?
+        std::size_t       memoryBudget;  ///< Maximum size of the glyph textures, in bytes (0 for no limit)
+        Uint64            useClock;      ///< Number of glyph and kerning lookups, used to find the least recently used pages and tables
+        Uint64            layoutStart;   ///< Value of the use clock when the outermost layout in progress started
+        unsigned int      layoutDepth;   ///< Number of nested layouts in progress
+        Uint64            hitCount;      ///< Number of glyph lookups found in the cache
+        Uint64            missCount;     ///< Number of glyph lookups that had to load the glyph
+        Uint64            evictionCount; ///< Number of glyphs evicted to stay within the memory budget
+        unsigned int      pageEvictions; ///< Number of pages cleared to stay within the memory budget
+        unsigned int      refCount;      ///< Number of fonts using the cache
+    };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    void*                      m_library;     ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
-    void*                      m_face;        ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
-    void*                      m_streamRec;   ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
-    void*                      m_stroker;     ///< Pointer to the stroker (it is typeless to avoid exposing implementation details)
-    int*                       m_refCount;    ///< Reference counter used by implicit sharing
-    Info                       m_info;        ///< Information about the font
-    mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    void*                      m_library;       ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
+    void*                      m_face;          ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
+    void*                      m_streamRec;     ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
+    void*                      m_stroker;       ///< Pointer to the stroker (it is typeless to avoid exposing implementation details)
+    int*                       m_refCount;      ///< Reference counter used by implicit sharing
+    Mutex*                     m_faceMutex;     ///< Mutex serializing the use of the face, stroker and glyph caches by the fonts sharing them
+    Info                       m_info;          ///< Information about the font
+    std::string                m_fileName;      ///< Path of the font file, if loaded from a file (to open it again in worker threads)
+    const void*                m_fileData;      ///< Font data, if loaded from memory (to open it again in worker threads)
+    std::size_t                m_fileSize;      ///< Size of the font data, if loaded from memory
+    mutable std::vector<Uint8> m_pixelBuffer;   ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    mutable ShaderTable        m_fieldShaders;  ///< Shaders rendering the distance field glyphs
+    Cache*                     m_cache;         ///< Glyph cache, shared with the copies and the fonts loaded from the same source
     #ifdef SFML_SYSTEM_ANDROID
     void*                      m_stream; ///< Asset file streamer (if loaded from file)
     #endif
@@ -393,6 +880,15 @@ private:
 /// Note that it is also possible to bind several sf::Text instances
 /// to the same sf::Font.
 ///
+/// Fonts are cheap to load more than once: the fonts loaded from
+/// the same file (or buffer in memory) share a single font face,
+/// and a single glyph cache as long as they use the same atlas
+/// settings. Copies of a font share them as well. The fonts
+/// sharing a face can be used from different threads, as the
+/// glyph lookups are serialized; the sf::Glyph references
+/// returned by getGlyph may however be invalidated by lookups
+/// made by the other threads, so they should be copied.
+///
 /// It is important to note that the sf::Text instance doesn't
 /// copy the font that it uses, it only keeps a reference to it.
 /// Thus, a sf::Font must not be destructed while it is
@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GPUTIMER_HPP
+#define SFML_GPUTIMER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Measures the time spent by the GPU on a section of draw calls
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GpuTimer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param name Name of the measured section, for reporting purposes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit GpuTimer(const std::string& name = "");
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GpuTimer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the measured section
+    ///
+    /// \return Name given at construction
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::string& getName() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start measuring the draw calls issued to a render target
+    ///
+    /// Pending batched geometry of \a target is flushed first,
+    /// so that it is not accounted to the section. Calls to
+    /// begin() and end() must be paired, and use the same target.
+    ///
+    /// If all the previous measurements are still in flight,
+    /// this one is skipped.
+    ///
+    /// \param target Render target whose draw calls are measured
+    ///
+    /// \see end
+    ///
+    ////////////////////////////////////////////////////////////
+    void begin(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop measuring the draw calls issued to a render target
+    ///
+    /// \param target Render target given to begin()
+    ///
+    /// \see begin
+    ///
+    ////////////////////////////////////////////////////////////
+    void end(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the latest available measurement
+    ///
+    /// The GPU executes commands asynchronously, so results
+    /// only become available a few frames after they were
+    /// measured. They are collected without waiting, each time
+    /// begin() or end() is called; this function returns the
+    /// most recent of them.
+    ///
+    /// \return Time spent by the GPU between begin() and end(),
+    ///         or sf::Time::Zero if no result is available yet
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getElapsedTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports GPU timers
+    ///
+    /// When GPU timers are not supported, begin() and end()
+    /// do nothing and getElapsedTime() always returns
+    /// sf::Time::Zero.
+    ///
+    /// \return True if GPU timers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the results of the completed measurements
+    ///
+    ////////////////////////////////////////////////////////////
+    void collect();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MeasurementCount = 4 ///< Number of measurements that can be in flight at the same time
+    };
+
+    std::string  m_name;                             ///< Name of the measured section
+    unsigned int m_queries[MeasurementCount * 2];    ///< Pairs of timestamp queries (start, end)
+    bool         m_pending[MeasurementCount];        ///< Is the measurement waiting for its result?
+    unsigned int m_current;                          ///< Index of the next measurement
+    bool         m_running;                          ///< Has begin() been called without end()?
+    Uint64       m_contextId;                        ///< Context owning the queries
+    Time         m_elapsed;                          ///< Latest available result
+};
+
+} // namespace sf
+
+
+#endif // SFML_GPUTIMER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GpuTimer
+/// \ingroup graphics
+///
+/// sf::GpuTimer measures how long the GPU spends executing
+/// the draw calls issued to a render target between begin()
+/// and end(). It is based on OpenGL timestamp queries, so
+/// timers can be nested and can overlap freely.
+///
+/// Query objects belong to the context of the render target
+/// they are first used with; a timer must always be used with
+/// the same render target.
+///
+/// To measure whole frames, see
+/// sf::RenderTarget::setGpuTimingEnabled instead.
+///
+/// Example:
+/// \code
+/// sf::GpuTimer lightingTimer("lighting");
+///
+/// while (window.isOpen())
+/// {
+///     window.clear();
+///
+///     lightingTimer.begin(window);
+///     drawLights(window);
+///     lightingTimer.end(window);
+///
+///     window.display();
+///
+///     std::cout << lightingTimer.getName() << ": "
+///               << lightingTimer.getElapsedTime().asMicroseconds() << " us" << std::endl;
+/// }
+/// \endcode
+///
+/// \see sf::RenderTarget::getStatistics
+///
+////////////////////////////////////////////////////////////
@@ -47,6 +47,27 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function releasing adopted pixels
+    ///
+    /// \see adoptPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*PixelsDeleter)(Uint8* pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters used to resample an image
+    ///
+    /// \see resize, generateMipChain
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ResamplingFilter
+    {
+        Box,      ///< Average of the covered pixels (nearest pixel when enlarging); fastest
+        Bilinear, ///< Linear interpolation, widened to the covered pixels when shrinking
+        Lanczos   ///< Windowed sinc with 3 lobes: sharpest, may ring slightly around hard edges
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -55,6 +76,17 @@ public:
     ////////////////////////////////////////////////////////////
     Image();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The copy always owns its pixels, even if \a copy
+    /// uses adopted pixels.
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Image(const Image& copy);
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -86,12 +118,41 @@ public:
     ////////////////////////////////////////////////////////////
     void create(unsigned int width, unsigned int height, const Uint8* pixels);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image from an array of pixels, without copying them
+    ///
+    /// The image uses the array directly as its storage, which
+    /// avoids allocating and copying the pixels. This is useful
+    /// for very large images produced by another library or
+    /// decoder. The \a pixel array is assumed to contain 32-bits
+    /// RGBA pixels, and have the given \a width and \a height.
+    ///
+    /// The image takes ownership of the array: \a deleter is
+    /// called to release it when the image is destroyed or
+    /// recreated. If \a deleter is null, the array is not
+    /// owned, and must remain valid as long as the image uses it.
+    ///
+    /// If \a pixels is null, an empty image is created. If the
+    /// image is empty, the array is released immediately.
+    ///
+    /// \param width   Width of the image
+    /// \param height  Height of the image
+    /// \param pixels  Array of pixels to adopt
+    /// \param deleter Function releasing the array, or null if it is not owned by the image
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    void adoptPixels(unsigned int width, unsigned int height, Uint8* pixels, PixelsDeleter deleter);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// like progressive jpeg. The base level of compressed
+    /// images is decompressed from dds and ktx files in the BC
+    /// and ETC2 formats (see Texture::loadFromCompressedFile).
     /// If this function fails, the image is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -108,7 +169,9 @@ public:
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// like progressive jpeg. The base level of compressed
+    /// images is decompressed from dds and ktx files in the BC
+    /// and ETC2 formats (see Texture::loadFromCompressedFile).
     /// If this function fails, the image is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -126,7 +189,9 @@ public:
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// like progressive jpeg. The base level of compressed
+    /// images is decompressed from dds and ktx files in the BC
+    /// and ETC2 formats (see Texture::loadFromCompressedFile).
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -258,13 +323,100 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color of each pixel by its alpha
+    ///
+    /// Premultiplied pixels are what sf::BlendMode expects when
+    /// it is set up for premultiplied alpha, and they don't
+    /// produce dark fringes when filtered or resized.
+    /// The alpha of the pixels is left unchanged.
+    ///
+    /// \see unpremultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Divide the color of each pixel by its alpha
+    ///
+    /// This function reverts premultiplyAlpha, up to the precision
+    /// lost by the premultiplication. Fully transparent pixels
+    /// become transparent black.
+    ///
+    /// \see premultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void unpremultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scale the image to a new size
+    ///
+    /// The pixels are filtered with their alpha taken into
+    /// account, so that transparent pixels don't bleed their
+    /// color into their opaque neighbours.
+    ///
+    /// The work can be split between several threads, which
+    /// pays off for large images. The result doesn't depend
+    /// on the number of threads.
+    ///
+    /// Resizing an empty image does nothing, and resizing
+    /// an image to a null size makes it empty.
+    ///
+    /// \param width       New width of the image
+    /// \param height      New height of the image
+    /// \param filter      Filter used to compute the new pixels
+    /// \param threadCount Number of threads used to compute the new pixels
+    ///
+    /// \see generateMipChain
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int width, unsigned int height, ResamplingFilter filter = Bilinear, unsigned int threadCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the mipmap levels of the image
+    ///
+    /// Each level halves the size of the previous one (rounding
+    /// down, and never going below 1), until the last level
+    /// has a size of 1x1. The image itself is not part of the
+    /// chain: \a levels[0] has half its size.
+    ///
+    /// The levels can be given to sf::Texture::loadFromImage,
+    /// which avoids relying on the graphics driver to
+    /// generate them.
+    ///
+    /// \param levels      Vector to fill with the mipmap levels, previous contents are discarded
+    /// \param filter      Filter used to compute each level from the previous one
+    /// \param threadCount Number of threads used to compute each level
+    ///
+    /// \see resize, Texture::loadFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    void generateMipChain(std::vector<Image>& levels, ResamplingFilter filter = Box, unsigned int threadCount = 1) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& operator =(const Image& right);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the pixels and make the image empty
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanup();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u           m_size;   ///< Image size
-    std::vector<Uint8> m_pixels; ///< Pixels of the image
+    Vector2u      m_size;    ///< Image size
+    Uint8*        m_pixels;  ///< Pixels of the image
+    PixelsDeleter m_deleter; ///< Function releasing the pixels, null if they are not owned by the image
 };
 
 } // namespace sf
@@ -295,6 +447,11 @@ private:
 /// if possible you should always use [const] references to
 /// pass or return them to avoid useless copies.
 ///
+/// Loading an image decodes the file directly into the storage
+/// of the image, without any intermediate copy. Pixels allocated
+/// elsewhere can be used without copying them as well, see
+/// adoptPixels.
+///
 /// Usage example:
 /// \code
 /// // Load an image file from a file
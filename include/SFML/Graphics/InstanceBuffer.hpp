@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INSTANCEBUFFER_HPP
+#define SFML_INSTANCEBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Per-instance data for instanced drawing
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API InstanceBuffer : private GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attributes of a single instance
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Instance
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an instance with an identity transform, a
+        /// white color and the (0, 0, 1, 1) texture rectangle,
+        /// which leaves the geometry untouched.
+        ///
+        ////////////////////////////////////////////////////////////
+        Instance();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the instance from its attributes
+        ///
+        /// \param transform   Transform applied to the geometry
+        /// \param color       Color multiplied with the geometry's colors
+        /// \param textureRect Rectangle mapping the geometry's texture coordinates
+        ///
+        ////////////////////////////////////////////////////////////
+        Instance(const Transform& transform, const Color& color = Color::White, const FloatRect& textureRect = FloatRect(0, 0, 1, 1));
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Transform transform;   ///< Transform applied to the geometry
+        Color     color;       ///< Color multiplied with the geometry's colors
+        FloatRect textureRect; ///< Rectangle mapping the geometry's texture coordinates
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty instance buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceBuffer(const InstanceBuffer& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~InstanceBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the instance count
+    ///
+    /// \return Number of instances in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getInstanceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-write access to an instance by its index
+    ///
+    /// This function doesn't check \a index, it must be in range
+    /// [0, getInstanceCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param index Index of the instance to get
+    ///
+    /// \return Reference to the index-th instance
+    ///
+    /// \see getInstanceCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance& operator [](std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only access to an instance by its index
+    ///
+    /// This function doesn't check \a index, it must be in range
+    /// [0, getInstanceCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param index Index of the instance to get
+    ///
+    /// \return Const reference to the index-th instance
+    ///
+    /// \see getInstanceCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Instance& operator [](std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the instance buffer
+    ///
+    /// This function removes all the instances from the buffer.
+    /// It doesn't deallocate the corresponding memory, so that
+    /// adding new instances after clearing doesn't involve
+    /// reallocating all the memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the instance buffer
+    ///
+    /// If \a instanceCount is greater than the current size, the
+    /// previous instances are kept and new (default-constructed)
+    /// instances are added.
+    /// If \a instanceCount is less than the current size, existing
+    /// instances are removed from the buffer.
+    ///
+    /// \param instanceCount New size of the buffer (number of instances)
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an instance to the buffer
+    ///
+    /// \param instance Instance to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Instance& instance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceBuffer& operator =(const InstanceBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this instance buffer with those of another
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(InstanceBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the instance buffer.
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// The buffer is only created the first time the instances
+    /// are drawn with hardware instancing.
+    ///
+    /// \return OpenGL handle of the instance buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind an instance buffer for rendering
+    ///
+    /// This function is for internal use only. Pending changes
+    /// to the instances are uploaded before the buffer is bound
+    /// to GL_ARRAY_BUFFER. Each instance is then laid out as
+    /// two rows of the 2D affine transform (3 floats each), the
+    /// color (4 normalized unsigned bytes) and the texture
+    /// rectangle (4 floats: left, top, width, height).
+    ///
+    /// \param instanceBuffer Pointer to the instance buffer to bind, can be null to use no instance buffer
+    ///
+    /// \return True if the buffer could be bound
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool bind(const InstanceBuffer* instanceBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports hardware instancing
+    ///
+    /// When hardware instancing is not available, instances are
+    /// still drawn, but expanded on the CPU.
+    ///
+    /// \return True if hardware instancing is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Instance>       m_instances;  ///< Instances contained in the buffer
+    mutable unsigned int        m_buffer;     ///< Internal buffer identifier
+    mutable std::size_t         m_size;       ///< Size in instances of the currently allocated buffer
+    mutable bool                m_needUpload; ///< Do the instances need to be uploaded again?
+    mutable std::vector<Vertex> m_geometry;   ///< Copy of the instanced geometry, for expanding the instances on the CPU
+    mutable Uint64              m_geometryId; ///< Identifier of the vertex buffer contents copied to m_geometry
+};
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCEBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::InstanceBuffer
+/// \ingroup graphics
+///
+/// sf::InstanceBuffer holds the attributes of many copies
+/// ("instances") of the same geometry, so that all of them
+/// can be drawn with a single call to
+/// sf::RenderTarget::drawInstanced.
+///
+/// Each instance has its own transform, color and texture
+/// rectangle. The color is multiplied with the colors of
+/// the geometry, and the texture rectangle maps the texture
+/// coordinates of the geometry: a vertex with texture
+/// coordinates (u, v) gets (left + u * width, top + v * height).
+/// Geometry with texture coordinates in [0, 1] can thus be
+/// given a different sub-rectangle of the texture (in pixels)
+/// for each instance.
+///
+/// The instances are stored in system memory, and uploaded
+/// to graphics memory the next time they are drawn after
+/// they have been modified.
+///
+/// When hardware instancing is not available (see isAvailable()),
+/// or when a custom shader is used, the instances are expanded
+/// on the CPU and drawn as regular vertices instead. The geometry
+/// is then read back from the vertex buffer once, and kept by the
+/// instance buffer until the vertex buffer is modified.
+///
+/// Example:
+/// \code
+/// sf::Vertex quad[4] =
+/// {
+///     sf::Vertex(sf::Vector2f(0, 0), sf::Vector2f(0, 0)),
+///     sf::Vertex(sf::Vector2f(0, 8), sf::Vector2f(0, 1)),
+///     sf::Vertex(sf::Vector2f(8, 0), sf::Vector2f(1, 0)),
+///     sf::Vertex(sf::Vector2f(8, 8), sf::Vector2f(1, 1))
+/// };
+/// sf::VertexBuffer geometry(sf::TriangleStrip, sf::VertexBuffer::Static);
+/// geometry.create(4);
+/// geometry.update(quad);
+///
+/// sf::InstanceBuffer bullets;
+/// for (std::size_t i = 0; i < positions.size(); ++i)
+/// {
+///     sf::Transform transform;
+///     transform.translate(positions[i]);
+///     bullets.append(sf::InstanceBuffer::Instance(transform, sf::Color::White, sf::FloatRect(0, 0, 8, 8)));
+/// }
+/// ...
+/// window.drawInstanced(geometry, bullets, &texture);
+/// \endcode
+///
+/// \see sf::RenderTarget::drawInstanced, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERCOMMANDLIST_HPP
+#define SFML_RENDERCOMMANDLIST_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Drawable;
+class RenderTarget;
+class IndexBuffer;
+class InstanceBuffer;
+class VertexBuffer;
+
+namespace priv
+{
+    template <typename T> class DrawRecorder;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief List of draw calls that can be recorded without
+///        an OpenGL context, and replayed later
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderCommandList : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty list.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderCommandList();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderCommandList();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a drawable object
+    ///
+    /// The primitives that the drawable produces are copied
+    /// into the list right away, so the drawable itself may be
+    /// modified or destroyed after this call.
+    ///
+    /// \param drawable Object to draw
+    /// \param states   Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Drawable& drawable, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices
+    ///
+    /// The vertices are copied into the list.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer
+    ///
+    /// Only a reference to the vertex buffer is stored, it must
+    /// stay alive until the list is replayed.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer
+    ///
+    /// Only a reference to the vertex buffer is stored, it must
+    /// stay alive until the list is replayed.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer and an index buffer
+    ///
+    /// Only references to the buffers are stored, they must
+    /// stay alive until the list is replayed.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer referencing the vertices of \a vertexBuffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer and a range of an index buffer
+    ///
+    /// Only references to the buffers are stored, they must
+    /// stay alive until the list is replayed.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer referencing the vertices of \a vertexBuffer
+    /// \param firstIndex   Position of the first index to render
+    /// \param indexCount   Number of indices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record instances of a vertex buffer
+    ///
+    /// Only references to the buffers are stored, they must
+    /// stay alive until the list is replayed, where the instances
+    /// are drawn with sf::RenderTarget::drawInstanced.
+    ///
+    /// \param vertexBuffer   Vertex buffer holding the geometry of a single instance
+    /// \param instanceBuffer Attributes of the instances to draw
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of recorded draw calls
+    ///
+    /// \return Number of draw calls in the list
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of vertices copied into the list
+    ///
+    /// Vertices of recorded vertex buffers are not included.
+    ///
+    /// \return Number of vertices stored in the list
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Preallocate storage for draw calls and vertices
+    ///
+    /// Recording never needs this, but reserving the expected
+    /// amount once avoids growing the storage while recording
+    /// the first frames.
+    ///
+    /// \param commandCount Number of draw calls to reserve
+    /// \param vertexCount  Number of vertices to reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t commandCount, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded draw calls
+    ///
+    /// The memory is kept, so that recording the next frame
+    /// doesn't involve reallocating it.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the recorded draw calls to a render target
+    ///
+    /// The draw calls are replayed in the order in which they
+    /// were recorded. The list is left untouched, it can be
+    /// replayed again.
+    ///
+    /// This function must be called from the thread where
+    /// \a target can be activated, and not while another
+    /// thread is recording into the list.
+    ///
+    /// \param target Render target to draw to
+    ///
+    ////////////////////////////////////////////////////////////
+    void replay(RenderTarget& target) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        RenderStates          states;         ///< Render states of the draw call
+        PrimitiveType         type;           ///< Type of primitives to draw
+        const VertexBuffer*   vertexBuffer;   ///< Vertex buffer to draw, or null to draw the list's vertices
+        const IndexBuffer*    indexBuffer;    ///< Index buffer of the vertex buffer, or null to draw it without indices
+        const InstanceBuffer* instanceBuffer; ///< Instances of the vertex buffer to draw, or null to draw it once
+        std::size_t           firstVertex;    ///< Index of the first vertex, in the vertex buffer or the list's vertices; first index if there is an index buffer
+        std::size_t           vertexCount;    ///< Number of vertices to draw; number of indices if there is an index buffer
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::DrawRecorder<RenderCommandList>* m_recorder; ///< Render target used to capture drawables
+    std::vector<Command>                   m_commands; ///< Recorded draw calls
+    std::vector<Vertex>                    m_vertices; ///< Arena holding the vertices of the recorded vertex arrays
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERCOMMANDLIST_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderCommandList
+/// \ingroup graphics
+///
+/// sf::RenderCommandList records draw calls without issuing
+/// any OpenGL command, so that the geometry of a scene can be
+/// built by worker threads while the render thread, which
+/// owns the OpenGL context, only has to replay the lists.
+///
+/// Vertex arrays and drawables are copied into the list when
+/// recorded, and the render states are stored by value.
+/// Textures, shaders, vertex buffers and instance buffers
+/// are only referenced, and must stay alive and unchanged
+/// until the list is replayed.
+///
+/// Each list must be filled by a single thread at a time;
+/// use one list per worker. Recording a sprite, a shape or a
+/// vertex array doesn't need an OpenGL context. Modifying
+/// shapes or texts, or drawing texts whose glyphs were never
+/// rendered before, updates graphics resources: SFML then
+/// activates an internal context on the worker thread, which
+/// works but is slower, so prefer preparing these objects
+/// up front.
+///
+/// Replaying into a target that has batching enabled (see
+/// sf::RenderTarget::setBatchingEnabled) lets consecutive
+/// draw calls with the same states be merged into a single
+/// one.
+///
+/// Example:
+/// \code
+/// // On each worker thread
+/// void buildChunk(Chunk& chunk)
+/// {
+///     chunk.commands.clear();
+///     for (std::size_t i = 0; i < chunk.sprites.size(); ++i)
+///         chunk.commands.draw(chunk.sprites[i]);
+/// }
+///
+/// // On the render thread, once the workers are done
+/// window.clear();
+/// for (std::size_t i = 0; i < chunks.size(); ++i)
+///     chunks[i].commands.replay(window);
+/// window.display();
+/// \endcode
+///
+/// \see sf::DrawQueue, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
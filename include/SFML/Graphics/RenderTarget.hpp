@@ -38,13 +38,23 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class GpuTimer;
+class IndexBuffer;
+class InstanceBuffer;
 class VertexBuffer;
 
+namespace priv
+{
+    class VertexRingBuffer;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
 ///
@@ -53,6 +63,32 @@ class SFML_GRAPHICS_API RenderTarget : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rendering statistics of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int drawCalls;        ///< Number of OpenGL draw calls
+        unsigned int vertices;         ///< Number of vertices submitted to the draw calls
+        unsigned int textureBinds;     ///< Number of texture changes
+        unsigned int shaderBinds;      ///< Number of shader changes
+        unsigned int blendModeChanges; ///< Number of blend mode changes
+        unsigned int cacheMisses;      ///< Number of draw calls that had to reapply all the render states
+        Time         gpuTime;          ///< Time spent by the GPU on the frame, if GPU timing is enabled
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -248,6 +284,30 @@ public:
     void draw(const Vertex* vertices, std::size_t vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices
+    ///        and an array of indices
+    ///
+    /// The primitives are assembled from the vertices referenced
+    /// by \a indices, in order. Since vertex arrays are sent to
+    /// the graphics card every time they are drawn, the indices
+    /// are resolved on the CPU; to save graphics memory and
+    /// bandwidth, use a sf::VertexBuffer with a sf::IndexBuffer.
+    ///
+    /// Nothing is drawn if an index is out of range.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount,
+              const Uint32* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw primitives defined by a vertex buffer
     ///
@@ -268,6 +328,162 @@ public:
     ////////////////////////////////////////////////////////////
     void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer and an index buffer
+    ///
+    /// The primitive type is the one of \a vertexBuffer.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer referencing the vertices of \a vertexBuffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer and a range of an index buffer
+    ///
+    /// The primitive type is the one of \a vertexBuffer.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer referencing the vertices of \a vertexBuffer
+    /// \param firstIndex   Position of the first index to render
+    /// \param indexCount   Number of indices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw many instances of the primitives defined by a vertex buffer
+    ///
+    /// Each instance of \a instanceBuffer draws the whole vertex
+    /// buffer once, with the instance's transform combined with
+    /// \a states.transform, its color multiplied with the
+    /// vertices' colors, and its texture rectangle applied to
+    /// the vertices' texture coordinates.
+    ///
+    /// When hardware instancing is available, all the instances
+    /// are drawn with a single call. Otherwise, or when a custom
+    /// shader is given in \a states, the instances are expanded
+    /// on the CPU and drawn as a regular vertex array.
+    ///
+    /// \param vertexBuffer   Vertex buffer holding the geometry of a single instance
+    /// \param instanceBuffer Attributes of the instances to draw
+    /// \param states         Render states to use for drawing
+    ///
+    /// \see sf::InstanceBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive calls to
+    /// draw(const Vertex*, std::size_t, PrimitiveType, const RenderStates&)
+    /// that share the same texture, shader, blend mode and
+    /// primitive type are not submitted immediately: their
+    /// vertices are transformed on the CPU and accumulated into
+    /// a single vertex stream, which is drawn with one call
+    /// when the render states change, when the view changes,
+    /// when clear() or display() is called, or when flush()
+    /// is called explicitly.
+    ///
+    /// Strips and fans are converted to their list equivalent
+    /// (sf::Triangles or sf::Lines) so that they can be merged.
+    /// Built-in drawables (sprites, shapes and texts) draw their
+    /// vertex arrays instead of their vertex buffers while
+    /// batching is enabled, so that they can take part in it.
+    ///
+    /// Since the geometry is drawn later than requested, the
+    /// textures and shaders that it uses must stay alive and
+    /// unchanged until the batch is flushed. In particular, if
+    /// you update a texture or a shader uniform between two draw
+    /// calls that use it, call flush() before doing so.
+    /// You must also call flush() before issuing your own OpenGL
+    /// commands, unless you use pushGLStates/popGLStates.
+    ///
+    /// Batching is disabled by default. Disabling it flushes
+    /// the pending geometry.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the geometry that is pending in the current batch
+    ///
+    /// This function is called automatically whenever needed,
+    /// you only have to call it yourself when a resource used
+    /// by the pending geometry is about to be modified or
+    /// destroyed, or before issuing direct OpenGL commands.
+    /// It does nothing if batching is disabled or if there
+    /// is nothing to draw.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rendering statistics of the last frame
+    ///
+    /// The counters are accumulated between two calls to
+    /// display() (sf::RenderWindow and sf::RenderTexture), and
+    /// this function returns those of the last completed frame.
+    /// They count what was actually submitted to OpenGL, so
+    /// draw calls merged by batching only count once.
+    ///
+    /// \return Statistics of the last completed frame
+    ///
+    /// \see setGpuTimingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable measuring the GPU time of frames
+    ///
+    /// When enabled, the time spent by the GPU between two
+    /// calls to display() is measured with a sf::GpuTimer and
+    /// reported in the gpuTime member of the statistics. Since
+    /// the result is collected without stalling the GPU, it
+    /// lags a few frames behind.
+    ///
+    /// GPU timing is disabled by default. It has no effect if
+    /// sf::GpuTimer::isAvailable() returns false.
+    ///
+    /// \param enabled True to enable GPU timing, false to disable it
+    ///
+    /// \see isGpuTimingEnabled, getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGpuTimingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether measuring the GPU time of frames is enabled
+    ///
+    /// \return True if GPU timing is enabled, false otherwise
+    ///
+    /// \see setGpuTimingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isGpuTimingEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -383,8 +599,130 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Complete the current frame
+    ///
+    /// The derived classes must call this function when the
+    /// frame is presented (i.e. in their display() function).
+    /// It flushes the pending batch and publishes the rendering
+    /// statistics of the frame.
+    ///
+    ////////////////////////////////////////////////////////////
+    void finishFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Intercept primitives defined by an array of vertices
+    ///
+    /// This function is called by draw() before anything is
+    /// drawn. Derived classes that store draw calls rather than
+    /// render them (such as the one used by sf::DrawQueue to
+    /// capture drawables) can override it and return true, in
+    /// which case nothing is drawn to the target.
+    ///
+    /// The default implementation returns false.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \return True if the primitives were consumed and must not be drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool interceptDraw(const Vertex* vertices, std::size_t vertexCount,
+                               PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Intercept primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    /// \return True if the primitives were consumed and must not be drawn
+    ///
+    /// \see interceptDraw(const Vertex*, std::size_t, PrimitiveType, const RenderStates&)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool interceptDraw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                               std::size_t vertexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Intercept primitives defined by a vertex buffer and an index buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer referencing the vertices of \a vertexBuffer
+    /// \param firstIndex   Position of the first index to render
+    /// \param indexCount   Number of indices to render
+    /// \param states       Render states to use for drawing
+    ///
+    /// \return True if the primitives were consumed and must not be drawn
+    ///
+    /// \see interceptDraw(const Vertex*, std::size_t, PrimitiveType, const RenderStates&)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool interceptDraw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer,
+                               std::size_t firstIndex, std::size_t indexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Intercept instances of a vertex buffer
+    ///
+    /// This function is called by drawInstanced() before any
+    /// OpenGL query, so that targets which don't render can
+    /// record instanced draws without an OpenGL context.
+    ///
+    /// \param vertexBuffer   Vertex buffer holding the geometry of a single instance
+    /// \param instanceBuffer Attributes of the instances to draw
+    /// \param states         Render states to use for drawing
+    ///
+    /// \return True if the instances were consumed and must not be drawn
+    ///
+    /// \see interceptDraw(const Vertex*, std::size_t, PrimitiveType, const RenderStates&)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool interceptDraw(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer,
+                               const RenderStates& states);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives immediately, bypassing the batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawImmediate(const Vertex* vertices, std::size_t vertexCount,
+                       PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw instances by expanding them on the CPU
+    ///
+    /// \param vertexBuffer   Vertex buffer holding the geometry of a single instance
+    /// \param instanceBuffer Attributes of the instances to draw
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstancesOnCpu(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append primitives to the current batch
+    ///
+    /// The batch is flushed first if the render states or
+    /// primitive type are not compatible with it.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void batchVertices(const Vertex* vertices, std::size_t vertexCount,
+                       PrimitiveType type, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -423,6 +761,41 @@ private:
     ////////////////////////////////////////////////////////////
     void applyShader(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the program and upload the matrices used by
+    ///        the core profile backend
+    ///
+    /// \param shader Shader to draw with, or NULL to use the default one
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyCoreProgram(const Shader* shader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set up the vertex attributes of the core profile
+    ///        backend, for the vertices of the bound buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyCoreAttributes();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives with the core profile backend
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawCore(const Vertex* vertices, std::size_t vertexCount,
+                  PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set up the vertex attributes for the vertices of
+    ///        the bound vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyVertexBufferAttributes();
+
     ////////////////////////////////////////////////////////////
     /// \brief Setup environment for drawing
     ///
@@ -468,13 +841,68 @@ private:
         Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the core profile backend, which replaces
+    ///        the fixed-function pipeline with a built-in shader
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CoreProfile
+    {
+        enum
+        {
+            ProjectionDirty = 1 << 0,
+            ModelViewDirty  = 1 << 1,
+            TextureDirty    = 1 << 2
+        };
+
+        bool                enabled;               ///< Does the target draw with the core profile backend?
+        Shader*             shader;                ///< Built-in shader replacing the fixed-function pipeline
+        unsigned int        vertexArray;           ///< Vertex array object of the context, owned by the context
+        Uint64              vertexArrayContextId;  ///< Context in which the vertex array object was looked up
+        VertexBuffer*       streamBuffer;          ///< Buffer for the vertices that don't fit in the ring buffer
+        unsigned int        program;               ///< Program whose uniform locations are cached
+        int                 projectionLocation;    ///< Location of sf_projectionMatrix in the program
+        int                 modelViewLocation;     ///< Location of sf_modelViewMatrix in the program
+        int                 textureMatrixLocation; ///< Location of sf_textureMatrix in the program
+        int                 texturedLocation;      ///< Location of sf_textured in the program
+        unsigned int        dirty;                 ///< Uniforms that must be uploaded before the next draw
+        Transform           modelView;             ///< Current model-view matrix
+        Transform           textureMatrix;         ///< Current texture matrix
+        bool                textured;              ///< Is a texture bound?
+        std::vector<Vertex> triangles;             ///< Scratch storage for quads converted to triangles
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry pending in the automatic batching mode
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        bool                enabled;   ///< Is batching enabled?
+        PrimitiveType       type;      ///< Primitive type of the pending vertices
+        BlendMode           blendMode; ///< Blend mode of the pending vertices
+        const Texture*      texture;   ///< Texture of the pending vertices
+        Uint64              textureId; ///< Cache identifier of the texture when the batch was started
+        const Shader*       shader;    ///< Shader of the pending vertices
+        std::vector<Vertex> vertices;  ///< Pending vertices, already transformed
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     View        m_defaultView; ///< Default view
     View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
-    Uint64      m_id;          ///< Unique number that identifies the RenderTarget
+    StatesCache             m_cache;           ///< Render states cache
+    Batch                   m_batch;           ///< Pending geometry of the batching mode
+    CoreProfile             m_core;            ///< State of the core profile backend
+    std::vector<Vertex>     m_indexedVertices; ///< Scratch storage for resolving the indices of vertex arrays
+    priv::VertexRingBuffer* m_ringBuffer;      ///< Streaming buffer for immediate-mode vertices
+    Shader*                 m_instancing;      ///< Built-in shader used for hardware instancing
+    Statistics              m_stats;           ///< Statistics of the frame in progress
+    Statistics              m_frameStats;      ///< Statistics of the last completed frame
+    GpuTimer*               m_frameTimer;      ///< Timer measuring the GPU time of frames, if enabled
+    Uint64                  m_contextId;       ///< Context in which the target was last activated, 0 if none
+    Uint64                  m_activationId;    ///< Activation of the context in which the target was last activated, 0 if none
 };
 
 } // namespace sf
@@ -505,6 +933,19 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
+/// When the target's context is an OpenGL 3.2+ core profile
+/// context (see sf::ContextSettings::Core), the fixed-function
+/// pipeline doesn't exist anymore: render targets then draw
+/// through a built-in shader instead, and sf::Quads are split
+/// into triangles. Custom shaders used in such a context must
+/// declare the same inputs as the built-in one: the vertex
+/// attributes \p sf_position, \p sf_color and \p sf_texCoords,
+/// and the \p mat4 uniforms \p sf_projectionMatrix,
+/// \p sf_modelViewMatrix and \p sf_textureMatrix. Since core
+/// profiles have no attribute stack, popGLStates only unbinds
+/// the objects used by SFML instead of restoring the previous
+/// states.
+///
 /// \see sf::RenderWindow, sf::RenderTexture, sf::View
 ///
 ////////////////////////////////////////////////////////////
@@ -178,6 +178,16 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window is displayed
+    ///
+    /// This function draws the geometry that is still pending
+    /// in the batch (see RenderTarget::setBatchingEnabled) and
+    /// completes the rendering statistics of the frame.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
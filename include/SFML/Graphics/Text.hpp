@@ -33,10 +33,12 @@
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/TextLayout.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/System/String.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -378,6 +380,9 @@ public:
     /// If \a index is out of range, the position of the end of
     /// the string is returned.
     ///
+    /// The layout of the text is cached (see getLayout), so
+    /// repeated calls don't lay out the string again.
+    ///
     /// \param index Index of the character
     ///
     /// \return Position of the character
@@ -385,6 +390,25 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2f findCharacterPos(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layout of the text
+    ///
+    /// The layout gives the position of every glyph and line of
+    /// the text, in local coordinates. It is cached, and only
+    /// computed again when the string or the attributes that
+    /// affect it change, so it is cheap to query repeatedly
+    /// (for example to find the character under the mouse).
+    ///
+    /// The returned reference stays valid until the text is
+    /// modified or destroyed.
+    ///
+    /// \return Layout of the text
+    ///
+    /// \see findCharacterPos
+    ///
+    ////////////////////////////////////////////////////////////
+    const TextLayout& getLayout() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the local bounding rectangle of the entity
     ///
@@ -433,25 +457,58 @@ private:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::vector<std::pair<unsigned int, std::size_t> > PageRanges; ///< Font page and vertex count of consecutive vertices
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the geometry after its last character
+    ///
+    /// It allows the quads of characters appended to the string
+    /// to be added without building the whole geometry again.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LayoutState
+    {
+        LayoutState();
+
+        std::size_t length;     ///< Number of characters of the string in the geometry
+        std::size_t glyphCount; ///< Number of glyphs of the layout in the geometry
+        std::size_t lineCount;  ///< Number of closed lines of the layout in the geometry
+        Vector2f    min;        ///< Minimum coordinates of the outline bounds
+        Vector2f    max;        ///< Maximum coordinates of the outline bounds
+        std::size_t fillEnd;    ///< Number of fill vertices, not counting the trailing lines
+        std::size_t outlineEnd; ///< Number of outline vertices, not counting the trailing lines
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String               m_string;                ///< String to display
-    const Font*          m_font;                  ///< Font used to display the string
-    unsigned int         m_characterSize;         ///< Base size of characters, in pixels
-    float                m_letterSpacingFactor;   ///< Spacing factor between letters
-    float                m_lineSpacingFactor;     ///< Spacing factor between lines
-    Uint32               m_style;                 ///< Text style (see Style enum)
-    Color                m_fillColor;             ///< Text fill color
-    Color                m_outlineColor;          ///< Text outline color
-    float                m_outlineThickness;      ///< Thickness of the text's outline
-    mutable VertexArray  m_vertices;              ///< Vertex array containing the fill geometry
-    mutable VertexArray  m_outlineVertices;       ///< Vertex array containing the outline geometry
-    mutable VertexBuffer m_verticesBuffer;        ///< Vertex buffer containing the fill geometry
-    mutable VertexBuffer m_outlineVerticesBuffer; ///< Vertex buffer containing the outline geometry
-    mutable FloatRect    m_bounds;                ///< Bounding rectangle of the text (in local coordinates)
-    mutable bool         m_geometryNeedUpdate;    ///< Does the geometry need to be recomputed?
-    mutable Uint64       m_fontTextureId;         ///< The font texture id
+    String               m_string;                  ///< String to display
+    const Font*          m_font;                    ///< Font used to display the string
+    unsigned int         m_characterSize;           ///< Base size of characters, in pixels
+    float                m_letterSpacingFactor;     ///< Spacing factor between letters
+    float                m_lineSpacingFactor;       ///< Spacing factor between lines
+    Uint32               m_style;                   ///< Text style (see Style enum)
+    Color                m_fillColor;               ///< Text fill color
+    Color                m_outlineColor;            ///< Text outline color
+    float                m_outlineThickness;        ///< Thickness of the text's outline
+    mutable VertexArray  m_vertices;                ///< Vertex array containing the fill geometry
+    mutable VertexArray  m_outlineVertices;         ///< Vertex array containing the outline geometry
+    mutable VertexBuffer m_verticesBuffer;          ///< Vertex buffer containing the fill geometry
+    mutable VertexBuffer m_outlineVerticesBuffer;   ///< Vertex buffer containing the outline geometry
+    mutable PageRanges   m_fillPages;               ///< Font pages used by the fill geometry
+    mutable PageRanges   m_outlinePages;            ///< Font pages used by the outline geometry
+    mutable FloatRect    m_bounds;                  ///< Bounding rectangle of the text (in local coordinates)
+    mutable bool         m_geometryNeedUpdate;      ///< Does the geometry need to be recomputed?
+    mutable LayoutState  m_layout;                  ///< Layout state at the end of the geometry
+    mutable Uint64       m_fontTextureId;           ///< The font texture id
+    mutable unsigned int m_fontPageEvictions;       ///< Number of font pages evicted when the geometry was built
+    mutable TextLayout   m_textLayout;              ///< Layout of the text, from which the geometry is built
+    mutable bool         m_textLayoutNeedUpdate;    ///< Does the cached layout need to be recomputed?
+    mutable Uint64       m_textLayoutTextureId;     ///< The font texture id when the layout was computed
+    mutable unsigned int m_textLayoutPageEvictions; ///< Number of font pages evicted when the layout was computed
 };
 
 } // namespace sf
@@ -0,0 +1,431 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTBATCH_HPP
+#define SFML_TEXTBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/TextLayout.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/String.hpp>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Set of strings sharing a font and a character size,
+///        drawn together in a single call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextBatch : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch, without font.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the batch from a font and a character size
+    ///
+    /// \param font          Font used to draw the strings
+    /// \param characterSize Base size of characters, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    TextBatch(const Font& font, unsigned int characterSize = 30);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the font of the batch
+    ///
+    /// The \a font argument refers to a font that must
+    /// exist as long as the batch uses it. Indeed, the batch
+    /// doesn't store its own copy of the font, but rather keeps
+    /// a pointer to the one that you passed to this function.
+    /// Changing the font lays out all the strings again.
+    ///
+    /// \param font New font
+    ///
+    /// \see getFont
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the character size of the batch
+    ///
+    /// Changing the character size lays out all the strings again.
+    ///
+    /// \param size New character size, in pixels
+    ///
+    /// \see getCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCharacterSize(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the font of the batch
+    ///
+    /// If the batch has no font attached, a NULL pointer is returned.
+    ///
+    /// \return Pointer to the batch's font
+    ///
+    /// \see setFont
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font* getFont() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size of the batch
+    ///
+    /// \return Size of the characters, in pixels
+    ///
+    /// \see setCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharacterSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a string to the batch
+    ///
+    /// \param string   String to display
+    /// \param position Position of the string, in the local coordinates of the batch
+    /// \param color    Fill color of the string
+    /// \param style    Style of the string, combination of sf::Text::Style flags
+    ///
+    /// \return Index of the new entry
+    ///
+    /// \see remove, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const String& string, const Vector2f& position, const Color& color = Color::White, Uint32 style = Text::Regular);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an entry from the batch
+    ///
+    /// The entries that follow the removed one are shifted,
+    /// their index is decreased by one.
+    ///
+    /// \param index Index of the entry to remove
+    ///
+    /// \see add, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the entries from the batch
+    ///
+    /// \see add, remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of entries in the batch
+    ///
+    /// \return Number of entries
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEntryCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the string of an entry
+    ///
+    /// Only this entry is laid out again.
+    ///
+    /// \param index  Index of the entry
+    /// \param string New string
+    ///
+    /// \see getEntryString
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEntryString(std::size_t index, const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the position of an entry
+    ///
+    /// The entry is moved without being laid out again.
+    ///
+    /// \param index    Index of the entry
+    /// \param position New position, in the local coordinates of the batch
+    ///
+    /// \see getEntryPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEntryPosition(std::size_t index, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the fill color of an entry
+    ///
+    /// The colors of the entry are rewritten without laying
+    /// it out again.
+    ///
+    /// \param index Index of the entry
+    /// \param color New fill color
+    ///
+    /// \see getEntryColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEntryColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the style of an entry
+    ///
+    /// Only this entry is laid out again.
+    ///
+    /// \param index Index of the entry
+    /// \param style New style, combination of sf::Text::Style flags
+    ///
+    /// \see getEntryStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEntryStyle(std::size_t index, Uint32 style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the string of an entry
+    ///
+    /// \param index Index of the entry
+    ///
+    /// \return String of the entry
+    ///
+    /// \see setEntryString
+    ///
+    ////////////////////////////////////////////////////////////
+    const String& getEntryString(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of an entry
+    ///
+    /// \param index Index of the entry
+    ///
+    /// \return Position of the entry, in the local coordinates of the batch
+    ///
+    /// \see setEntryPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getEntryPosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fill color of an entry
+    ///
+    /// \param index Index of the entry
+    ///
+    /// \return Fill color of the entry
+    ///
+    /// \see setEntryColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getEntryColor(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the style of an entry
+    ///
+    /// \param index Index of the entry
+    ///
+    /// \return Style of the entry
+    ///
+    /// \see setEntryStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getEntryStyle(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of an entry
+    ///
+    /// \param index Index of the entry
+    ///
+    /// \return Bounds of the entry, in the local coordinates of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getEntryBounds(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the batch
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the batch
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::vector<std::pair<unsigned int, std::size_t> > Ranges; ///< Draw key (font page and shader) and vertex count of consecutive vertices
+
+    ////////////////////////////////////////////////////////////
+    /// \brief String of the batch, and its geometry
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Entry();
+
+        String                   string;             ///< String to display
+        Vector2f                 position;           ///< Position of the string
+        Color                    color;              ///< Fill color of the string
+        Uint32                   style;              ///< Text style (see sf::Text::Style)
+        VertexArray              vertices;           ///< Geometry of the string, relative to its position and grouped by draw key
+        Ranges                   ranges;             ///< Draw key and vertex count of each group of vertices
+        std::vector<std::size_t> offsets;            ///< Offset of each group of vertices in the geometry of the batch
+        FloatRect                bounds;             ///< Bounds of the string, relative to its position
+        bool                     layoutNeedUpdate;   ///< Does the string need to be laid out again?
+        bool                     verticesNeedUpdate; ///< Do the vertices need to be written again to the batch?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the geometry of the batch is updated
+    ///
+    /// Only the entries that changed are updated, unless
+    /// the draw keys of an entry change, in which case the
+    /// geometry of the batch is assembled again.
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lay out the string of an entry
+    ///
+    /// \param entry Entry to lay out
+    ///
+    ////////////////////////////////////////////////////////////
+    void layout(Entry& entry) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the vertices of an entry to the geometry of the batch
+    ///
+    /// \param entry  Entry to write
+    /// \param upload Write them to the vertex buffer as well?
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeEntry(const Entry& entry, bool upload) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Font*                m_font;               ///< Font used to display the strings
+    unsigned int               m_characterSize;      ///< Base size of characters, in pixels
+    mutable std::vector<Entry> m_entries;            ///< Strings of the batch
+    mutable TextLayout         m_layout;             ///< Layout of the last entry laid out, kept to reuse its memory
+    mutable VertexArray        m_vertices;           ///< Geometry of all the strings, grouped by draw key
+    mutable VertexBuffer       m_vertexBuffer;       ///< Vertex buffer containing the geometry
+    mutable Ranges             m_ranges;             ///< Draw key and vertex count of each group of vertices
+    mutable FloatRect          m_bounds;             ///< Bounding rectangle of the batch (in local coordinates)
+    mutable bool               m_geometryNeedUpdate; ///< Do all the entries need to be laid out again?
+    mutable bool               m_assembleNeedUpdate; ///< Does the geometry of the batch need to be assembled again?
+    mutable bool               m_entriesNeedUpdate;  ///< Does any entry need to be updated?
+    mutable Uint64             m_fontTextureId;      ///< The font texture id
+    mutable unsigned int       m_fontPageEvictions;  ///< Number of font pages evicted when the geometry was built
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextBatch
+/// \ingroup graphics
+///
+/// sf::TextBatch displays many strings that share the same font
+/// and character size, such as the labels of a user interface.
+/// Each sf::Text owns its own geometry and is drawn with its own
+/// calls; a batch instead assembles the geometry of all its
+/// strings into a single vertex buffer, and draws it with one
+/// call per font page (usually, a single one).
+///
+/// Each entry of the batch has its own string, position, fill
+/// color and style. Changing an entry only updates the vertices
+/// of this entry: its string is laid out again if needed, and
+/// its vertices are written in place to the vertex buffer. The
+/// geometry of the whole batch is only assembled again when the
+/// number of vertices of an entry changes.
+///
+/// Outlines are not supported by sf::TextBatch; use sf::Text to
+/// draw outlined strings.
+///
+/// Like sf::Text, the batch doesn't copy its font, which must
+/// exist as long as the batch uses it.
+///
+/// Usage example:
+/// \code
+/// sf::Font font;
+/// font.loadFromFile("arial.ttf");
+///
+/// sf::TextBatch labels(font, 16);
+/// std::size_t score = labels.add("Score: 0", sf::Vector2f(10, 10));
+/// labels.add("Paused", sf::Vector2f(10, 40), sf::Color::Yellow, sf::Text::Bold);
+///
+/// // Later, only this entry is updated
+/// labels.setEntryString(score, "Score: 100");
+///
+/// window.draw(labels);
+/// \endcode
+///
+/// \see sf::Text, sf::Font
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,362 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTLAYOUT_HPP
+#define SFML_TEXTLAYOUT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/String.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+class Text;
+
+////////////////////////////////////////////////////////////
+/// \brief Positions of the glyphs and lines of a laid out string
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextLayout
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph placed by the layout
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphInfo
+    {
+        Uint32       codePoint;   ///< Unicode code point of the character
+        std::size_t  index;       ///< Index of the character in the string
+        Vector2f     position;    ///< Position of the glyph origin, on the baseline
+        FloatRect    bounds;      ///< Bounding rectangle of the glyph, relative to its origin
+        IntRect      textureRect; ///< Texture coordinates of the glyph, at the time of the layout
+        unsigned int page;        ///< Font page (texture) containing the glyph, at the time of the layout
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Line of the layout
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        std::size_t first;  ///< Index of the first character of the line
+        std::size_t length; ///< Number of characters of the line, not counting the line break
+        float       top;    ///< Vertical position of the top of the line
+        float       width;  ///< Horizontal position of the end of the line
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty layout.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextLayout();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the layout of a string
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    TextLayout(const String& string, const Font& font, unsigned int characterSize, Uint32 style = 0,
+               float letterSpacingFactor = 1.f, float lineSpacingFactor = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lay out a string
+    ///
+    /// The layout follows the same rules as sf::Text, so that
+    /// its positions match the text drawn with the same
+    /// parameters, in the local coordinates of the text.
+    ///
+    /// \param string              String to lay out
+    /// \param font                Font of the glyphs
+    /// \param characterSize       Base size of characters, in pixels
+    /// \param style               Text style, combination of sf::Text::Style flags
+    /// \param letterSpacingFactor Spacing factor between letters (see sf::Text::setLetterSpacing)
+    /// \param lineSpacingFactor   Spacing factor between lines (see sf::Text::setLineSpacing)
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const String& string, const Font& font, unsigned int characterSize, Uint32 style = 0,
+                float letterSpacingFactor = 1.f, float lineSpacingFactor = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lay out the string of a text, with its parameters
+    ///
+    /// A text without font gives an empty layout.
+    ///
+    /// \param text Text to lay out
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Text& text);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lay out the characters appended to the string
+    ///
+    /// This is much faster than laying out the whole string
+    /// again, but \a string must start with the string of the
+    /// last update, and the other parameters are unchanged.
+    /// Only the characters that follow are laid out.
+    ///
+    /// \param string String to lay out, extending the current one
+    ///
+    ////////////////////////////////////////////////////////////
+    void extend(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of characters of the laid out string
+    ///
+    /// \return Number of characters
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCharacterCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the glyphs placed by the layout
+    ///
+    /// Whitespace characters have no glyph, so there may be
+    /// less glyphs than characters.
+    ///
+    /// \return Glyphs, in the order of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<GlyphInfo>& getGlyphs() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the lines of the layout
+    ///
+    /// There is always at least one line, even for an empty string.
+    ///
+    /// \return Lines, from top to bottom
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Line>& getLines() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the line containing a character
+    ///
+    /// This function runs in logarithmic time. The line break
+    /// ending a line belongs to this line.
+    ///
+    /// \param index Index of the character (clamped to the size of the string)
+    ///
+    /// \return Index of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLineIndex(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of the caret before a character
+    ///
+    /// This is the same position as sf::Text::findCharacterPos,
+    /// in local coordinates. It is computed in logarithmic time.
+    ///
+    /// \param index Index of the character (clamped to the size of the string,
+    ///              which gives the position of the end of the string)
+    ///
+    /// \return Position of the top of the caret
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getCaretPosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the caret position closest to a point
+    ///
+    /// The line is chosen from the vertical coordinate of the
+    /// point, then the closest caret position on this line is
+    /// found from the horizontal coordinate. Points outside of
+    /// the text are clamped to its first or last line. This
+    /// function runs in logarithmic time.
+    ///
+    /// \param point Point to test, in local coordinates
+    ///
+    /// \return Index of the character before which the caret should be placed
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t hitTest(const Vector2f& point) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the layout
+    ///
+    /// \return Bounds of the glyphs, in local coordinates (same as sf::Text::getLocalBounds without outline)
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append the quads of the glyphs to a vertex array
+    ///
+    /// The vertices form triangles, textured with the glyph pages
+    /// of the font (see sf::Font::getPageTexture). Unless the font
+    /// uses a shared atlas, all the glyphs of a character size are
+    /// in the same page, sf::Font::getTexture(characterSize).
+    /// The underline and strike through lines are added as well.
+    ///
+    /// The quads use the texture coordinates that the glyphs had
+    /// when the text was laid out: the layout must be updated if
+    /// the glyphs of the font were evicted since then.
+    ///
+    /// \param vertices Vertex array to append the quads to
+    /// \param color    Color of the vertices
+    /// \param offset   Offset added to the position of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendVertices(VertexArray& vertices, const Color& color, const Vector2f& offset = Vector2f()) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append the quads of the glyphs of a font page to a vertex array
+    ///
+    /// This overload is useful with fonts using a shared atlas,
+    /// to draw each page with its own texture.
+    ///
+    /// \param vertices Vertex array to append the quads to
+    /// \param color    Color of the vertices
+    /// \param offset   Offset added to the position of the vertices
+    /// \param page     Font page whose glyphs are appended
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendVertices(VertexArray& vertices, const Color& color, const Vector2f& offset, unsigned int page) const;
+
+private:
+
+    friend class Text;
+    friend class TextBatch;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lay out the characters that follow the current layout
+    ///
+    /// \param string String whose characters are laid out, from the current character count
+    ///
+    ////////////////////////////////////////////////////////////
+    void layoutCharacters(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append the quads of a range of glyphs to a text geometry
+    ///
+    /// \param vertices Vertex array (triangles) to append the quads to
+    /// \param keys     Key of each quad, to which the font page of the glyphs is appended
+    /// \param first    Index of the first glyph
+    /// \param color    Color of the vertices
+    /// \param offset   Offset added to the position of the vertices
+    /// \param allPages Append the glyphs of all the pages?
+    /// \param page     Font page whose glyphs are appended, if not \a allPages
+    ///
+    ////////////////////////////////////////////////////////////
+    void addGlyphQuads(VertexArray& vertices, std::vector<unsigned int>& keys, std::size_t first, const Color& color,
+                       const Vector2f& offset, bool allPages = true, unsigned int page = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append the underline and strike through of a range of lines to a text geometry
+    ///
+    /// \param vertices         Vertex array (triangles) to append the quads to
+    /// \param keys             Key of each quad, to which the font page of the lines is appended
+    /// \param first            Index of the first line
+    /// \param last             Index after the last line
+    /// \param color            Color of the vertices
+    /// \param offset           Offset added to the position of the vertices
+    /// \param outlineThickness Thickness of the outline around the lines
+    /// \param allPages         Append the lines whatever their page?
+    /// \param page             Font page whose lines are appended, if not \a allPages
+    ///
+    ////////////////////////////////////////////////////////////
+    void addLineQuads(VertexArray& vertices, std::vector<unsigned int>& keys, std::size_t first, std::size_t last, const Color& color,
+                      const Vector2f& offset, float outlineThickness = 0, bool allPages = true, unsigned int page = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Font*            m_font;                ///< Font of the glyphs
+    unsigned int           m_characterSize;       ///< Base size of characters, in pixels
+    Uint32                 m_style;               ///< Text style (see sf::Text::Style)
+    std::vector<GlyphInfo> m_glyphs;              ///< Glyphs placed by the layout
+    std::vector<Line>      m_lines;               ///< Lines of the layout, the last one is still open
+    std::vector<float>     m_carets;              ///< Horizontal position of the caret before each character, and at the end
+    float                  m_lineSpacing;         ///< Distance between two lines
+    float                  m_letterSpacing;       ///< Extra space after each glyph
+    float                  m_whitespaceWidth;     ///< Advance of a space, letter spacing included
+    float                  m_italicShear;         ///< Horizontal shear of the glyphs
+    float                  m_padding;             ///< Margin added around the glyph bounds in the quads
+    float                  m_texturePadding;      ///< Margin added around the glyph texture rectangles in the quads
+    float                  m_underlineOffset;     ///< Offset of the underline from the baseline
+    float                  m_underlineThickness;  ///< Thickness of the underline and strike through
+    float                  m_strikeThroughOffset; ///< Offset of the strike through from the baseline
+    unsigned int           m_linePage;            ///< Font page whose white square textures the lines
+    Uint32                 m_prevChar;            ///< Last character laid out, for kerning
+    Vector2f               m_min;                 ///< Minimum coordinates of the bounds
+    Vector2f               m_max;                 ///< Maximum coordinates of the bounds
+    FloatRect              m_bounds;              ///< Bounding rectangle of the glyphs
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTLAYOUT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextLayout
+/// \ingroup graphics
+///
+/// sf::TextLayout computes once where each character of a string
+/// goes, with the same rules as sf::Text, and keeps the result in
+/// a compact form: the glyphs and their positions, the lines, and
+/// the horizontal caret position before each character.
+///
+/// It is mostly useful for text editing: finding the position of
+/// the caret, or the character under the mouse, takes logarithmic
+/// time instead of laying out the string again for each query.
+/// The glyphs can also be turned into vertices, to draw the text
+/// in a custom way.
+///
+/// The layout must be updated when the string or its parameters
+/// change. sf::Text keeps its own layout up to date, see
+/// sf::Text::getLayout.
+///
+/// Usage example:
+/// \code
+/// sf::Text text("Hello\nworld", font, 20);
+/// const sf::TextLayout& layout = text.getLayout();
+///
+/// // Place the caret under the mouse
+/// sf::Vector2f mouse = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+/// std::size_t caret = layout.hitTest(text.getInverseTransform().transformPoint(mouse));
+///
+/// sf::RectangleShape cursor(sf::Vector2f(1, font.getLineSpacing(20)));
+/// cursor.setPosition(text.getTransform().transformPoint(layout.getCaretPosition(caret)));
+/// \endcode
+///
+/// \see sf::Text, sf::Font
+///
+////////////////////////////////////////////////////////////
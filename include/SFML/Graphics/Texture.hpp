@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <vector>
 
 
 namespace sf
@@ -41,6 +42,11 @@ class RenderTexture;
 class Text;
 class Window;
 
+namespace priv
+{
+    struct CompressedImage;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Image living on the graphics card that can be used for drawing
 ///
@@ -59,6 +65,36 @@ public:
         Pixels      ///< Texture coordinates in range [0 .. size]
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Formats of the pixels stored by the graphics card
+    ///
+    /// \see getFormat, loadFromCompressedFile, isFormatSupported
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Rgba8,     ///< Uncompressed 8-bit RGBA pixels (32 bits per pixel)
+        Bc1,       ///< BC1 (DXT1) blocks: RGB with 1-bit alpha (4 bits per pixel)
+        Bc2,       ///< BC2 (DXT3) blocks: RGB with explicit 4-bit alpha (8 bits per pixel)
+        Bc3,       ///< BC3 (DXT5) blocks: RGB with interpolated alpha (8 bits per pixel)
+        Etc2Rgb,   ///< ETC2 RGB blocks, which include ETC1 (4 bits per pixel)
+        Etc2Rgba,  ///< ETC2 RGB blocks with EAC alpha (8 bits per pixel)
+        Astc4x4,   ///< ASTC LDR blocks of 4x4 pixels (8 bits per pixel)
+        Astc5x4,   ///< ASTC LDR blocks of 5x4 pixels (6.4 bits per pixel)
+        Astc5x5,   ///< ASTC LDR blocks of 5x5 pixels (5.12 bits per pixel)
+        Astc6x5,   ///< ASTC LDR blocks of 6x5 pixels (4.27 bits per pixel)
+        Astc6x6,   ///< ASTC LDR blocks of 6x6 pixels (3.56 bits per pixel)
+        Astc8x5,   ///< ASTC LDR blocks of 8x5 pixels (3.2 bits per pixel)
+        Astc8x6,   ///< ASTC LDR blocks of 8x6 pixels (2.67 bits per pixel)
+        Astc8x8,   ///< ASTC LDR blocks of 8x8 pixels (2 bits per pixel)
+        Astc10x5,  ///< ASTC LDR blocks of 10x5 pixels (2.56 bits per pixel)
+        Astc10x6,  ///< ASTC LDR blocks of 10x6 pixels (2.13 bits per pixel)
+        Astc10x8,  ///< ASTC LDR blocks of 10x8 pixels (1.6 bits per pixel)
+        Astc10x10, ///< ASTC LDR blocks of 10x10 pixels (1.28 bits per pixel)
+        Astc12x10, ///< ASTC LDR blocks of 12x10 pixels (1.07 bits per pixel)
+        Astc12x12  ///< ASTC LDR blocks of 12x12 pixels (0.89 bits per pixel)
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -214,6 +250,97 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromImage(const Image& image, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from an image and its mipmap levels
+    ///
+    /// The levels are uploaded as they are, instead of being
+    /// generated by the graphics driver: they can be computed
+    /// with a better filter, offline or on a thread, and don't
+    /// require the OpenGL extension that generateMipmap needs.
+    ///
+    /// \a mipmaps must contain the complete chain below \a image,
+    /// as computed by Image::generateMipChain: each level halves
+    /// the size of the previous one (rounding down, and never
+    /// going below 1), and the last level has a size of 1x1.
+    /// Since the levels must match the texture exactly, this
+    /// function fails if the graphics driver only supports
+    /// textures with power of two sizes and \a image doesn't
+    /// have one.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param image   Image to load into the texture
+    /// \param mipmaps Mipmap levels of the image
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see Image::generateMipChain, generateMipmap
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const Image& image, const std::vector<Image>& mipmaps);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a compressed image file
+    ///
+    /// KTX (version 1) and DDS files are supported, holding a
+    /// 2D image in one of the compressed formats of Format.
+    /// When the graphics driver supports the format, the blocks
+    /// are uploaded as they are: the texture then uses a fraction
+    /// of the memory and bandwidth of an uncompressed one, and
+    /// loading skips the decoding of the pixels. The mipmap levels
+    /// stored in the file are uploaded too, if they form a complete
+    /// chain down to 1x1.
+    ///
+    /// When the format is not supported, BC and ETC2 images are
+    /// decompressed and loaded as regular RGBA textures, so that
+    /// the same file can be used everywhere. ASTC images can't be
+    /// decompressed, loading them fails on drivers that don't
+    /// support them.
+    ///
+    /// Compressed textures can't be modified: the update functions
+    /// and generateMipmap have no effect on them. The setSrgb
+    /// setting applies to them like to uncompressed textures.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param filename Path of the compressed image file to load
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedMemory, loadFromCompressedStream, getFormat, isFormatSupported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a compressed image file in memory
+    ///
+    /// See loadFromCompressedFile for details.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedFile, loadFromCompressedStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a compressed image file in a custom stream
+    ///
+    /// See loadFromCompressedFile for details.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedFile, loadFromCompressedMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedStream(InputStream& stream);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
     ///
@@ -222,6 +349,20 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the format of the pixels stored by the graphics card
+    ///
+    /// The format is Rgba8, unless the texture was loaded
+    /// from a compressed image file whose format is supported
+    /// by the graphics driver.
+    ///
+    /// \return Format of the texture
+    ///
+    /// \see loadFromCompressedFile
+    ///
+    ////////////////////////////////////////////////////////////
+    Format getFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the texture pixels to an image
     ///
@@ -277,6 +418,30 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update several parts of the texture at once
+    ///
+    /// \a pixels contains the 32-bits RGBA pixels of each area,
+    /// one after the other, in the order of \a rects. All the
+    /// areas are uploaded with a single texture binding and a
+    /// single flush, which is much cheaper than calling update
+    /// once per area when there are many small ones (like
+    /// glyphs or sprite frames).
+    ///
+    /// No additional check is performed on the size of the pixel
+    /// array or the bounds of the areas to update, passing invalid
+    /// arguments will lead to an undefined behavior.
+    ///
+    /// This function does nothing if \a pixels is null or if the
+    /// texture was not previously created.
+    ///
+    /// \param pixels Array of pixels to copy to the texture
+    /// \param rects  Areas of the texture to update
+    /// \param count  Number of areas in \a rects
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* pixels, const IntRect* rects, std::size_t count);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update a part of this texture from another texture
     ///
@@ -497,8 +662,10 @@ public:
     /// can also improve rendering performance in certain scenarios.
     ///
     /// Mipmap generation relies on the necessary OpenGL extension being
-    /// available. If it is unavailable or generation fails due to another
-    /// reason, this function will return false. Mipmap data is only valid from
+    /// available. If it is unavailable, the texture is downloaded and its
+    /// levels are computed on the CPU, which is slower and requires the
+    /// texture not to be padded to a power of two size. If generation
+    /// fails, this function will return false. Mipmap data is only valid from
     /// the time it is generated until the next time the base level image is
     /// modified, at which point this function will have to be called again to
     /// regenerate it.
@@ -583,9 +750,26 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the graphics driver supports a texture format
+    ///
+    /// Rgba8 is always supported. Images in compressed formats
+    /// that are not supported are decompressed when loaded,
+    /// except for ASTC images.
+    ///
+    /// \param format Format to check
+    ///
+    /// \return True if textures can be stored in this format
+    ///
+    /// \see loadFromCompressedFile
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isFormatSupported(Format format);
+
 private:
 
     friend class Text;
+    friend class TextBatch;
     friend class RenderTexture;
     friend class RenderTarget;
 
@@ -613,6 +797,27 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the levels of the mipmap below the base level
+    ///
+    /// The levels must match the actual size of the texture.
+    /// This also sets the texture's minifying function.
+    ///
+    /// \param levels Mipmap levels, starting with level 1
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadMipmap(const std::vector<Image>& levels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from parsed compressed image data
+    ///
+    /// \param image Compressed image to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedImage(const priv::CompressedImage& image);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -625,6 +830,7 @@ private:
     mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
     bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
     bool         m_hasMipmap;     ///< Has the mipmap been generated?
+    Format       m_format;        ///< Format of the pixels stored by the graphics card
     Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
 };
 
@@ -106,9 +106,9 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Clear the vertex array
     ///
-    /// This function removes all the vertices from the array.
-    /// It doesn't deallocate the corresponding memory, so that
-    /// adding new vertices after clearing doesn't involve
+    /// This function removes all the vertices and indices from
+    /// the array. It doesn't deallocate the corresponding memory,
+    /// so that adding new vertices after clearing doesn't involve
     /// reallocating all the memory.
     ///
     ////////////////////////////////////////////////////////////
@@ -136,6 +136,64 @@ public:
     ////////////////////////////////////////////////////////////
     void append(const Vertex& vertex);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the index count
+    ///
+    /// \return Number of indices in the array, 0 if the vertices
+    ///         are drawn in order
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIndexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-write access to the indices
+    ///
+    /// \return Pointer to the indices, or null if there are none
+    ///
+    /// \see getIndexCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32* getIndices();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only access to the indices
+    ///
+    /// \return Pointer to the indices, or null if there are none
+    ///
+    /// \see getIndexCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint32* getIndices() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the indices from the array
+    ///
+    /// The vertices are then drawn in order again.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearIndices();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the index list
+    ///
+    /// New indices are set to 0.
+    ///
+    /// \param indexCount New number of indices
+    ///
+    ////////////////////////////////////////////////////////////
+    void resizeIndices(std::size_t indexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an index to the array
+    ///
+    /// As soon as the array has indices, only the vertices
+    /// they reference are drawn, in the order of the indices.
+    ///
+    /// \param index Index of the vertex to add to the primitives
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendIndex(Uint32 index);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the type of primitives to draw
     ///
@@ -188,6 +246,7 @@ private:
     // Member data
     ////////////////////////////////////////////////////////////
     std::vector<Vertex> m_vertices;      ///< Vertices contained in the array
+    std::vector<Uint32> m_indices;       ///< Order in which the vertices are drawn, empty to draw them in order
     PrimitiveType       m_primitiveType; ///< Type of primitives to draw
 };
 
@@ -218,6 +277,18 @@ private:
 /// window.draw(lines);
 /// \endcode
 ///
-/// \see sf::Vertex
+/// A vertex array can also carry a list of indices, so that
+/// vertices shared by several primitives are stored only once:
+/// \code
+/// sf::VertexArray quad(sf::Triangles, 4);
+/// ...
+/// sf::Uint32 indices[6] = {0, 1, 2, 0, 2, 3};
+/// for (int i = 0; i < 6; ++i)
+///     quad.appendIndex(indices[i]);
+///
+/// window.draw(quad);
+/// \endcode
+///
+/// \see sf::Vertex, sf::IndexBuffer
 ///
 ////////////////////////////////////////////////////////////
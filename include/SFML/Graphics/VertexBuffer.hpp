@@ -331,6 +331,8 @@ private:
 
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -338,6 +340,7 @@ private:
     std::size_t   m_size;          ///< Size in Vertexes of the currently allocated buffer
     PrimitiveType m_primitiveType; ///< Type of primitives to draw
     Usage         m_usage;         ///< How this vertex buffer is to be used
+    Uint64        m_cacheId;       ///< Unique number that identifies the contents of the buffer
 };
 
 } // namespace sf
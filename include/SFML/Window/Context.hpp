@@ -132,6 +132,20 @@ public:
     ////////////////////////////////////////////////////////////
     static Uint64 getActiveContextId();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of the current activation of the active context
+    ///
+    /// A new number is assigned every time a context is made
+    /// active on a thread. It can be used to detect that state
+    /// cached while a context was active may be stale, because
+    /// the context was released in the meantime (and possibly
+    /// used by another thread) before being activated again.
+    ///
+    /// \return The activation number or 0 if no context is currently active
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActivationId();
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
@@ -251,6 +251,18 @@ public:
     ////////////////////////////////////////////////////////////
     void display();
 
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window is displayed
+    ///
+    /// This function is called at the beginning of display(), so
+    /// that derived classes can complete their rendering before
+    /// the contents of the window are presented.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AssetLoader.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Size of the strips of pixels uploaded at once, in bytes
+    const std::size_t uploadStripSize = 1024 * 1024;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AssetLoader::AssetLoader(unsigned int threadCount) :
+m_assets      (),
+m_queue       (),
+m_uploads     (),
+m_workers     (),
+m_pendingCount(0),
+m_cancelled   (false),
+m_mutex       ()
+{
+    // Make sure that the image loader exists before the workers use it
+    priv::ImageLoader::getInstance();
+
+    for (unsigned int i = 0; i < std::max(threadCount, 1u); ++i)
+    {
+        Worker* worker = new Worker;
+        worker->loader  = this;
+        worker->thread  = new Thread(&AssetLoader::decode, worker);
+        worker->running = false;
+        m_workers.push_back(worker);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::~AssetLoader()
+{
+    // Abandon the files not decoded yet
+    {
+        Lock lock(m_mutex);
+        m_cancelled = true;
+        m_queue.clear();
+    }
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->thread->wait();
+        delete (*it)->thread;
+        delete *it;
+    }
+
+    for (std::deque<Asset>::iterator it = m_assets.begin(); it != m_assets.end(); ++it)
+        delete it->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetLoader::loadImage(const std::string& filename)
+{
+    return load(filename, false);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetLoader::loadTexture(const std::string& filename)
+{
+    return load(filename, true);
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetLoader::uploadTextures(Time budget)
+{
+    Clock clock;
+
+    for (;;)
+    {
+        Asset* asset = NULL;
+        {
+            Lock lock(m_mutex);
+            if (m_uploads.empty())
+                return m_pendingCount == 0;
+
+            asset = m_uploads.front();
+        }
+
+        Vector2u size = asset->image.getSize();
+
+        // Create the texture before uploading the first strip; it is only
+        // allocated here, so that image assets never need an OpenGL context
+        if (!asset->texture)
+            asset->texture = new Texture;
+
+        if ((asset->uploadedRows == 0) && !asset->texture->create(size.x, size.y))
+        {
+            Lock lock(m_mutex);
+            m_uploads.pop_front();
+            finish(*asset, Error);
+            continue;
+        }
+
+        // Upload the next strip of rows
+        std::size_t rowSize = static_cast<std::size_t>(size.x) * 4;
+        unsigned int rows = static_cast<unsigned int>(std::max<std::size_t>(uploadStripSize / rowSize, 1));
+        rows = std::min(rows, size.y - asset->uploadedRows);
+
+        asset->texture->update(asset->image.getPixelsPtr() + asset->uploadedRows * rowSize, size.x, rows, 0, asset->uploadedRows);
+        asset->uploadedRows += rows;
+
+        if (asset->uploadedRows == size.y)
+        {
+            Lock lock(m_mutex);
+            m_uploads.pop_front();
+            finish(*asset, Done);
+        }
+
+        if (clock.getElapsedTime() >= budget)
+        {
+            Lock lock(m_mutex);
+            return m_pendingCount == 0;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetLoader::wait()
+{
+    // The workers stop when there is nothing left to decode
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        (*it)->thread->wait();
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Status AssetLoader::getStatus(std::size_t asset) const
+{
+    Lock lock(m_mutex);
+
+    switch (m_assets[asset].state)
+    {
+        case Done:  return Ready;
+        case Error: return Failed;
+        default:    return Pending;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetLoader::getPendingCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_pendingCount;
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& AssetLoader::getImage(std::size_t asset) const
+{
+    static const Image empty;
+
+    // The image is written by the workers until the asset is decoded
+    return (getStatus(asset) == Ready) ? m_assets[asset].image : empty;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& AssetLoader::getTexture(std::size_t asset) const
+{
+    static const Texture empty;
+
+    // The texture is created by uploadTextures, which is called by this thread
+    const Texture* texture = m_assets[asset].texture;
+    return texture ? *texture : empty;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetLoader::load(const std::string& filename, bool isTexture)
+{
+    Worker* idleWorker = NULL;
+    std::size_t index;
+
+    {
+        Lock lock(m_mutex);
+
+        // The assets are only added by this thread, the workers access them through the queue
+        index = m_assets.size();
+        m_assets.push_back(Asset());
+        m_assets.back().filename = filename;
+        m_assets.back().isTexture = isTexture;
+        m_queue.push_back(&m_assets.back());
+        m_pendingCount++;
+
+        // Start another worker if there is one available
+        for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        {
+            if (!(*it)->running)
+            {
+                idleWorker = *it;
+                idleWorker->running = true;
+                break;
+            }
+        }
+    }
+
+    // The thread of an idle worker has finished or is about to, so launching it again doesn't block
+    if (idleWorker)
+        idleWorker->thread->launch();
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetLoader::decode(Worker* worker)
+{
+    AssetLoader& loader = *worker->loader;
+
+    for (;;)
+    {
+        Asset* asset = NULL;
+        {
+            Lock lock(loader.m_mutex);
+            if (loader.m_cancelled || loader.m_queue.empty())
+            {
+                worker->running = false;
+                return;
+            }
+
+            asset = loader.m_queue.front();
+            loader.m_queue.pop_front();
+            asset->state = Decoding;
+        }
+
+        // Decode the file into the image of the asset, which no other thread uses meanwhile
+        bool decoded = asset->image.loadFromFile(asset->filename);
+
+        Lock lock(loader.m_mutex);
+        if (!decoded)
+        {
+            loader.finish(*asset, Error);
+        }
+        else if (asset->isTexture)
+        {
+            asset->state = Decoded;
+            loader.m_uploads.push_back(asset);
+        }
+        else
+        {
+            loader.finish(*asset, Done);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetLoader::finish(Asset& asset, State state)
+{
+    asset.state = state;
+    m_pendingCount--;
+
+    // The pixels of textures are not needed anymore once uploaded
+    if (asset.isTexture)
+        asset.image = Image();
+}
+
+
+////////////////////////////////////////////////////////////
+AssetLoader::Asset::Asset() :
+filename    (),
+isTexture   (false),
+state       (Queued),
+image       (),
+texture     (NULL),
+uploadedRows(0)
+{
+}
+
+} // namespace sf
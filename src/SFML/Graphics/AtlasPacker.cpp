@@ -0,0 +1,424 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AtlasPacker.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+AtlasPacker* AtlasPacker::create(Algorithm algorithm, unsigned int width, unsigned int height)
+{
+    switch (algorithm)
+    {
+        case MaxRects: return new MaxRectsPacker(width, height);
+        default:
+        case Skyline:  return new SkylinePacker(width, height);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+AtlasPacker::AtlasPacker(Algorithm algorithm, unsigned int width, unsigned int height) :
+m_algorithm(algorithm),
+m_width    (width),
+m_height   (height),
+m_usedArea (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+AtlasPacker::~AtlasPacker()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool AtlasPacker::insert(unsigned int width, unsigned int height, IntRect& rect)
+{
+    if ((width == 0) || (height == 0) || (width > m_width) || (height > m_height))
+        return false;
+
+    if (!onInsert(width, height, rect))
+        return false;
+
+    m_usedArea += static_cast<Uint64>(width) * height;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void AtlasPacker::grow(unsigned int width, unsigned int height)
+{
+    width  = std::max(width, m_width);
+    height = std::max(height, m_height);
+
+    onGrow(width, height);
+
+    m_width  = width;
+    m_height = height;
+}
+
+
+////////////////////////////////////////////////////////////
+void AtlasPacker::reset(unsigned int width, unsigned int height)
+{
+    m_width    = width;
+    m_height   = height;
+    m_usedArea = 0;
+
+    onReset();
+}
+
+
+////////////////////////////////////////////////////////////
+AtlasPacker::Algorithm AtlasPacker::getAlgorithm() const
+{
+    return m_algorithm;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 AtlasPacker::getUsedArea() const
+{
+    return m_usedArea;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 AtlasPacker::getArea() const
+{
+    return static_cast<Uint64>(m_width) * m_height;
+}
+
+
+////////////////////////////////////////////////////////////
+SkylinePacker::SkylinePacker(unsigned int width, unsigned int height) :
+AtlasPacker(Skyline, width, height)
+{
+    onReset();
+}
+
+
+////////////////////////////////////////////////////////////
+AtlasPacker* SkylinePacker::clone() const
+{
+    return new SkylinePacker(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::onInsert(unsigned int width, unsigned int height, IntRect& rect)
+{
+    // Find the position that keeps the skyline the lowest; on ties,
+    // prefer the narrowest segment so that wide ones stay available
+    std::size_t  bestIndex = m_nodes.size();
+    unsigned int bestTop   = 0;
+    unsigned int bestWidth = 0;
+    unsigned int bestY     = 0;
+    for (std::size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        unsigned int y;
+        if (!fits(i, width, height, y))
+            continue;
+
+        unsigned int top = y + height;
+        if ((bestIndex == m_nodes.size()) || (top < bestTop) || ((top == bestTop) && (m_nodes[i].width < bestWidth)))
+        {
+            bestIndex = i;
+            bestTop   = top;
+            bestWidth = m_nodes[i].width;
+            bestY     = y;
+        }
+    }
+
+    if (bestIndex == m_nodes.size())
+        return false;
+
+    rect = IntRect(m_nodes[bestIndex].x, bestY, width, height);
+
+    // Insert the new segment, then cut the ones that are now below it
+    m_nodes.insert(m_nodes.begin() + bestIndex, Node(rect.left, bestTop, width));
+    for (std::size_t i = bestIndex + 1; i < m_nodes.size(); )
+    {
+        const Node& previous = m_nodes[i - 1];
+        unsigned int previousEnd = previous.x + previous.width;
+        if (m_nodes[i].x >= previousEnd)
+            break;
+
+        unsigned int shrink = previousEnd - m_nodes[i].x;
+        if (m_nodes[i].width <= shrink)
+        {
+            m_nodes.erase(m_nodes.begin() + i);
+        }
+        else
+        {
+            m_nodes[i].x     += shrink;
+            m_nodes[i].width -= shrink;
+            break;
+        }
+    }
+
+    // Merge neighbour segments that are at the same height
+    for (std::size_t i = 0; i + 1 < m_nodes.size(); )
+    {
+        if (m_nodes[i].y == m_nodes[i + 1].y)
+        {
+            m_nodes[i].width += m_nodes[i + 1].width;
+            m_nodes.erase(m_nodes.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::onGrow(unsigned int width, unsigned int)
+{
+    // A taller atlas only moves the ceiling; a wider one adds
+    // an empty segment at the right of the skyline
+    if (width > m_width)
+    {
+        if (!m_nodes.empty() && (m_nodes.back().y == 0))
+            m_nodes.back().width += width - m_width;
+        else
+            m_nodes.push_back(Node(m_width, 0, width - m_width));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::onReset()
+{
+    m_nodes.clear();
+    m_nodes.push_back(Node(0, 0, m_width));
+}
+
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::fits(std::size_t index, unsigned int width, unsigned int height, unsigned int& y) const
+{
+    if (m_nodes[index].x + width > m_width)
+        return false;
+
+    // The rectangle rests on the highest segment it spans
+    y = 0;
+    unsigned int remaining = width;
+    for (std::size_t i = index; remaining > 0; ++i)
+    {
+        if (i == m_nodes.size())
+            return false;
+
+        y = std::max(y, m_nodes[i].y);
+        if (y + height > m_height)
+            return false;
+
+        remaining -= std::min(remaining, m_nodes[i].width);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+MaxRectsPacker::MaxRectsPacker(unsigned int width, unsigned int height) :
+AtlasPacker(MaxRects, width, height)
+{
+    onReset();
+}
+
+
+////////////////////////////////////////////////////////////
+AtlasPacker* MaxRectsPacker::clone() const
+{
+    return new MaxRectsPacker(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+bool MaxRectsPacker::onInsert(unsigned int width, unsigned int height, IntRect& rect)
+{
+    const int w = static_cast<int>(width);
+    const int h = static_cast<int>(height);
+
+    // Best short side fit: choose the free rectangle that leaves
+    // the smallest leftover on its shortest side
+    std::size_t bestIndex     = m_free.size();
+    int         bestShortSide = 0;
+    int         bestLongSide  = 0;
+    for (std::size_t i = 0; i < m_free.size(); ++i)
+    {
+        const IntRect& free = m_free[i];
+        if ((free.width < w) || (free.height < h))
+            continue;
+
+        int leftoverX = free.width - w;
+        int leftoverY = free.height - h;
+        int shortSide = std::min(leftoverX, leftoverY);
+        int longSide  = std::max(leftoverX, leftoverY);
+        if ((bestIndex == m_free.size()) || (shortSide < bestShortSide) || ((shortSide == bestShortSide) && (longSide < bestLongSide)))
+        {
+            bestIndex     = i;
+            bestShortSide = shortSide;
+            bestLongSide  = longSide;
+        }
+    }
+
+    if (bestIndex == m_free.size())
+        return false;
+
+    rect = IntRect(m_free[bestIndex].left, m_free[bestIndex].top, w, h);
+
+    // Split every free rectangle that overlaps the new one into
+    // the (up to four) maximal rectangles that surround it
+    std::vector<IntRect> split;
+    for (std::size_t i = 0; i < m_free.size(); )
+    {
+        IntRect free = m_free[i];
+        if (!free.intersects(rect))
+        {
+            ++i;
+            continue;
+        }
+
+        if (rect.left > free.left)
+            split.push_back(IntRect(free.left, free.top, rect.left - free.left, free.height));
+        if (rect.left + rect.width < free.left + free.width)
+            split.push_back(IntRect(rect.left + rect.width, free.top, free.left + free.width - rect.left - rect.width, free.height));
+        if (rect.top > free.top)
+            split.push_back(IntRect(free.left, free.top, free.width, rect.top - free.top));
+        if (rect.top + rect.height < free.top + free.height)
+            split.push_back(IntRect(free.left, rect.top + rect.height, free.width, free.top + free.height - rect.top - rect.height));
+
+        m_free[i] = m_free.back();
+        m_free.pop_back();
+    }
+
+    // The pieces are subsets of former free rectangles, so they can't contain
+    // any of the remaining ones: only the pieces need to be pruned
+    std::size_t first = m_free.size();
+    m_free.insert(m_free.end(), split.begin(), split.end());
+    for (std::size_t i = first; i < m_free.size(); )
+    {
+        bool contained = false;
+        for (std::size_t j = 0; (j < m_free.size()) && !contained; ++j)
+            contained = (j != i) && contains(m_free[j], m_free[i]);
+
+        if (contained)
+            m_free.erase(m_free.begin() + i);
+        else
+            ++i;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void MaxRectsPacker::onGrow(unsigned int width, unsigned int height)
+{
+    const int oldWidth  = static_cast<int>(m_width);
+    const int oldHeight = static_cast<int>(m_height);
+    const int newWidth  = static_cast<int>(width);
+    const int newHeight = static_cast<int>(height);
+
+    // Free rectangles touching the old borders extend into the new space
+    for (std::size_t i = 0; i < m_free.size(); ++i)
+    {
+        IntRect& free = m_free[i];
+        if (free.left + free.width == oldWidth)
+            free.width = newWidth - free.left;
+        if (free.top + free.height == oldHeight)
+            free.height = newHeight - free.top;
+    }
+
+    // The new strips are entirely free
+    if (newWidth > oldWidth)
+        m_free.push_back(IntRect(oldWidth, 0, newWidth - oldWidth, newHeight));
+    if (newHeight > oldHeight)
+        m_free.push_back(IntRect(0, oldHeight, newWidth, newHeight - oldHeight));
+
+    prune();
+}
+
+
+////////////////////////////////////////////////////////////
+void MaxRectsPacker::onReset()
+{
+    m_free.clear();
+    m_free.push_back(IntRect(0, 0, m_width, m_height));
+}
+
+
+////////////////////////////////////////////////////////////
+void MaxRectsPacker::prune()
+{
+    for (std::size_t i = 0; i < m_free.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < m_free.size(); )
+        {
+            if (contains(m_free[i], m_free[j]))
+            {
+                m_free.erase(m_free.begin() + j);
+            }
+            else if (contains(m_free[j], m_free[i]))
+            {
+                // Keep the larger one in place of i and restart its comparisons
+                m_free[i] = m_free[j];
+                m_free.erase(m_free.begin() + j);
+                j = i + 1;
+            }
+            else
+            {
+                ++j;
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool MaxRectsPacker::contains(const IntRect& outer, const IntRect& inner)
+{
+    return (inner.left >= outer.left) && (inner.top >= outer.top) &&
+           (inner.left + inner.width <= outer.left + outer.width) &&
+           (inner.top + inner.height <= outer.top + outer.height);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ATLASPACKER_HPP
+#define SFML_ATLASPACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract rectangle packer used to allocate space
+///        for glyphs (or any other sub-image) in an atlas
+///
+////////////////////////////////////////////////////////////
+class AtlasPacker
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Packing algorithms
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Algorithm
+    {
+        Skyline, ///< Bottom-left skyline: fast, good occupancy for similar heights
+        MaxRects ///< Maximal rectangles, best short side fit: densest, slower
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a packer using the given algorithm
+    ///
+    /// \param algorithm Packing algorithm to use
+    /// \param width     Initial width of the atlas
+    /// \param height    Initial height of the atlas
+    ///
+    /// \return New packer, to be deleted by the caller
+    ///
+    ////////////////////////////////////////////////////////////
+    static AtlasPacker* create(Algorithm algorithm, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~AtlasPacker();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a copy of the packer, including its state
+    ///
+    /// \return New packer, to be deleted by the caller
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual AtlasPacker* clone() const = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find room for a rectangle and reserve it
+    ///
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param rect   Receives the allocated rectangle on success
+    ///
+    /// \return True if the rectangle was allocated, false if the atlas is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool insert(unsigned int width, unsigned int height, IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enlarge the atlas, keeping all the allocated rectangles
+    ///
+    /// The new size must not be smaller than the current one.
+    ///
+    /// \param width  New width of the atlas
+    /// \param height New height of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    void grow(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release all the allocated rectangles
+    ///
+    /// \param width  New width of the atlas
+    /// \param height New height of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the algorithm used by the packer
+    ///
+    /// \return Packing algorithm
+    ///
+    ////////////////////////////////////////////////////////////
+    Algorithm getAlgorithm() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total area of the allocated rectangles
+    ///
+    /// \return Used area, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getUsedArea() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total area of the atlas
+    ///
+    /// \return Atlas area, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getArea() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// \param algorithm Algorithm implemented by the derived class
+    /// \param width     Initial width of the atlas
+    /// \param height    Initial height of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    AtlasPacker(Algorithm algorithm, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Algorithm-specific allocation
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onInsert(unsigned int width, unsigned int height, IntRect& rect) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Algorithm-specific handling of a size increase
+    ///
+    /// m_width and m_height still contain the old size when
+    /// this function is called.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onGrow(unsigned int width, unsigned int height) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Algorithm-specific reset
+    ///
+    /// m_width and m_height already contain the new size when
+    /// this function is called.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onReset() = 0;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Algorithm    m_algorithm; ///< Algorithm implemented by the packer
+    unsigned int m_width;     ///< Current width of the atlas
+    unsigned int m_height;    ///< Current height of the atlas
+    Uint64       m_usedArea;  ///< Sum of the areas of the allocated rectangles
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Bottom-left skyline packer
+///
+/// The free space is described by the "skyline" formed by the
+/// top edges of the allocated rectangles; new rectangles are
+/// placed where they raise the skyline the least. Unlike a
+/// shelf allocator, it doesn't waste the space above short
+/// rectangles placed next to tall ones.
+///
+////////////////////////////////////////////////////////////
+class SkylinePacker : public AtlasPacker
+{
+public:
+
+    SkylinePacker(unsigned int width, unsigned int height);
+
+    virtual AtlasPacker* clone() const;
+
+protected:
+
+    virtual bool onInsert(unsigned int width, unsigned int height, IntRect& rect);
+
+    virtual void onGrow(unsigned int width, unsigned int height);
+
+    virtual void onReset();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Horizontal segment of the skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Node
+    {
+        Node(unsigned int nodeX, unsigned int nodeY, unsigned int nodeWidth) : x(nodeX), y(nodeY), width(nodeWidth) {}
+
+        unsigned int x;     ///< Left of the segment
+        unsigned int y;     ///< Height of the skyline along the segment
+        unsigned int width; ///< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a rectangle fits with its left edge at the given node
+    ///
+    /// \return True if it fits, with the resulting top in \a y
+    ///
+    ////////////////////////////////////////////////////////////
+    bool fits(std::size_t index, unsigned int width, unsigned int height, unsigned int& y) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Node> m_nodes; ///< Segments of the skyline, from left to right
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Maximal rectangles packer (best short side fit)
+///
+/// The free space is tracked as the list of all the maximal
+/// free rectangles, which gives the best occupancy for
+/// rectangles of very different shapes at the price of a
+/// higher insertion cost.
+///
+////////////////////////////////////////////////////////////
+class MaxRectsPacker : public AtlasPacker
+{
+public:
+
+    MaxRectsPacker(unsigned int width, unsigned int height);
+
+    virtual AtlasPacker* clone() const;
+
+protected:
+
+    virtual bool onInsert(unsigned int width, unsigned int height, IntRect& rect);
+
+    virtual void onGrow(unsigned int width, unsigned int height);
+
+    virtual void onReset();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the free rectangles contained in other ones
+    ///
+    ////////////////////////////////////////////////////////////
+    void prune();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a rectangle is entirely inside another one
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool contains(const IntRect& outer, const IntRect& inner);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<IntRect> m_free; ///< Maximal free rectangles
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_ATLASPACKER_HPP
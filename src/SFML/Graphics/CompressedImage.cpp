@@ -0,0 +1,676 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Identifiers at the beginning of the supported files
+    const sf::Uint8 ktxIdentifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+    const sf::Uint8 ddsIdentifier[4]  = {'D', 'D', 'S', ' '};
+
+    // Size of the headers, identifiers included
+    const std::size_t ktxHeaderSize  = 64;
+    const std::size_t ddsHeaderSize  = 128;
+    const std::size_t dx10HeaderSize = 20;
+
+    // Size in pixels of the ASTC blocks, in the order of sf::Texture::Format
+    const unsigned int astcBlockSizes[14][2] =
+    {
+        {4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6}, {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12}
+    };
+
+    // Read a little endian 32-bit value
+    sf::Uint32 readUint32(const sf::Uint8* bytes)
+    {
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<sf::Uint32>(bytes[3]) << 24);
+    }
+
+    // Reverse the byte order of a 32-bit value
+    sf::Uint32 swapBytes(sf::Uint32 value)
+    {
+        return (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+    }
+
+    // Size in pixels of the blocks of a format
+    sf::Vector2u getBlockSize(sf::Texture::Format format)
+    {
+        if (format >= sf::Texture::Astc4x4)
+            return sf::Vector2u(astcBlockSizes[format - sf::Texture::Astc4x4][0], astcBlockSizes[format - sf::Texture::Astc4x4][1]);
+        else
+            return sf::Vector2u(4, 4);
+    }
+
+    // Size in bytes of the blocks of a format
+    std::size_t getBlockByteCount(sf::Texture::Format format)
+    {
+        return ((format == sf::Texture::Bc1) || (format == sf::Texture::Etc2Rgb)) ? 8 : 16;
+    }
+
+    // Find the format of an OpenGL internal format, as stored in KTX files
+    bool getFormatFromGl(sf::Uint32 internalFormat, sf::Texture::Format& format, bool& opaque)
+    {
+        // Only the RGB variants of DXT1 draw the fourth color of three-color blocks as opaque black
+        opaque = (internalFormat == 0x83F0) || (internalFormat == 0x8C4C);
+
+        switch (internalFormat)
+        {
+            case 0x83F0: // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+            case 0x83F1: // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+            case 0x8C4C: // GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+            case 0x8C4D: // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+                format = sf::Texture::Bc1;
+                return true;
+
+            case 0x83F2: // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+            case 0x8C4E: // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT
+                format = sf::Texture::Bc2;
+                return true;
+
+            case 0x83F3: // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+            case 0x8C4F: // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+                format = sf::Texture::Bc3;
+                return true;
+
+            case 0x8D64: // GL_ETC1_RGB8_OES
+            case 0x9274: // GL_COMPRESSED_RGB8_ETC2
+            case 0x9275: // GL_COMPRESSED_SRGB8_ETC2
+                format = sf::Texture::Etc2Rgb;
+                return true;
+
+            case 0x9278: // GL_COMPRESSED_RGBA8_ETC2_EAC
+            case 0x9279: // GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+                format = sf::Texture::Etc2Rgba;
+                return true;
+
+            default:
+                break;
+        }
+
+        // GL_COMPRESSED_RGBA_ASTC_*_KHR and GL_COMPRESSED_SRGB8_ALPHA8_ASTC_*_KHR
+        if (((internalFormat >= 0x93B0) && (internalFormat <= 0x93BD)) || ((internalFormat >= 0x93D0) && (internalFormat <= 0x93DD)))
+        {
+            format = static_cast<sf::Texture::Format>(sf::Texture::Astc4x4 + (internalFormat & 0xF));
+            return true;
+        }
+
+        return false;
+    }
+
+    // Find the format of a DDS file, from its FourCC code or DXGI format
+    bool getFormatFromDds(const sf::Uint8* fourCC, sf::Uint32 dxgiFormat, sf::Texture::Format& format)
+    {
+        if (std::memcmp(fourCC, "DX10", 4) == 0)
+        {
+            switch (dxgiFormat)
+            {
+                case 71: case 72: format = sf::Texture::Bc1; return true; // DXGI_FORMAT_BC1_UNORM(_SRGB)
+                case 74: case 75: format = sf::Texture::Bc2; return true; // DXGI_FORMAT_BC2_UNORM(_SRGB)
+                case 77: case 78: format = sf::Texture::Bc3; return true; // DXGI_FORMAT_BC3_UNORM(_SRGB)
+                default:          return false;
+            }
+        }
+
+        if (std::memcmp(fourCC, "DXT1", 4) == 0) {format = sf::Texture::Bc1; return true;}
+        if (std::memcmp(fourCC, "DXT3", 4) == 0) {format = sf::Texture::Bc2; return true;}
+        if (std::memcmp(fourCC, "DXT5", 4) == 0) {format = sf::Texture::Bc3; return true;}
+
+        return false;
+    }
+
+    // Size in bytes of a level of a given size
+    std::size_t getLevelByteCount(sf::Texture::Format format, const sf::Vector2u& size)
+    {
+        sf::Vector2u blockSize = getBlockSize(format);
+        std::size_t  columns   = (size.x + blockSize.x - 1) / blockSize.x;
+        std::size_t  rows      = (size.y + blockSize.y - 1) / blockSize.y;
+        return columns * rows * getBlockByteCount(format);
+    }
+
+    // Read the levels of a KTX 1.1 file, stopping at the first incomplete one
+    bool parseKtx(const sf::Uint8* bytes, std::size_t size, sf::priv::CompressedImage& image)
+    {
+        if (size < ktxHeaderSize)
+        {
+            sf::err() << "Failed to load compressed image, truncated KTX header" << std::endl;
+            return false;
+        }
+
+        // Read the header, whose values may have the opposite endianness
+        sf::Uint32 header[13];
+        for (int i = 0; i < 13; ++i)
+            header[i] = readUint32(bytes + 12 + i * 4);
+
+        bool swapped = (header[0] == 0x01020304);
+        if (swapped)
+        {
+            for (int i = 0; i < 13; ++i)
+                header[i] = swapBytes(header[i]);
+        }
+
+        sf::Uint32 glType           = header[1];
+        sf::Uint32 glInternalFormat = header[4];
+        sf::Uint32 width            = header[6];
+        sf::Uint32 height           = header[7];
+        sf::Uint32 depth            = header[8];
+        sf::Uint32 arrayElements    = header[9];
+        sf::Uint32 faces            = header[10];
+        sf::Uint32 levelCount       = std::max(header[11], 1u);
+        sf::Uint32 keyValueBytes    = header[12];
+
+        if ((glType != 0) || !getFormatFromGl(glInternalFormat, image.format, image.opaque))
+        {
+            sf::err() << "Failed to load compressed image, unsupported KTX format (0x" << std::hex << glInternalFormat << std::dec << ")" << std::endl;
+            return false;
+        }
+
+        if ((width == 0) || (height == 0) || (depth > 1) || (arrayElements > 0) || (faces != 1))
+        {
+            sf::err() << "Failed to load compressed image, only 2D KTX images are supported" << std::endl;
+            return false;
+        }
+
+        // Compare with the remaining size, the sum could overflow
+        if (keyValueBytes > size - ktxHeaderSize)
+        {
+            sf::err() << "Failed to load compressed image, truncated KTX key/value data" << std::endl;
+            return false;
+        }
+
+        // Each level is preceded by its size and padded to 4 bytes
+        std::size_t  offset = ktxHeaderSize + keyValueBytes;
+        sf::Vector2u levelSize(width, height);
+        for (sf::Uint32 i = 0; (i < levelCount) && (offset + 4 <= size); ++i)
+        {
+            sf::Uint32 byteCount = readUint32(bytes + offset);
+            if (swapped)
+                byteCount = swapBytes(byteCount);
+
+            offset += 4;
+            if ((byteCount != getLevelByteCount(image.format, levelSize)) || (byteCount > size - offset))
+                break;
+
+            sf::priv::CompressedImage::Level level;
+            level.size      = levelSize;
+            level.offset    = offset;
+            level.byteCount = byteCount;
+            image.levels.push_back(level);
+
+            offset += (byteCount + 3) & ~3u;
+            levelSize = sf::Vector2u(std::max(levelSize.x / 2, 1u), std::max(levelSize.y / 2, 1u));
+        }
+
+        return true;
+    }
+
+    // Read the levels of a DDS file, stopping at the first incomplete one
+    bool parseDds(const sf::Uint8* bytes, std::size_t size, sf::priv::CompressedImage& image)
+    {
+        if (size < ddsHeaderSize)
+        {
+            sf::err() << "Failed to load compressed image, truncated DDS header" << std::endl;
+            return false;
+        }
+
+        sf::Uint32       flags      = readUint32(bytes + 8);
+        sf::Uint32       height     = readUint32(bytes + 12);
+        sf::Uint32       width      = readUint32(bytes + 16);
+        sf::Uint32       levelCount = (flags & 0x20000) ? std::max(readUint32(bytes + 28), 1u) : 1; // DDSD_MIPMAPCOUNT
+        const sf::Uint8* fourCC     = bytes + 84;
+
+        // DX10 files have an additional header, which holds their format
+        std::size_t offset     = ddsHeaderSize;
+        sf::Uint32  dxgiFormat = 0;
+        if (std::memcmp(fourCC, "DX10", 4) == 0)
+        {
+            if (size < ddsHeaderSize + dx10HeaderSize)
+            {
+                sf::err() << "Failed to load compressed image, truncated DDS header" << std::endl;
+                return false;
+            }
+
+            dxgiFormat = readUint32(bytes + offset);
+
+            // Only single 2D textures are supported
+            if ((readUint32(bytes + offset + 4) != 3) || (readUint32(bytes + offset + 12) > 1)) // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+            {
+                sf::err() << "Failed to load compressed image, only 2D DDS images are supported" << std::endl;
+                return false;
+            }
+
+            offset += dx10HeaderSize;
+        }
+
+        if (!getFormatFromDds(fourCC, dxgiFormat, image.format))
+        {
+            sf::err() << "Failed to load compressed image, unsupported DDS format" << std::endl;
+            return false;
+        }
+
+        if ((width == 0) || (height == 0))
+        {
+            sf::err() << "Failed to load compressed image, invalid DDS size (" << width << "x" << height << ")" << std::endl;
+            return false;
+        }
+
+        // The levels are stored one after the other
+        sf::Vector2u levelSize(width, height);
+        for (sf::Uint32 i = 0; i < levelCount; ++i)
+        {
+            std::size_t byteCount = getLevelByteCount(image.format, levelSize);
+            if (byteCount > size - offset)
+                break;
+
+            sf::priv::CompressedImage::Level level;
+            level.size      = levelSize;
+            level.offset    = offset;
+            level.byteCount = byteCount;
+            image.levels.push_back(level);
+
+            offset += byteCount;
+            levelSize = sf::Vector2u(std::max(levelSize.x / 2, 1u), std::max(levelSize.y / 2, 1u));
+        }
+
+        return true;
+    }
+
+    // Expand a RGB565 color to 8 bits per component
+    void expand565(sf::Uint32 color, sf::Uint8* rgba)
+    {
+        sf::Uint32 r = (color >> 11) & 0x1F;
+        sf::Uint32 g = (color >> 5) & 0x3F;
+        sf::Uint32 b = color & 0x1F;
+        rgba[0] = static_cast<sf::Uint8>((r << 3) | (r >> 2));
+        rgba[1] = static_cast<sf::Uint8>((g << 2) | (g >> 4));
+        rgba[2] = static_cast<sf::Uint8>((b << 3) | (b >> 2));
+        rgba[3] = 255;
+    }
+
+    // Decode the color part of a BC1, BC2 or BC3 block into 16 RGBA pixels (row major);
+    // only BC1 blocks have a three-color mode, whose fourth color is black, transparent unless opaque
+    void decodeBcColors(const sf::Uint8* block, sf::Uint8* pixels, bool bc1, bool opaque)
+    {
+        sf::Uint32 color0 = block[0] | (block[1] << 8);
+        sf::Uint32 color1 = block[2] | (block[3] << 8);
+
+        sf::Uint8 palette[4][4];
+        expand565(color0, palette[0]);
+        expand565(color1, palette[1]);
+
+        if ((color0 > color1) || !bc1)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                palette[2][i] = static_cast<sf::Uint8>((2 * palette[0][i] + palette[1][i]) / 3);
+                palette[3][i] = static_cast<sf::Uint8>((palette[0][i] + 2 * palette[1][i]) / 3);
+            }
+            palette[2][3] = 255;
+            palette[3][3] = 255;
+        }
+        else
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                palette[2][i] = static_cast<sf::Uint8>((palette[0][i] + palette[1][i]) / 2);
+                palette[3][i] = 0;
+            }
+            palette[2][3] = 255;
+            palette[3][3] = opaque ? 255 : 0;
+        }
+
+        sf::Uint32 indices = readUint32(block + 4);
+        for (int i = 0; i < 16; ++i)
+            std::memcpy(pixels + i * 4, palette[(indices >> (i * 2)) & 3], 4);
+    }
+
+    // Decode the alpha part of a BC3 block into the alpha of 16 RGBA pixels
+    void decodeBc3Alpha(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        unsigned int alpha[8];
+        alpha[0] = block[0];
+        alpha[1] = block[1];
+        if (alpha[0] > alpha[1])
+        {
+            for (unsigned int i = 1; i < 7; ++i)
+                alpha[i + 1] = ((7 - i) * alpha[0] + i * alpha[1]) / 7;
+        }
+        else
+        {
+            for (unsigned int i = 1; i < 5; ++i)
+                alpha[i + 1] = ((5 - i) * alpha[0] + i * alpha[1]) / 5;
+            alpha[6] = 0;
+            alpha[7] = 255;
+        }
+
+        // 3-bit indices, in the 48 bits that follow
+        sf::Uint64 indices = 0;
+        for (int i = 7; i >= 2; --i)
+            indices = (indices << 8) | block[i];
+
+        for (int i = 0; i < 16; ++i)
+            pixels[i * 4 + 3] = static_cast<sf::Uint8>(alpha[(indices >> (i * 3)) & 7]);
+    }
+
+    // Decode the alpha part of a BC2 block into the alpha of 16 RGBA pixels
+    void decodeBc2Alpha(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        for (int i = 0; i < 16; ++i)
+            pixels[i * 4 + 3] = static_cast<sf::Uint8>(((block[i / 2] >> ((i % 2) * 4)) & 0xF) * 17);
+    }
+
+    // Tables of the ETC2 and EAC specifications
+    const int etcModifiers[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+    const int etcDistances[8]    = {3, 6, 11, 16, 23, 32, 41, 64};
+    const int eacModifiers[16][8] =
+    {
+        {-3, -6,  -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12}, {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6,  -8, -12, 2, 5, 7, 11}, {-3, -7,  -9, -11, 2, 6, 8, 10}, {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6,  -8, -10, 1, 5, 7,  9}, {-2, -5,  -8, -10, 1, 4, 7,  9}, {-2, -4, -8, -10, 1, 3, 7,  9}, {-2, -5, -7, -10, 1, 4, 6,  9},
+        {-3, -4,  -7, -10, 2, 3, 6,  9}, {-1, -2,  -3, -10, 0, 1, 2,  9}, {-4, -6, -8,  -9, 3, 5, 7,  8}, {-3, -5, -7,  -9, 2, 4, 6,  8}
+    };
+
+    sf::Uint8 clampComponent(int value)
+    {
+        return static_cast<sf::Uint8>(std::min(std::max(value, 0), 255));
+    }
+
+    // Extend 4, 5, 6 or 7 bits to 8 bits
+    int extendBits(int value, int bits)
+    {
+        return (value << (8 - bits)) | (value >> (2 * bits - 8));
+    }
+
+    // Decode an ETC2 RGB block into 16 opaque RGBA pixels (row major)
+    void decodeEtc2Colors(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        // Pixel indices are stored column by column, in two bit planes
+        sf::Uint32 msb = (block[4] << 8) | block[5];
+        sf::Uint32 lsb = (block[6] << 8) | block[7];
+
+        int red        = block[0] >> 3;
+        int green      = block[1] >> 3;
+        int blue       = block[2] >> 3;
+        int redDelta   = ((block[0] & 7) ^ 4) - 4;
+        int greenDelta = ((block[1] & 7) ^ 4) - 4;
+        int blueDelta  = ((block[2] & 7) ^ 4) - 4;
+
+        bool differential = (block[3] & 2) != 0;
+        int  paint[4][3];
+        bool paintMode = false;
+
+        if (differential && ((red + redDelta < 0) || (red + redDelta > 31)))
+        {
+            // T mode
+            int color1[3] = {(((block[0] >> 3) & 3) << 2) | (block[0] & 3), block[1] >> 4, block[1] & 0xF};
+            int color2[3] = {block[2] >> 4, block[2] & 0xF, block[3] >> 4};
+            int distance  = etcDistances[(((block[3] >> 2) & 3) << 1) | (block[3] & 1)];
+
+            for (int i = 0; i < 3; ++i)
+            {
+                paint[0][i] = color1[i] * 17;
+                paint[1][i] = color2[i] * 17 + distance;
+                paint[2][i] = color2[i] * 17;
+                paint[3][i] = color2[i] * 17 - distance;
+            }
+            paintMode = true;
+        }
+        else if (differential && ((green + greenDelta < 0) || (green + greenDelta > 31)))
+        {
+            // H mode
+            int color1[3] = {(block[0] >> 3) & 0xF, ((block[0] & 7) << 1) | ((block[1] >> 4) & 1),
+                             (((block[1] >> 3) & 1) << 3) | ((block[1] & 3) << 1) | (block[2] >> 7)};
+            int color2[3] = {(block[2] >> 3) & 0xF, ((block[2] & 7) << 1) | (block[3] >> 7), (block[3] >> 3) & 0xF};
+
+            int value1 = (color1[0] << 8) | (color1[1] << 4) | color1[2];
+            int value2 = (color2[0] << 8) | (color2[1] << 4) | color2[2];
+            int distance = etcDistances[(((block[3] >> 2) & 1) << 2) | ((block[3] & 1) << 1) | (value1 >= value2 ? 1 : 0)];
+
+            for (int i = 0; i < 3; ++i)
+            {
+                paint[0][i] = color1[i] * 17 + distance;
+                paint[1][i] = color1[i] * 17 - distance;
+                paint[2][i] = color2[i] * 17 + distance;
+                paint[3][i] = color2[i] * 17 - distance;
+            }
+            paintMode = true;
+        }
+        else if (differential && ((blue + blueDelta < 0) || (blue + blueDelta > 31)))
+        {
+            // Planar mode: colors are interpolated between the origin, horizontal and vertical colors
+            int origin[3]     = {extendBits((block[0] >> 1) & 0x3F, 6),
+                                 extendBits(((block[0] & 1) << 6) | ((block[1] >> 1) & 0x3F), 7),
+                                 extendBits(((block[1] & 1) << 5) | (block[2] & 0x18) | ((block[2] & 3) << 1) | (block[3] >> 7), 6)};
+            int horizontal[3] = {extendBits((((block[3] >> 2) & 0x1F) << 1) | (block[3] & 1), 6),
+                                 extendBits(block[4] >> 1, 7),
+                                 extendBits(((block[4] & 1) << 5) | (block[5] >> 3), 6)};
+            int vertical[3]   = {extendBits(((block[5] & 7) << 3) | (block[6] >> 5), 6),
+                                 extendBits(((block[6] & 0x1F) << 2) | (block[7] >> 6), 7),
+                                 extendBits(block[7] & 0x3F, 6)};
+
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    sf::Uint8* pixel = pixels + (y * 4 + x) * 4;
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        // The offset keeps the shift a floor division for negative values
+                        int value = x * (horizontal[i] - origin[i]) + y * (vertical[i] - origin[i]) + 4 * origin[i] + 2;
+                        pixel[i] = clampComponent(((value + 1024) >> 2) - 256);
+                    }
+                    pixel[3] = 255;
+                }
+            }
+            return;
+        }
+
+        // Base colors of the two sub-blocks, for the individual and differential modes
+        int base[2][3];
+        if (differential)
+        {
+            int deltas[3] = {redDelta, greenDelta, blueDelta};
+            int colors[3] = {red, green, blue};
+            for (int i = 0; i < 3; ++i)
+            {
+                base[0][i] = extendBits(colors[i], 5);
+                base[1][i] = extendBits(colors[i] + deltas[i], 5);
+            }
+        }
+        else
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                base[0][i] = (block[i] >> 4) * 17;
+                base[1][i] = (block[i] & 0xF) * 17;
+            }
+        }
+
+        int  tables[2] = {block[3] >> 5, (block[3] >> 2) & 7};
+        bool flipped   = (block[3] & 1) != 0;
+
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                int        bit   = x * 4 + y;
+                int        index = static_cast<int>((((msb >> bit) & 1) << 1) | ((lsb >> bit) & 1));
+                sf::Uint8* pixel = pixels + (y * 4 + x) * 4;
+
+                if (paintMode)
+                {
+                    for (int i = 0; i < 3; ++i)
+                        pixel[i] = clampComponent(paint[index][i]);
+                }
+                else
+                {
+                    int subBlock = flipped ? (y >= 2) : (x >= 2);
+                    int modifier = etcModifiers[tables[subBlock]][index & 1];
+                    if (index & 2)
+                        modifier = -modifier;
+
+                    for (int i = 0; i < 3; ++i)
+                        pixel[i] = clampComponent(base[subBlock][i] + modifier);
+                }
+
+                pixel[3] = 255;
+            }
+        }
+    }
+
+    // Decode an EAC alpha block into the alpha of 16 RGBA pixels
+    void decodeEacAlpha(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        int        base       = block[0];
+        int        multiplier = block[1] >> 4;
+        const int* modifiers  = eacModifiers[block[1] & 0xF];
+
+        // 3-bit indices, stored column by column from the most significant bits
+        sf::Uint64 indices = 0;
+        for (int i = 2; i < 8; ++i)
+            indices = (indices << 8) | block[i];
+
+        for (int x = 0; x < 4; ++x)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                int index = static_cast<int>((indices >> (45 - 3 * (x * 4 + y))) & 7);
+                pixels[(y * 4 + x) * 4 + 3] = clampComponent(base + modifiers[index] * multiplier);
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isCompressedImageFile(const void* data, std::size_t size)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    return (bytes && (size >= sizeof(ktxIdentifier)) && (std::memcmp(bytes, ktxIdentifier, sizeof(ktxIdentifier)) == 0)) ||
+           (bytes && (size >= sizeof(ddsIdentifier)) && (std::memcmp(bytes, ddsIdentifier, sizeof(ddsIdentifier)) == 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool loadCompressedImage(const void* data, std::size_t size, CompressedImage& image)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    image.opaque = false;
+    image.levels.clear();
+    image.data.clear();
+
+    bool parsed = false;
+    if (!isCompressedImageFile(data, size))
+        err() << "Failed to load compressed image, not a KTX or DDS file" << std::endl;
+    else if (bytes[0] == ktxIdentifier[0])
+        parsed = parseKtx(bytes, size, image);
+    else
+        parsed = parseDds(bytes, size, image);
+
+    if (!parsed)
+        return false;
+
+    if (image.levels.empty())
+    {
+        err() << "Failed to load compressed image, truncated pixel data" << std::endl;
+        return false;
+    }
+
+    // Keep a copy of the blocks, so that levels don't depend on the file data
+    const CompressedImage::Level& last = image.levels.back();
+    image.data.assign(bytes, bytes + last.offset + last.byteCount);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool decompressLevel(const CompressedImage& image, std::size_t level, Uint8* pixels)
+{
+    if (image.format >= Texture::Astc4x4)
+        return false;
+
+    const Vector2u    size      = image.levels[level].size;
+    const std::size_t byteCount = getBlockByteCount(image.format);
+    const Uint8*      block     = &image.data[image.levels[level].offset];
+
+    for (unsigned int top = 0; top < size.y; top += 4)
+    {
+        for (unsigned int left = 0; left < size.x; left += 4, block += byteCount)
+        {
+            // Decode the block into 4x4 pixels
+            Uint8 decoded[16 * 4];
+            switch (image.format)
+            {
+                case Texture::Bc1:
+                    decodeBcColors(block, decoded, true, image.opaque);
+                    break;
+
+                case Texture::Bc2:
+                    decodeBcColors(block + 8, decoded, false, true);
+                    decodeBc2Alpha(block, decoded);
+                    break;
+
+                case Texture::Bc3:
+                    decodeBcColors(block + 8, decoded, false, true);
+                    decodeBc3Alpha(block, decoded);
+                    break;
+
+                case Texture::Etc2Rgb:
+                    decodeEtc2Colors(block, decoded);
+                    break;
+
+                default:
+                    decodeEtc2Colors(block + 8, decoded);
+                    decodeEacAlpha(block, decoded);
+                    break;
+            }
+
+            // Copy the pixels that are inside the image
+            unsigned int width  = std::min(size.x - left, 4u);
+            unsigned int height = std::min(size.y - top, 4u);
+            for (unsigned int y = 0; y < height; ++y)
+                std::memcpy(pixels + ((top + y) * size.x + left) * 4, decoded + y * 16, width * 4);
+        }
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDIMAGE_HPP
+#define SFML_COMPRESSEDIMAGE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Compressed pixels of an image and of its mipmap
+///        levels, as stored in a KTX or DDS file
+///
+////////////////////////////////////////////////////////////
+struct CompressedImage
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of a mipmap level in the data
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Level
+    {
+        Vector2u    size;      ///< Size of the level, in pixels
+        std::size_t offset;    ///< Offset of the first block of the level in the data
+        std::size_t byteCount; ///< Size of the blocks of the level, in bytes
+    };
+
+    Texture::Format    format; ///< Compression format of the blocks
+    bool               opaque; ///< Is the image opaque? Only for BC1, which has RGB and RGBA variants
+    std::vector<Level> levels; ///< Mipmap levels, starting with the full size image
+    std::vector<Uint8> data;   ///< Blocks of all the levels
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether data starts like a KTX or DDS file
+///
+/// \param data Data to check
+/// \param size Size of the data, in bytes
+///
+/// \return True if the data looks like a compressed image file
+///
+////////////////////////////////////////////////////////////
+bool isCompressedImageFile(const void* data, std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Parse a KTX (version 1) or DDS file
+///
+/// Only 2D images in one of the formats of Texture::Format
+/// are supported. Errors are reported to sf::err().
+///
+/// \param data  File contents
+/// \param size  Size of the file, in bytes
+/// \param image Compressed image to fill
+///
+/// \return True if the file was parsed successfully
+///
+////////////////////////////////////////////////////////////
+bool loadCompressedImage(const void* data, std::size_t size, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Decompress a mipmap level to RGBA pixels
+///
+/// BC1, BC2, BC3 and ETC2 blocks can be decompressed,
+/// ASTC blocks can't.
+///
+/// \param image  Compressed image
+/// \param level  Index of the mipmap level to decompress
+/// \param pixels Array of size.x * size.y * 4 bytes to fill
+///
+/// \return True if the level was decompressed
+///
+////////////////////////////////////////////////////////////
+bool decompressLevel(const CompressedImage& image, std::size_t level, Uint8* pixels);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDIMAGE_HPP
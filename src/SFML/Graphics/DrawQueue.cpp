@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DrawQueue.hpp>
+#include <SFML/Graphics/DrawRecorder.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/InstanceBuffer.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Get the sort index of a value, assigning the next one if it was never seen
+    template <typename T>
+    sf::Uint16 getIndex(std::map<T, sf::Uint16>& indices, const T& value)
+    {
+        typename std::map<T, sf::Uint16>::iterator it = indices.find(value);
+        if (it != indices.end())
+            return it->second;
+
+        // Past 65535 distinct values, the extra ones share the last index
+        sf::Uint16 index = static_cast<sf::Uint16>(std::min<std::size_t>(indices.size(), 0xFFFF));
+        indices.insert(std::make_pair(value, index));
+
+        return index;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DrawQueue::DrawQueue() :
+m_recorder  (NULL),
+m_layer     (0),
+m_commands  (),
+m_vertices  (),
+m_shaders   (),
+m_textures  (),
+m_blendModes(),
+m_order     (),
+m_sorted    (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+DrawQueue::~DrawQueue()
+{
+    delete m_recorder;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::setLayer(Int16 layer)
+{
+    m_layer = layer;
+}
+
+
+////////////////////////////////////////////////////////////
+Int16 DrawQueue::getLayer() const
+{
+    return m_layer;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::draw(const Drawable& drawable, const RenderStates& states)
+{
+    if (!m_recorder)
+        m_recorder = new priv::DrawRecorder<DrawQueue>(*this);
+
+    m_recorder->draw(drawable, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::draw(const Vertex* vertices, std::size_t vertexCount,
+                     PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    Command command;
+    command.states         = states;
+    command.type           = type;
+    command.vertexBuffer   = NULL;
+    command.indexBuffer    = NULL;
+    command.instanceBuffer = NULL;
+    command.firstVertex    = m_vertices.size();
+    command.vertexCount    = vertexCount;
+
+    m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+
+    m_order.push_back(SortEntry(computeKey(states), m_commands.size()));
+    m_commands.push_back(command);
+    m_sorted = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (vertexCount == 0)
+        return;
+
+    Command command;
+    command.states         = states;
+    command.type           = vertexBuffer.getPrimitiveType();
+    command.vertexBuffer   = &vertexBuffer;
+    command.indexBuffer    = NULL;
+    command.instanceBuffer = NULL;
+    command.firstVertex    = firstVertex;
+    command.vertexCount    = vertexCount;
+
+    m_order.push_back(SortEntry(computeKey(states), m_commands.size()));
+    m_commands.push_back(command);
+    m_sorted = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, indexBuffer, 0, indexBuffer.getIndexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (indexCount == 0)
+        return;
+
+    Command command;
+    command.states         = states;
+    command.type           = vertexBuffer.getPrimitiveType();
+    command.vertexBuffer   = &vertexBuffer;
+    command.indexBuffer    = &indexBuffer;
+    command.instanceBuffer = NULL;
+    command.firstVertex    = firstIndex;
+    command.vertexCount    = indexCount;
+
+    m_order.push_back(SortEntry(computeKey(states), m_commands.size()));
+    m_commands.push_back(command);
+    m_sorted = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::drawInstanced(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states)
+{
+    // Nothing to draw? (the vertex buffer is checked when the instances are replayed)
+    if (instanceBuffer.getInstanceCount() == 0)
+        return;
+
+    Command command;
+    command.states         = states;
+    command.type           = vertexBuffer.getPrimitiveType();
+    command.vertexBuffer   = &vertexBuffer;
+    command.indexBuffer    = NULL;
+    command.instanceBuffer = &instanceBuffer;
+    command.firstVertex    = 0;
+    command.vertexCount    = vertexBuffer.getVertexCount();
+
+    m_order.push_back(SortEntry(computeKey(states), m_commands.size()));
+    m_commands.push_back(command);
+    m_sorted = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DrawQueue::getDrawCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::clear()
+{
+    m_layer = 0;
+    m_commands.clear();
+    m_vertices.clear();
+    m_shaders.clear();
+    m_textures.clear();
+    m_blendModes.clear();
+    m_order.clear();
+    m_sorted = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::replay(RenderTarget& target) const
+{
+    // The command index is part of the sort entry, so equal keys keep their recording order
+    if (!m_sorted)
+    {
+        std::sort(m_order.begin(), m_order.end());
+        m_sorted = true;
+    }
+
+    for (std::vector<SortEntry>::const_iterator it = m_order.begin(); it != m_order.end(); ++it)
+    {
+        const Command& command = m_commands[it->second];
+
+        if (command.instanceBuffer)
+            target.drawInstanced(*command.vertexBuffer, *command.instanceBuffer, command.states);
+        else if (command.indexBuffer)
+            target.draw(*command.vertexBuffer, *command.indexBuffer, command.firstVertex, command.vertexCount, command.states);
+        else if (command.vertexBuffer)
+            target.draw(*command.vertexBuffer, command.firstVertex, command.vertexCount, command.states);
+        else
+            target.draw(&m_vertices[command.firstVertex], command.vertexCount, command.type, command.states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 DrawQueue::computeKey(const RenderStates& states)
+{
+    // Shift the layer so that negative layers sort first
+    Uint64 layer = static_cast<Uint64>(static_cast<Int32>(m_layer) + 32768);
+    Uint64 shader = getIndex(m_shaders, states.shader);
+    Uint64 texture = getIndex(m_textures, states.texture);
+
+    // Blend modes can't be ordered, there are usually very few of them
+    std::size_t blendMode = std::find(m_blendModes.begin(), m_blendModes.end(), states.blendMode) - m_blendModes.begin();
+    if (blendMode == m_blendModes.size())
+        m_blendModes.push_back(states.blendMode);
+
+    Uint64 blend = std::min<std::size_t>(blendMode, 0xFFFF);
+
+    return (layer << 48) | (shader << 32) | (texture << 16) | blend;
+}
+
+} // namespace sf
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DRAWRECORDER_HPP
+#define SFML_DRAWRECORDER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Render target capturing the primitives of drawables
+///
+/// Draw calls are forwarded to the draw() functions of a
+/// recorder object (such as sf::DrawQueue) instead of being
+/// rendered. No OpenGL context is needed, so drawables can be
+/// captured from any thread.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class DrawRecorder : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the recorder
+    ///
+    /// \param recorder Object receiving the captured draw calls
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit DrawRecorder(T& recorder) :
+    m_recorder(recorder)
+    {
+        RenderTarget::initialize();
+
+        // Let built-in drawables give us their vertex arrays
+        // rather than their vertex buffers, so that we copy them
+        setBatchingEnabled(true);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the rendering region of the target
+    ///
+    /// \return Always (0, 0)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const
+    {
+        return Vector2u(0, 0);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate or deactivate the render target for rendering
+    ///
+    /// \return Always false, the recorder never renders anything
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setActive(bool)
+    {
+        return false;
+    }
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forward primitives defined by an array of vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool interceptDraw(const Vertex* vertices, std::size_t vertexCount,
+                               PrimitiveType type, const RenderStates& states)
+    {
+        m_recorder.draw(vertices, vertexCount, type, states);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forward primitives defined by a vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool interceptDraw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                               std::size_t vertexCount, const RenderStates& states)
+    {
+        m_recorder.draw(vertexBuffer, firstVertex, vertexCount, states);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forward primitives defined by a vertex buffer and an index buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool interceptDraw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer,
+                               std::size_t firstIndex, std::size_t indexCount, const RenderStates& states)
+    {
+        m_recorder.draw(vertexBuffer, indexBuffer, firstIndex, indexCount, states);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forward instances of a vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool interceptDraw(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer,
+                               const RenderStates& states)
+    {
+        m_recorder.drawInstanced(vertexBuffer, instanceBuffer, states);
+        return true;
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    T& m_recorder; ///< Object receiving the captured draw calls
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DRAWRECORDER_HPP
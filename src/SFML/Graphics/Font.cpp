@@ -26,20 +26,29 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/AtlasPacker.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/Shader.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <set>
 
 
 namespace
@@ -71,10 +80,455 @@ namespace
         return output;
     }
 
-    // Combine outline thickness, boldness and font glyph index into a single 64-bit key
-    sf::Uint64 combine(float outlineThickness, bool bold, sf::Uint32 index)
+    // Combine outline thickness, boldness and code point into a single 64-bit key
+    sf::Uint64 combine(float outlineThickness, bool bold, sf::Uint32 codePoint)
     {
-        return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | index;
+        return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | codePoint;
+    }
+
+    // Scramble the bits of a 64-bit key, so that close keys end up in distant hash table slots
+    std::size_t hash(sf::Uint64 key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<std::size_t>(key);
+    }
+
+    // One-dimensional squared Euclidean distance transform (Felzenszwalb & Huttenlocher)
+    void distanceTransform(std::vector<float>& grid, std::size_t offset, std::size_t stride, std::size_t length,
+                           std::vector<float>& f, std::vector<int>& v, std::vector<float>& z)
+    {
+        const float infinity = 1e20f;
+
+        for (std::size_t q = 0; q < length; ++q)
+            f[q] = grid[offset + q * stride];
+
+        int k = 0;
+        v[0] = 0;
+        z[0] = -infinity;
+        z[1] = infinity;
+
+        for (int q = 1; q < static_cast<int>(length); ++q)
+        {
+            float s;
+            do
+            {
+                int r = v[k];
+                s = (f[q] - f[r] + static_cast<float>(q * q - r * r)) / static_cast<float>(2 * (q - r));
+            }
+            while ((s <= z[k]) && (--k > -1));
+
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = infinity;
+        }
+
+        k = 0;
+        for (int q = 0; q < static_cast<int>(length); ++q)
+        {
+            while (z[k + 1] < static_cast<float>(q))
+                ++k;
+
+            int r = v[k];
+            grid[offset + q * stride] = f[r] + static_cast<float>((q - r) * (q - r));
+        }
+    }
+
+    // Replace the coverage stored in the alpha channel of RGBA pixels with a signed distance field;
+    // edges are at 0.5, and 0 / 1 are at the given distance outside / inside the glyph
+    void computeDistanceField(sf::Uint8* pixels, unsigned int width, unsigned int height, float spread)
+    {
+        const float infinity = 1e20f;
+        const std::size_t count = static_cast<std::size_t>(width) * height;
+
+        // Squared distances to the nearest outside and inside pixels, with
+        // partially covered pixels seeded with their sub-pixel edge distance
+        std::vector<float> outside(count);
+        std::vector<float> inside(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float coverage = pixels[i * 4 + 3] / 255.f;
+
+            if (coverage >= 1.f)
+            {
+                outside[i] = 0.f;
+                inside[i] = infinity;
+            }
+            else if (coverage <= 0.f)
+            {
+                outside[i] = infinity;
+                inside[i] = 0.f;
+            }
+            else
+            {
+                outside[i] = std::max(0.f, 0.5f - coverage) * std::max(0.f, 0.5f - coverage);
+                inside[i] = std::max(0.f, coverage - 0.5f) * std::max(0.f, coverage - 0.5f);
+            }
+        }
+
+        std::size_t length = std::max(width, height);
+        std::vector<float> f(length);
+        std::vector<int>   v(length);
+        std::vector<float> z(length + 1);
+
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            distanceTransform(outside, x, width, height, f, v, z);
+            distanceTransform(inside, x, width, height, f, v, z);
+        }
+
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            distanceTransform(outside, y * width, 1, width, f, v, z);
+            distanceTransform(inside, y * width, 1, width, f, v, z);
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float distance = std::sqrt(outside[i]) - std::sqrt(inside[i]);
+            float value = 0.5f - distance / (2.f * spread);
+            pixels[i * 4 + 3] = static_cast<sf::Uint8>(std::min(std::max(value, 0.f), 1.f) * 255.f + 0.5f);
+        }
+    }
+
+    // Rasterize a glyph with the given FreeType objects (its size must already be set);
+    // the RGBA pixels, surrounded by the padding, are written to the buffer and the
+    // texture rectangle of the glyph receives their size
+    bool rasterizeGlyph(FT_Library library, FT_Face face, FT_Stroker stroker, sf::Uint32 codePoint, bool bold, float outlineThickness,
+                        bool distanceField, unsigned int padding, std::vector<sf::Uint8>& buffer, sf::Glyph& glyph)
+    {
+        // Load the glyph corresponding to the code point
+        // (distance fields are scaled, so they must not be hinted for a specific size)
+        FT_Int32 flags = FT_LOAD_TARGET_NORMAL | (distanceField ? FT_LOAD_NO_HINTING : FT_LOAD_FORCE_AUTOHINT);
+        if (outlineThickness != 0)
+            flags |= FT_LOAD_NO_BITMAP;
+        if (FT_Load_Char(face, codePoint, flags) != 0)
+            return false;
+
+        // Retrieve the glyph
+        FT_Glyph glyphDesc;
+        if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+            return false;
+
+        // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
+        FT_Pos weight = 1 << 6;
+        bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (outline)
+        {
+            if (bold)
+            {
+                FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+                FT_Outline_Embolden(&outlineGlyph->outline, weight);
+            }
+
+            if (outlineThickness != 0)
+            {
+                FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+                FT_Glyph_Stroke(&glyphDesc, stroker, true);
+            }
+        }
+
+        // Convert the glyph to a bitmap (i.e. rasterize it)
+        FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+        FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+        // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+        if (!outline)
+        {
+            if (bold)
+                FT_Bitmap_Embolden(library, &bitmap, weight, weight);
+
+            if (outlineThickness != 0)
+                sf::err() << "Failed to outline glyph (no fallback available)" << std::endl;
+        }
+
+        // Compute the glyph's advance offset
+        glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+        if (bold)
+            glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+        unsigned int width  = bitmap.width;
+        unsigned int height = bitmap.rows;
+
+        if ((width > 0) && (height > 0))
+        {
+            width += 2 * padding;
+            height += 2 * padding;
+            glyph.textureRect = sf::IntRect(0, 0, width, height);
+
+            // Compute the glyph's bounding box
+            glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+            glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+            glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
+            glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+
+            // Resize the pixel buffer to the new size and fill it with transparent white pixels
+            buffer.resize(width * height * 4);
+
+            sf::Uint8* current = &buffer[0];
+            sf::Uint8* end = current + width * height * 4;
+
+            while (current != end)
+            {
+                (*current++) = 255;
+                (*current++) = 255;
+                (*current++) = 255;
+                (*current++) = 0;
+            }
+
+            // Extract the glyph's pixels from the bitmap
+            const sf::Uint8* pixels = bitmap.buffer;
+            if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+            {
+                // Pixels are 1 bit monochrome values
+                for (unsigned int y = padding; y < height - padding; ++y)
+                {
+                    for (unsigned int x = padding; x < width - padding; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = x + y * width;
+                        buffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+            else
+            {
+                // Pixels are 8 bits gray levels
+                for (unsigned int y = padding; y < height - padding; ++y)
+                {
+                    for (unsigned int x = padding; x < width - padding; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = x + y * width;
+                        buffer[index * 4 + 3] = pixels[x - padding];
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+
+            // Convert the coverage to a signed distance field
+            if (distanceField)
+                computeDistanceField(&buffer[0], width, height, static_cast<float>(padding - 1));
+        }
+
+        // Delete the FT glyph
+        FT_Done_Glyph(glyphDesc);
+
+        return true;
+    }
+
+    // Maximum number of threads used by Font::preload, and minimum amount of work for each one
+    const std::size_t maxPreloadThreads = 4;
+    const std::size_t glyphsPerPreloadThread = 32;
+
+    // Glyph rasterized by Font::preload, waiting to be written to the textures
+    struct PreloadedGlyph
+    {
+        sf::Uint32             codePoint; // Unicode code point of the character
+        sf::Uint64             key;       // Key of the glyph in the glyph table
+        sf::Glyph              glyph;     // Metrics, and size of the pixel area
+        std::vector<sf::Uint8> pixels;    // RGBA pixels, padding included
+        bool                   done;      // Was the glyph successfully rasterized?
+    };
+
+    // Share of the work of Font::preload given to a thread
+    struct PreloadJob
+    {
+        const std::string*           fileName;         // Path of the font file, if any
+        const void*                  fileData;         // Font data, if loaded from memory
+        std::size_t                  fileSize;         // Size of the font data
+        unsigned int                 characterSize;    // Size of the glyphs
+        bool                         bold;             // Bold glyphs?
+        float                        outlineThickness; // Thickness of the glyphs outline
+        bool                         distanceField;    // Distance field glyphs?
+        unsigned int                 padding;          // Padding around the glyphs pixels
+        std::vector<PreloadedGlyph>* glyphs;           // All the glyphs to rasterize
+        std::size_t                  first;            // Index of the first glyph of the thread
+        std::size_t                  step;             // Number of threads, glyphs are interleaved between them
+    };
+
+    // Rasterize the share of glyphs of a job
+    void rasterizeGlyphs(FT_Library library, FT_Face face, FT_Stroker stroker, const PreloadJob& job)
+    {
+        for (std::size_t i = job.first; i < job.glyphs->size(); i += job.step)
+        {
+            PreloadedGlyph& glyph = (*job.glyphs)[i];
+            glyph.done = rasterizeGlyph(library, face, stroker, glyph.codePoint, job.bold, job.outlineThickness,
+                                        job.distanceField, job.padding, glyph.pixels, glyph.glyph);
+        }
+    }
+
+    // Entry point of the Font::preload threads: FreeType objects can't be shared
+    // between threads, so each one opens the font again with its own library
+    void preloadThread(PreloadJob* job)
+    {
+        FT_Library library;
+        if (FT_Init_FreeType(&library) != 0)
+            return;
+
+        FT_Face face = NULL;
+        FT_Stroker stroker = NULL;
+
+        FT_Error error;
+        if (!job->fileName->empty())
+            error = FT_New_Face(library, job->fileName->c_str(), 0, &face);
+        else
+            error = FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(job->fileData), static_cast<FT_Long>(job->fileSize), 0, &face);
+
+        // Glyphs that are not rasterized here will be done by the calling thread
+        if ((error == 0) &&
+            (FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0) &&
+            (FT_Set_Pixel_Sizes(face, 0, job->characterSize) == 0) &&
+            (FT_Stroker_New(library, &stroker) == 0))
+        {
+            rasterizeGlyphs(library, face, stroker, *job);
+        }
+
+        if (stroker)
+            FT_Stroker_Done(stroker);
+
+        if (face)
+            FT_Done_Face(face);
+
+        FT_Done_FreeType(library);
+    }
+
+    // Pixels to write to a font page with a single texture update
+    struct PageUpload
+    {
+        PageUpload() : evictionCount(0) {}
+
+        std::vector<sf::Uint8>   pixels;        // Pixels of all the areas, one after the other
+        std::vector<sf::IntRect> rects;         // Areas to update
+        unsigned int             evictionCount; // Number of evictions of the page when the areas were allocated
+    };
+
+    // Shader rendering distance field glyphs with the fixed-function vertex pipeline
+    const char distanceFieldFragmentShader[] =
+        "uniform sampler2D sf_texture;\n"
+        "uniform float threshold;\n"
+        "void main()\n"
+        "{\n"
+        "    float distance = texture2D(sf_texture, gl_TexCoord[0].xy).a;\n"
+        "    float smoothing = 0.7 * fwidth(distance);\n"
+        "    float alpha = smoothstep(threshold - smoothing, threshold + smoothing, distance);\n"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);\n"
+        "}\n";
+
+    // Same shader for core profile contexts, which have no fixed-function pipeline; the
+    // sampler is named sf_texture because in GLSL 1.50 a uniform named texture would hide
+    // the texture() function
+    const char distanceFieldCoreVertexShader[] =
+        "#version 150\n"
+        "uniform mat4 sf_projectionMatrix;\n"
+        "uniform mat4 sf_modelViewMatrix;\n"
+        "uniform mat4 sf_textureMatrix;\n"
+        "in vec2 sf_position;\n"
+        "in vec4 sf_color;\n"
+        "in vec2 sf_texCoords;\n"
+        "out vec4 color;\n"
+        "out vec2 texCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_projectionMatrix * sf_modelViewMatrix * vec4(sf_position, 0.0, 1.0);\n"
+        "    texCoords = (sf_textureMatrix * vec4(sf_texCoords, 0.0, 1.0)).xy;\n"
+        "    color = sf_color;\n"
+        "}\n";
+
+    const char distanceFieldCoreFragmentShader[] =
+        "#version 150\n"
+        "uniform sampler2D sf_texture;\n"
+        "uniform float threshold;\n"
+        "in vec4 color;\n"
+        "in vec2 texCoords;\n"
+        "out vec4 fragColor;\n"
+        "void main()\n"
+        "{\n"
+        "    float distance = texture(sf_texture, texCoords).a;\n"
+        "    float smoothing = 0.7 * fwidth(distance);\n"
+        "    float alpha = smoothstep(threshold - smoothing, threshold + smoothing, distance);\n"
+        "    fragColor = vec4(color.rgb, color.a * alpha);\n"
+        "}\n";
+
+    // Process-wide FreeType library and registry of the open font faces, so that the fonts
+    // loaded from the same file or memory share their face instead of opening it again;
+    // the library lives as long as there is a face, which avoids global destruction order issues
+    typedef std::pair<std::string, std::pair<const void*, std::size_t> > FaceKey;
+
+    struct SharedFace
+    {
+        FT_Face    face;     // Open face
+        FT_Stroker stroker;  // Stroker of the fonts using the face
+        int*       refCount; // Number of fonts using the face
+        sf::Mutex* mutex;    // Mutex serializing the use of the face, of its stroker and of the glyph caches of its fonts
+        void*      cache;    // Glyph cache offered to the fonts loading the face, if any
+    };
+
+    typedef std::map<FaceKey, SharedFace> FaceRegistry;
+
+    sf::Mutex    registryMutex;
+    FaceRegistry faceRegistry;
+    FT_Library   sharedLibrary = NULL;
+    unsigned int sharedLibraryUsers = 0;
+
+    // Get the shared FreeType library, initializing it if needed (the registry must be locked)
+    FT_Library acquireLibrary()
+    {
+        if (!sharedLibrary && (FT_Init_FreeType(&sharedLibrary) != 0))
+        {
+            sharedLibrary = NULL;
+            return NULL;
+        }
+
+        sharedLibraryUsers++;
+        return sharedLibrary;
+    }
+
+    // Release the shared FreeType library, closing it when it is no longer used (the registry must be locked)
+    void releaseLibrary()
+    {
+        if (--sharedLibraryUsers == 0)
+        {
+            FT_Done_FreeType(sharedLibrary);
+            sharedLibrary = NULL;
+        }
+    }
+
+    // Lock the mutex of a font face for the current scope, if the font has a face;
+    // sf::Mutex is recursive, so the functions of a font can lock it again
+    class FaceLock : sf::NonCopyable
+    {
+    public:
+
+        explicit FaceLock(sf::Mutex* mutex) :
+        m_mutex(mutex)
+        {
+            if (m_mutex)
+                m_mutex->lock();
+        }
+
+        ~FaceLock()
+        {
+            if (m_mutex)
+                m_mutex->unlock();
+        }
+
+    private:
+
+        sf::Mutex* m_mutex;
+    };
+
+    // Stop offering a glyph cache to the fonts loading its face (the registry must be locked)
+    void unregisterCache(void* cache)
+    {
+        for (FaceRegistry::iterator it = faceRegistry.begin(); it != faceRegistry.end(); ++it)
+        {
+            if (it->second.cache == cache)
+                it->second.cache = NULL;
+        }
     }
 }
 
@@ -83,12 +537,19 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_stroker  (NULL),
-m_refCount (NULL),
-m_info     ()
+m_library     (NULL),
+m_face        (NULL),
+m_streamRec   (NULL),
+m_stroker     (NULL),
+m_refCount    (NULL),
+m_faceMutex   (NULL),
+m_info        (),
+m_fileName    (),
+m_fileData    (NULL),
+m_fileSize    (0),
+m_pixelBuffer (),
+m_fieldShaders(),
+m_cache       (new Cache)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -98,24 +559,33 @@ m_info     ()
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_stroker    (copy.m_stroker),
-m_refCount   (copy.m_refCount),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_library     (copy.m_library),
+m_face        (copy.m_face),
+m_streamRec   (copy.m_streamRec),
+m_stroker     (copy.m_stroker),
+m_refCount    (copy.m_refCount),
+m_faceMutex   (copy.m_faceMutex),
+m_info        (copy.m_info),
+m_fileName    (copy.m_fileName),
+m_fileData    (copy.m_fileData),
+m_fileSize    (copy.m_fileSize),
+m_pixelBuffer (),
+m_fieldShaders(),
+m_cache       (copy.m_cache)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
     #endif
 
     // Note: as FreeType doesn't provide functions for copying/cloning,
-    // we must share all the FreeType pointers
+    // we must share all the FreeType pointers; the glyph cache is
+    // shared as well, until one of the fonts changes its settings
+    Lock lock(registryMutex);
 
     if (m_refCount)
         (*m_refCount)++;
+
+    m_cache->refCount++;
 }
 
 
@@ -124,6 +594,12 @@ Font::~Font()
 {
     cleanup();
 
+    // The cache is not shared anymore after cleanup
+    delete m_cache;
+
+    for (ShaderTable::iterator it = m_fieldShaders.begin(); it != m_fieldShaders.end(); ++it)
+        delete it->second;
+
     #ifdef SFML_SYSTEM_ANDROID
 
     if (m_stream)
@@ -140,51 +616,14 @@ bool Font::loadFromFile(const std::string& filename)
 
     // Cleanup the previous resources
     cleanup();
-    m_refCount = new int(1);
-
-    // Initialize FreeType
-    // Note: we initialize FreeType for every font instance in order to avoid having a single
-    // global manager that would create a lot of issues regarding creation and destruction order.
-    FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
-    {
-        err() << "Failed to load font \"" << filename << "\" (failed to initialize FreeType)" << std::endl;
-        return false;
-    }
-    m_library = library;
-
-    // Load the new font face from the specified file
-    FT_Face face;
-    if (FT_New_Face(static_cast<FT_Library>(m_library), filename.c_str(), 0, &face) != 0)
-    {
-        err() << "Failed to load font \"" << filename << "\" (failed to create the font face)" << std::endl;
-        return false;
-    }
-
-    // Load the stroker that will be used to outline the font
-    FT_Stroker stroker;
-    if (FT_Stroker_New(static_cast<FT_Library>(m_library), &stroker) != 0)
-    {
-        err() << "Failed to load font \"" << filename << "\" (failed to create the stroker)" << std::endl;
-        FT_Done_Face(face);
-        return false;
-    }
 
-    // Select the unicode character map
-    if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
-    {
-        err() << "Failed to load font \"" << filename << "\" (failed to set the Unicode character set)" << std::endl;
-        FT_Stroker_Done(stroker);
-        FT_Done_Face(face);
+    // Load the font face from the specified file, or share it if it is already loaded
+    if (!openFace(filename, NULL, 0, NULL, "\"" + filename + "\""))
         return false;
-    }
-
-    // Store the loaded font in our ugly void* :)
-    m_stroker = stroker;
-    m_face = face;
 
     // Store the font information
-    m_info.family = face->family_name ? face->family_name : std::string();
+    m_info.family = static_cast<FT_Face>(m_face)->family_name ? static_cast<FT_Face>(m_face)->family_name : std::string();
+    m_fileName = filename;
 
     return true;
 
@@ -205,51 +644,15 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
 {
     // Cleanup the previous resources
     cleanup();
-    m_refCount = new int(1);
-
-    // Initialize FreeType
-    // Note: we initialize FreeType for every font instance in order to avoid having a single
-    // global manager that would create a lot of issues regarding creation and destruction order.
-    FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
-    {
-        err() << "Failed to load font from memory (failed to initialize FreeType)" << std::endl;
-        return false;
-    }
-    m_library = library;
 
-    // Load the new font face from the specified file
-    FT_Face face;
-    if (FT_New_Memory_Face(static_cast<FT_Library>(m_library), reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(sizeInBytes), 0, &face) != 0)
-    {
-        err() << "Failed to load font from memory (failed to create the font face)" << std::endl;
-        return false;
-    }
-
-    // Load the stroker that will be used to outline the font
-    FT_Stroker stroker;
-    if (FT_Stroker_New(static_cast<FT_Library>(m_library), &stroker) != 0)
-    {
-        err() << "Failed to load font from memory (failed to create the stroker)" << std::endl;
-        FT_Done_Face(face);
-        return false;
-    }
-
-    // Select the Unicode character map
-    if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
-    {
-        err() << "Failed to load font from memory (failed to set the Unicode character set)" << std::endl;
-        FT_Stroker_Done(stroker);
-        FT_Done_Face(face);
+    // Load the font face from the specified memory, or share it if it is already loaded
+    if (!openFace(std::string(), data, sizeInBytes, NULL, "from memory"))
         return false;
-    }
-
-    // Store the loaded font in our ugly void* :)
-    m_stroker = stroker;
-    m_face = face;
 
     // Store the font information
-    m_info.family = face->family_name ? face->family_name : std::string();
+    m_info.family = static_cast<FT_Face>(m_face)->family_name ? static_cast<FT_Face>(m_face)->family_name : std::string();
+    m_fileData = data;
+    m_fileSize = sizeInBytes;
 
     return true;
 }
@@ -260,18 +663,6 @@ bool Font::loadFromStream(InputStream& stream)
 {
     // Cleanup the previous resources
     cleanup();
-    m_refCount = new int(1);
-
-    // Initialize FreeType
-    // Note: we initialize FreeType for every font instance in order to avoid having a single
-    // global manager that would create a lot of issues regarding creation and destruction order.
-    FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
-    {
-        err() << "Failed to load font from stream (failed to initialize FreeType)" << std::endl;
-        return false;
-    }
-    m_library = library;
 
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
@@ -286,48 +677,16 @@ bool Font::loadFromStream(InputStream& stream)
     rec->read               = &read;
     rec->close              = &close;
 
-    // Setup the FreeType callbacks that will read our stream
-    FT_Open_Args args;
-    args.flags  = FT_OPEN_STREAM;
-    args.stream = rec;
-    args.driver = 0;
-
-    // Load the new font face from the specified stream
-    FT_Face face;
-    if (FT_Open_Face(static_cast<FT_Library>(m_library), &args, 0, &face) != 0)
-    {
-        err() << "Failed to load font from stream (failed to create the font face)" << std::endl;
-        delete rec;
-        return false;
-    }
-
-    // Load the stroker that will be used to outline the font
-    FT_Stroker stroker;
-    if (FT_Stroker_New(static_cast<FT_Library>(m_library), &stroker) != 0)
-    {
-        err() << "Failed to load font from stream (failed to create the stroker)" << std::endl;
-        FT_Done_Face(face);
-        delete rec;
-        return false;
-    }
-
-    // Select the Unicode character map
-    if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+    // Load the font face from the specified stream (the face is not shared, streams can't be identified)
+    if (!openFace(std::string(), NULL, 0, rec, "from stream"))
     {
-        err() << "Failed to load font from stream (failed to set the Unicode character set)" << std::endl;
-        FT_Done_Face(face);
-        FT_Stroker_Done(stroker);
         delete rec;
         return false;
     }
 
-    // Store the loaded font in our ugly void* :)
-    m_stroker = stroker;
-    m_face = face;
-    m_streamRec = rec;
-
     // Store the font information
-    m_info.family = face->family_name ? face->family_name : std::string();
+    m_info.family = static_cast<FT_Face>(m_face)->family_name ? static_cast<FT_Face>(m_face)->family_name : std::string();
+    m_streamRec = rec;
 
     return true;
 }
@@ -343,82 +702,254 @@ const Font::Info& Font::getInfo() const
 ////////////////////////////////////////////////////////////
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
-    // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    // The face, its stroker and the glyph cache may be shared with fonts used by other threads
+    FaceLock lock(m_faceMutex);
+
+    // Get the glyphs corresponding to the character size
+    GlyphTable& glyphs = getGlyphSet(characterSize).glyphs;
 
-    // Build the key by combining the glyph index (based on code point), bold flag, and outline thickness
-    Uint64 key = combine(outlineThickness, bold, FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint));
+    // Fast path for ASCII characters without outline, that don't need to be hashed
+    if ((codePoint < 128) && (outlineThickness == 0))
+    {
+        Uint32 index = glyphs.ascii[bold ? 1 : 0][codePoint];
+        if (index > 0)
+        {
+            const Glyph& glyph = glyphs.glyphs[index - 1];
+            usePage(glyph.page);
+            ++m_cache->hitCount;
+            return glyph;
+        }
+    }
+
+    // Build the key by combining the code point, bold flag, and outline thickness
+    Uint64 key = combine(outlineThickness, bold, codePoint);
 
     // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+    const Glyph* glyph = glyphs.find(key);
+    if (glyph)
     {
         // Found: just return it
-        return it->second;
+        usePage(glyph->page);
+        ++m_cache->hitCount;
+        return *glyph;
     }
     else
     {
         // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        const Glyph& newGlyph = glyphs.insert(key, loadGlyph(codePoint, characterSize, bold, outlineThickness));
+        usePage(newGlyph.page);
+        ++m_cache->missCount;
+        return newGlyph;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
+void Font::preload(const String& charset, unsigned int characterSize, bool bold, float outlineThickness) const
 {
-    // Special case where first or second is 0 (null character)
-    if (first == 0 || second == 0)
-        return 0.f;
+    FaceLock lock(m_faceMutex);
 
     FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face || charset.isEmpty())
+        return;
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
-    {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+    // Distance field glyphs are rasterized at the reference size only,
+    // the requested variants are derived from them at the end
+    unsigned int rasterSize    = m_cache->distanceField ? static_cast<unsigned int>(DistanceFieldSize) : characterSize;
+    bool         rasterBold    = m_cache->distanceField ? false : bold;
+    float        rasterOutline = m_cache->distanceField ? 0.f : outlineThickness;
 
-        // Get the kerning vector
-        FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+    if (!setCurrentSize(rasterSize))
+        return;
 
-        // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+    GlyphSet& glyphSet = getGlyphSet(rasterSize);
 
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
-    }
-    else
+    // Collect the glyphs that are not loaded yet
+    std::vector<PreloadedGlyph> glyphs;
+    std::set<Uint64> keys;
+    for (std::size_t i = 0; i < charset.getSize(); ++i)
     {
-        // Invalid font, or no kerning
-        return 0.f;
+        Uint64 key = combine(rasterOutline, rasterBold, charset[i]);
+        if (!glyphSet.glyphs.find(key) && keys.insert(key).second)
+        {
+            glyphs.push_back(PreloadedGlyph());
+            glyphs.back().codePoint = charset[i];
+            glyphs.back().key = key;
+            glyphs.back().done = false;
+        }
     }
-}
-
-
-////////////////////////////////////////////////////////////
-float Font::getLineSpacing(unsigned int characterSize) const
-{
-    FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && setCurrentSize(characterSize))
-    {
-        return static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
-    }
-    else
+    if (!glyphs.empty())
     {
-        return 0.f;
-    }
-}
+        // Fonts loaded from a stream can't be opened again by other threads
+        std::size_t threadCount = 1;
+        if (!m_fileName.empty() || m_fileData)
+            threadCount = std::max<std::size_t>(std::min(maxPreloadThreads, glyphs.size() / glyphsPerPreloadThread), 1);
+
+        PreloadJob job;
+        job.fileName         = &m_fileName;
+        job.fileData         = m_fileData;
+        job.fileSize         = m_fileSize;
+        job.characterSize    = rasterSize;
+        job.bold             = rasterBold;
+        job.outlineThickness = rasterOutline;
+        job.distanceField    = m_cache->distanceField;
+        job.padding          = getGlyphPadding();
+        job.glyphs           = &glyphs;
+        job.first            = 0;
+        job.step             = threadCount;
+
+        // Start the worker threads, and take the first share on the calling thread with the font's own face
+        std::vector<PreloadJob> jobs(threadCount, job);
+        std::vector<Thread*> threads;
+        for (std::size_t i = 1; i < threadCount; ++i)
+        {
+            jobs[i].first = i;
+            threads.push_back(new Thread(&preloadThread, &jobs[i]));
+            threads.back()->launch();
+        }
 
+        rasterizeGlyphs(static_cast<FT_Library>(m_library), face, static_cast<FT_Stroker>(m_stroker), jobs[0]);
 
-////////////////////////////////////////////////////////////
-float Font::getUnderlinePosition(unsigned int characterSize) const
-{
-    FT_Face face = static_cast<FT_Face>(m_face);
+        for (std::size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i]->wait();
+            delete threads[i];
+        }
+
+        // Give a second chance to the glyphs that a thread failed to rasterize
+        for (std::size_t i = 0; i < glyphs.size(); ++i)
+        {
+            if (!glyphs[i].done)
+                glyphs[i].done = rasterizeGlyph(static_cast<FT_Library>(m_library), face, static_cast<FT_Stroker>(m_stroker), glyphs[i].codePoint,
+                                                rasterBold, rasterOutline, m_cache->distanceField, job.padding, glyphs[i].pixels, glyphs[i].glyph);
+        }
+
+        // Place all the glyphs into the pages, and gather their pixels by page
+        std::map<unsigned int, PageUpload> uploads;
+        for (std::size_t i = 0; i < glyphs.size(); ++i)
+        {
+            Glyph glyph = glyphs[i].done ? glyphs[i].glyph : Glyph();
+            glyph.page = m_cache->sharedAtlas ? 0 : glyphSet.page;
+
+            if ((glyph.textureRect.width > 0) && (glyph.textureRect.height > 0))
+            {
+                IntRect rect = findGlyphRect(glyphSet, glyph.textureRect.width, glyph.textureRect.height, glyph.page);
+
+                // Areas allocated in a page that has been cleared since then are obsolete
+                PageUpload& upload = uploads[glyph.page];
+                if (upload.evictionCount != m_cache->pages[glyph.page].evictionCount)
+                {
+                    upload.pixels.clear();
+                    upload.rects.clear();
+                    upload.evictionCount = m_cache->pages[glyph.page].evictionCount;
+                }
+
+                upload.pixels.insert(upload.pixels.end(), glyphs[i].pixels.begin(), glyphs[i].pixels.begin() + rect.width * rect.height * 4);
+                upload.rects.push_back(rect);
+
+                unsigned int padding = job.padding;
+                glyph.textureRect = IntRect(rect.left + padding, rect.top + padding, rect.width - 2 * padding, rect.height - 2 * padding);
+            }
+
+            glyphSet.glyphs.insert(glyphs[i].key, glyph);
+        }
+
+        // Write them with one texture update per page
+        for (std::map<unsigned int, PageUpload>::const_iterator it = uploads.begin(); it != uploads.end(); ++it)
+        {
+            if (!it->second.rects.empty() && (it->second.evictionCount == m_cache->pages[it->first].evictionCount))
+                m_cache->pages[it->first].texture.update(&it->second.pixels[0], &it->second.rects[0], it->second.rects.size());
+        }
+    }
+
+    // Derive the requested distance field variants, which is cheap
+    if (m_cache->distanceField && ((characterSize != DistanceFieldSize) || bold || (outlineThickness != 0)))
+    {
+        for (std::size_t i = 0; i < charset.getSize(); ++i)
+            getGlyph(charset[i], characterSize, bold, outlineThickness);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
+{
+    FaceLock lock(m_faceMutex);
+
+    // Special case where first or second is 0 (null character)
+    if (first == 0 || second == 0)
+        return 0.f;
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    if (face && FT_HAS_KERNING(face))
+    {
+        // Search the pair into the cache
+        KerningTable& table = m_cache->kerningTables[characterSize];
+        table.lastUse = ++m_cache->useClock;
+        Uint64 pair = (static_cast<Uint64>(first) << 32) | second;
+
+        float result;
+        if (table.find(pair, result))
+            return result;
+
+        if (!setCurrentSize(characterSize))
+            return 0.f;
+
+        // Convert the characters to indices
+        FT_UInt index1 = FT_Get_Char_Index(face, first);
+        FT_UInt index2 = FT_Get_Char_Index(face, second);
+
+        // Get the kerning vector
+        FT_Vector kerning;
+        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+
+        // X advance is already in pixels for bitmap fonts
+        result = static_cast<float>(kerning.x);
+        if (FT_IS_SCALABLE(face))
+            result /= static_cast<float>(1 << 6);
+
+        // Return the X advance; if the table has grown, make room for it within the memory budget
+        Uint64 usedBytes = table.getMemoryUsage();
+        table.insert(pair, result);
+        if (table.getMemoryUsage() > usedBytes)
+            reduceMemory(0, static_cast<unsigned int>(m_cache->pages.size()), &table);
+
+        return result;
+    }
+    else
+    {
+        // Invalid font, or no kerning
+        return 0.f;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getLineSpacing(unsigned int characterSize) const
+{
+    FaceLock lock(m_faceMutex);
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    if (face && setCurrentSize(characterSize))
+    {
+        return static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
+    }
+    else
+    {
+        return 0.f;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getUnderlinePosition(unsigned int characterSize) const
+{
+    FaceLock lock(m_faceMutex);
+
+    FT_Face face = static_cast<FT_Face>(m_face);
 
     if (face && setCurrentSize(characterSize))
     {
@@ -438,6 +969,8 @@ float Font::getUnderlinePosition(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 float Font::getUnderlineThickness(unsigned int characterSize) const
 {
+    FaceLock lock(m_faceMutex);
+
     FT_Face face = static_cast<FT_Face>(m_face);
 
     if (face && setCurrentSize(characterSize))
@@ -458,7 +991,160 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    FaceLock lock(m_faceMutex);
+
+    if (m_cache->sharedAtlas)
+    {
+        if (m_cache->pages.empty())
+            addPage();
+
+        return m_cache->pages[0].texture;
+    }
+
+    return m_cache->pages[getGlyphSet(characterSize).page].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& Font::getPageTexture(unsigned int page) const
+{
+    FaceLock lock(m_faceMutex);
+
+    if (page >= m_cache->pages.size())
+    {
+        static const Texture empty;
+        return empty;
+    }
+
+    return m_cache->pages[page].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getPageCount() const
+{
+    FaceLock lock(m_faceMutex);
+
+    return static_cast<unsigned int>(m_cache->pages.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setSharedAtlas(bool shared)
+{
+    FaceLock lock(m_faceMutex);
+
+    if (shared != m_cache->sharedAtlas)
+    {
+        // The glyphs are laid out differently in the two modes: start over
+        detachCache();
+        m_cache->sharedAtlas = shared;
+        m_cache->glyphSets.clear();
+        m_cache->pages.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isSharedAtlas() const
+{
+    return m_cache->sharedAtlas;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setDistanceField(bool enabled)
+{
+    FaceLock lock(m_faceMutex);
+
+    if (enabled != m_cache->distanceField)
+    {
+        // Distance field and coverage glyphs can't be mixed: start over
+        detachCache();
+        m_cache->distanceField = enabled;
+        m_cache->glyphSets.clear();
+        m_cache->pages.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isDistanceField() const
+{
+    return m_cache->distanceField;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setAtlasPacking(AtlasPacking packing)
+{
+    FaceLock lock(m_faceMutex);
+
+    if (packing != m_cache->packing)
+    {
+        detachCache();
+        m_cache->packing = packing;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Font::AtlasPacking Font::getAtlasPacking() const
+{
+    return m_cache->packing;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setMemoryBudget(std::size_t bytes)
+{
+    FaceLock lock(m_faceMutex);
+
+    if (bytes != m_cache->memoryBudget)
+    {
+        detachCache();
+        m_cache->memoryBudget = bytes;
+    }
+
+    // Apply a lower budget right away
+    reduceMemory(0, static_cast<unsigned int>(m_cache->pages.size()));
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getMemoryBudget() const
+{
+    return m_cache->memoryBudget;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::AtlasStats Font::getAtlasStats() const
+{
+    FaceLock lock(m_faceMutex);
+
+    AtlasStats stats;
+
+    for (GlyphSetTable::const_iterator it = m_cache->glyphSets.begin(); it != m_cache->glyphSets.end(); ++it)
+        stats.glyphCount += static_cast<unsigned int>(it->second.glyphs.size());
+
+    for (PageArray::const_iterator it = m_cache->pages.begin(); it != m_cache->pages.end(); ++it)
+    {
+        stats.pageCount++;
+        stats.usedPixels    += it->packer->getUsedArea();
+        stats.texturePixels += static_cast<Uint64>(it->texture.getSize().x) * it->texture.getSize().y;
+        stats.regrowthCount += it->regrowthCount;
+    }
+
+    stats.hitCount          = m_cache->hitCount;
+    stats.missCount         = m_cache->missCount;
+    stats.evictionCount     = m_cache->evictionCount;
+    stats.pageEvictionCount = m_cache->pageEvictions;
+
+    if (stats.texturePixels > 0)
+        stats.fillRatio = static_cast<float>(static_cast<double>(stats.usedPixels) / static_cast<double>(stats.texturePixels));
+
+    return stats;
 }
 
 
@@ -467,14 +1153,19 @@ Font& Font::operator =(const Font& right)
 {
     Font temp(right);
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_stroker,     temp.m_stroker);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    std::swap(m_library,      temp.m_library);
+    std::swap(m_face,         temp.m_face);
+    std::swap(m_streamRec,    temp.m_streamRec);
+    std::swap(m_stroker,      temp.m_stroker);
+    std::swap(m_refCount,     temp.m_refCount);
+    std::swap(m_faceMutex,    temp.m_faceMutex);
+    std::swap(m_info,         temp.m_info);
+    std::swap(m_fileName,     temp.m_fileName);
+    std::swap(m_fileData,     temp.m_fileData);
+    std::swap(m_fileSize,     temp.m_fileSize);
+    std::swap(m_pixelBuffer,  temp.m_pixelBuffer);
+    std::swap(m_fieldShaders, temp.m_fieldShaders);
+    std::swap(m_cache,        temp.m_cache);
 
     #ifdef SFML_SYSTEM_ANDROID
         std::swap(m_stream, temp.m_stream);
@@ -487,6 +1178,8 @@ Font& Font::operator =(const Font& right)
 ////////////////////////////////////////////////////////////
 void Font::cleanup()
 {
+    Lock lock(registryMutex);
+
     // Check if we must destroy the FreeType pointers
     if (m_refCount)
     {
@@ -496,8 +1189,19 @@ void Font::cleanup()
         // Free the resources only if we are the last owner
         if (*m_refCount == 0)
         {
-            // Delete the reference counter
+            // Delete the reference counter, and the mutex which is not shared anymore
             delete m_refCount;
+            delete m_faceMutex;
+
+            // Forget the face, so that it is not shared anymore
+            for (FaceRegistry::iterator it = faceRegistry.begin(); it != faceRegistry.end(); ++it)
+            {
+                if (it->second.face == m_face)
+                {
+                    faceRegistry.erase(it);
+                    break;
+                }
+            }
 
             // Destroy the stroker
             if (m_stroker)
@@ -511,23 +1215,172 @@ void Font::cleanup()
             if (m_streamRec)
                 delete static_cast<FT_StreamRec*>(m_streamRec);
 
-            // Close the library
+            // Release the library
             if (m_library)
-                FT_Done_FreeType(static_cast<FT_Library>(m_library));
+                releaseLibrary();
         }
     }
 
+    // Leave the glyph cache to the fonts still sharing it, or clear it;
+    // either way the font keeps its settings
+    if (m_cache->refCount > 1)
+    {
+        Cache* cache = new Cache;
+        cache->copySettings(*m_cache);
+        m_cache->refCount--;
+        m_cache = cache;
+    }
+    else
+    {
+        unregisterCache(m_cache);
+        m_cache->clear();
+    }
+
     // Reset members
     m_library   = NULL;
     m_face      = NULL;
     m_stroker   = NULL;
     m_streamRec = NULL;
     m_refCount  = NULL;
-    m_pages.clear();
+    m_faceMutex = NULL;
+    m_fileName.clear();
+    m_fileData  = NULL;
+    m_fileSize  = 0;
     std::vector<Uint8>().swap(m_pixelBuffer);
 }
 
 
+////////////////////////////////////////////////////////////
+bool Font::openFace(const std::string& fileName, const void* data, std::size_t size, void* stream, const std::string& source)
+{
+    Lock lock(registryMutex);
+
+    // Share the face if it is already open, and its glyph cache if the settings match
+    FaceKey key(fileName, std::make_pair(data, size));
+    if (!stream)
+    {
+        FaceRegistry::iterator it = faceRegistry.find(key);
+        if (it != faceRegistry.end())
+        {
+            m_library  = sharedLibrary;
+            m_face     = it->second.face;
+            m_stroker  = it->second.stroker;
+            m_refCount  = it->second.refCount;
+            m_faceMutex = it->second.mutex;
+            (*m_refCount)++;
+
+            Cache* cache = static_cast<Cache*>(it->second.cache);
+            if (!cache)
+            {
+                it->second.cache = m_cache;
+            }
+            else if (cache->hasSettingsOf(*m_cache))
+            {
+                // The font's own cache was cleared and is not shared: it can be dropped
+                delete m_cache;
+                m_cache = cache;
+                m_cache->refCount++;
+            }
+
+            return true;
+        }
+    }
+
+    // Get the FreeType library shared by all the fonts
+    FT_Library library = acquireLibrary();
+    if (!library)
+    {
+        err() << "Failed to load font " << source << " (failed to initialize FreeType)" << std::endl;
+        return false;
+    }
+
+    // Load the new font face
+    FT_Face face;
+    FT_Error error;
+    if (!fileName.empty())
+    {
+        error = FT_New_Face(library, fileName.c_str(), 0, &face);
+    }
+    else if (!stream)
+    {
+        error = FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(size), 0, &face);
+    }
+    else
+    {
+        // Setup the FreeType callbacks that will read our stream
+        FT_Open_Args args;
+        args.flags  = FT_OPEN_STREAM;
+        args.stream = static_cast<FT_StreamRec*>(stream);
+        args.driver = 0;
+
+        error = FT_Open_Face(library, &args, 0, &face);
+    }
+
+    if (error != 0)
+    {
+        err() << "Failed to load font " << source << " (failed to create the font face)" << std::endl;
+        releaseLibrary();
+        return false;
+    }
+
+    // Load the stroker that will be used to outline the font
+    FT_Stroker stroker;
+    if (FT_Stroker_New(library, &stroker) != 0)
+    {
+        err() << "Failed to load font " << source << " (failed to create the stroker)" << std::endl;
+        FT_Done_Face(face);
+        releaseLibrary();
+        return false;
+    }
+
+    // Select the Unicode character map
+    if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+    {
+        err() << "Failed to load font " << source << " (failed to set the Unicode character set)" << std::endl;
+        FT_Stroker_Done(stroker);
+        FT_Done_Face(face);
+        releaseLibrary();
+        return false;
+    }
+
+    // Store the loaded font in our ugly void* :)
+    m_library   = library;
+    m_stroker   = stroker;
+    m_face      = face;
+    m_refCount  = new int(1);
+    m_faceMutex = new Mutex;
+
+    // Register the face, with the font's cache, so that other fonts can share them
+    if (!stream)
+    {
+        SharedFace shared;
+        shared.face     = face;
+        shared.stroker  = stroker;
+        shared.refCount = m_refCount;
+        shared.mutex    = m_faceMutex;
+        shared.cache    = m_cache;
+        faceRegistry.insert(std::make_pair(key, shared));
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::detachCache()
+{
+    Lock lock(registryMutex);
+
+    if (m_cache->refCount > 1)
+    {
+        Cache* cache = new Cache;
+        cache->copySettings(*m_cache);
+        m_cache->refCount--;
+        m_cache = cache;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
@@ -539,219 +1392,333 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
     if (!face)
         return glyph;
 
+    // Distance field glyphs are rasterized only once, at the reference size
+    if (m_cache->distanceField && ((characterSize != DistanceFieldSize) || bold || (outlineThickness != 0)))
+        return scaleDistanceFieldGlyph(codePoint, characterSize, bold, outlineThickness);
+
     // Set the character size
     if (!setCurrentSize(characterSize))
         return glyph;
 
-    // Load the glyph corresponding to the code point
-    FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
-    if (outlineThickness != 0)
-        flags |= FT_LOAD_NO_BITMAP;
-    if (FT_Load_Char(face, codePoint, flags) != 0)
-        return glyph;
+    // Empty glyphs still refer to a valid page, so that they don't break batches
+    const GlyphSet& glyphSet = getGlyphSet(characterSize);
+    glyph.page = m_cache->sharedAtlas ? 0 : glyphSet.page;
 
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+    // Rasterize the glyph
+    unsigned int padding = getGlyphPadding();
+    if (!rasterizeGlyph(static_cast<FT_Library>(m_library), face, static_cast<FT_Stroker>(m_stroker), codePoint, bold, outlineThickness, m_cache->distanceField, padding, m_pixelBuffer, glyph))
         return glyph;
 
-    // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (outline)
+    // Find a good position for the new glyph into the textures, and write its pixels
+    if ((glyph.textureRect.width > 0) && (glyph.textureRect.height > 0))
     {
-        if (bold)
-        {
-            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-            FT_Outline_Embolden(&outlineGlyph->outline, weight);
-        }
+        IntRect rect = findGlyphRect(glyphSet, glyph.textureRect.width, glyph.textureRect.height, glyph.page);
+        m_cache->pages[glyph.page].texture.update(&m_pixelBuffer[0], rect.width, rect.height, rect.left, rect.top);
 
-        if (outlineThickness != 0)
-        {
-            FT_Stroker stroker = static_cast<FT_Stroker>(m_stroker);
-
-            FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
-            FT_Glyph_Stroke(&glyphDesc, stroker, true);
-        }
+        // Make sure the texture data is positioned in the center
+        // of the allocated texture rectangle
+        glyph.textureRect = IntRect(rect.left + padding, rect.top + padding, rect.width - 2 * padding, rect.height - 2 * padding);
     }
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+    return glyph;
+}
 
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (!outline)
-    {
-        if (bold)
-            FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
 
-        if (outlineThickness != 0)
-            err() << "Failed to outline glyph (no fallback available)" << std::endl;
-    }
+////////////////////////////////////////////////////////////
+unsigned int Font::getGlyphPadding() const
+{
+    // Leave a small padding around characters, so that filtering doesn't
+    // pollute them with pixels from neighbors; distance fields also
+    // need room around the glyph for the distances they encode
+    return m_cache->distanceField ? DistanceFieldSpread + 1 : 1;
+}
 
-    // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
-    if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
+////////////////////////////////////////////////////////////
+Glyph Font::scaleDistanceFieldGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    // All the variants share the pixels of the reference glyph
+    Glyph glyph = getGlyph(codePoint, DistanceFieldSize, false, 0);
+
+    float scale = static_cast<float>(characterSize) / static_cast<float>(DistanceFieldSize);
+    glyph.advance       *= scale;
+    glyph.bounds.left   *= scale;
+    glyph.bounds.top    *= scale;
+    glyph.bounds.width  *= scale;
+    glyph.bounds.height *= scale;
+
+    // Follow the same conventions as the rasterized glyphs; the bold
+    // and outline shapes themselves are produced by the shader
+    if (bold)
+        glyph.advance += 1.f;
 
-    if ((width > 0) && (height > 0))
+    if ((glyph.textureRect.width > 0) && (glyph.textureRect.height > 0))
     {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 1;
+        glyph.bounds.width  += outlineThickness * 2;
+        glyph.bounds.height += outlineThickness * 2;
+    }
+
+    return glyph;
+}
 
-        width += 2 * padding;
-        height += 2 * padding;
 
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+////////////////////////////////////////////////////////////
+const Shader* Font::getDistanceFieldShader(float threshold) const
+{
+    if (!Shader::isAvailable())
+        return NULL;
+
+    // Quantize the threshold so that the number of shaders stays bounded
+    int level = static_cast<int>(std::min(std::max(threshold, 0.f), 1.f) * 1024.f + 0.5f);
 
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width, height);
+    ShaderTable::const_iterator it = m_fieldShaders.find(level);
+    if (it != m_fieldShaders.end())
+        return it->second;
 
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
+    // Try the flavour matching the current context first, then the other one
+    Shader* shader = new Shader;
+    bool loaded = false;
+    if (priv::isCoreProfile())
+        loaded = shader->loadFromMemory(distanceFieldCoreVertexShader, distanceFieldCoreFragmentShader) ||
+                 shader->loadFromMemory(distanceFieldFragmentShader, Shader::Fragment);
+    else
+        loaded = shader->loadFromMemory(distanceFieldFragmentShader, Shader::Fragment) ||
+                 shader->loadFromMemory(distanceFieldCoreVertexShader, distanceFieldCoreFragmentShader);
 
-        // Compute the glyph's bounding box
-        glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
-        glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+    if (loaded)
+    {
+        shader->setUniform("sf_texture", Shader::CurrentTexture);
+        shader->setUniform("threshold", static_cast<float>(level) / 1024.f);
+    }
+    else
+    {
+        // Remember the failure, so that we don't try again for every draw
+        err() << "Failed to compile the distance field shader, glyphs will be drawn without it" << std::endl;
+        delete shader;
+        shader = NULL;
+    }
 
-        // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(width * height * 4);
+    m_fieldShaders.insert(std::make_pair(level, shader));
+    return shader;
+}
 
-        Uint8* current = &m_pixelBuffer[0];
-        Uint8* end = current + width * height * 4;
 
-        while (current != end)
+////////////////////////////////////////////////////////////
+IntRect Font::findGlyphRect(const GlyphSet& glyphSet, unsigned int width, unsigned int height, unsigned int& page) const
+{
+    IntRect rect;
+
+    if (!m_cache->sharedAtlas)
+    {
+        // The character size has its own page, which grows as much as needed
+        page = glyphSet.page;
+        while (!m_cache->pages[page].packer->insert(width, height, rect))
         {
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 0;
+            // Make room for the larger texture by evicting the other sizes, if needed
+            Vector2u size = m_cache->pages[page].texture.getSize();
+            reduceMemory(static_cast<Uint64>(size.x) * size.y * 4, page);
+
+            if (!growPage(m_cache->pages[page], Texture::getMaximumSize()))
+            {
+                // Oops, we've reached the maximum texture size...
+                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+                return IntRect(0, 0, 2, 2);
+            }
         }
 
-        // Extract the glyph's pixels from the bitmap
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        usePage(page);
+        return rect;
+    }
+
+    // Shared pages are kept reasonably small, so that filling one doesn't
+    // trigger huge texture copies; a new page is started instead
+    const unsigned int maximumSize = std::min(Texture::getMaximumSize(), 4096u);
+
+    // First try to fit the glyph in the free space of the existing pages; if the atlas
+    // can't be enlarged within the memory budget, clear the least recently used page and retry
+    for (;;)
+    {
+        for (page = 0; page < m_cache->pages.size(); ++page)
         {
-            // Pixels are 1 bit monochrome values
-            for (unsigned int y = padding; y < height - padding; ++y)
+            if (m_cache->pages[page].packer->insert(width, height, rect))
             {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
+                usePage(page);
+                return rect;
             }
         }
-        else
+
+        Vector2u size = m_cache->pages.back().texture.getSize();
+        if (!reduceMemory(static_cast<Uint64>(size.x) * size.y * 4, static_cast<unsigned int>(m_cache->pages.size())))
+            break;
+    }
+
+    // Then enlarge the last page, or start a new one
+    page = static_cast<unsigned int>(m_cache->pages.size() - 1);
+    bool newPage = false;
+    while (!m_cache->pages[page].packer->insert(width, height, rect))
+    {
+        if (!growPage(m_cache->pages[page], maximumSize))
         {
-            // Pixels are 8 bits gray levels
-            for (unsigned int y = padding; y < height - padding; ++y)
+            if (newPage)
             {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
-                }
-                pixels += bitmap.pitch;
+                // The glyph doesn't even fit in an empty page
+                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+                return IntRect(0, 0, 2, 2);
             }
-        }
 
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left - padding;
-        unsigned int y = glyph.textureRect.top - padding;
-        unsigned int w = glyph.textureRect.width + 2 * padding;
-        unsigned int h = glyph.textureRect.height + 2 * padding;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
+            page = addPage();
+            newPage = true;
+        }
     }
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
+    usePage(page);
+    return rect;
+}
 
-    // Done :)
-    return glyph;
+
+////////////////////////////////////////////////////////////
+bool Font::growPage(Page& page, unsigned int maximumSize) const
+{
+    // Only one dimension is doubled at a time (the smallest one), which keeps
+    // the texture square-ish while halving the amount of memory allocated
+    // and copied compared to doubling both dimensions
+    unsigned int textureWidth  = page.texture.getSize().x;
+    unsigned int textureHeight = page.texture.getSize().y;
+
+    bool canGrowWidth  = textureWidth * 2 <= maximumSize;
+    bool canGrowHeight = textureHeight * 2 <= maximumSize;
+    if (canGrowWidth && (!canGrowHeight || (textureWidth <= textureHeight)))
+        textureWidth *= 2;
+    else if (canGrowHeight)
+        textureHeight *= 2;
+    else
+        return false;
+
+    Texture newTexture;
+    if (!newTexture.create(textureWidth, textureHeight))
+        return false;
+
+    newTexture.setSmooth(true);
+    newTexture.update(page.texture);
+    page.texture.swap(newTexture);
+    page.packer->grow(textureWidth, textureHeight);
+    page.regrowthCount++;
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+void Font::usePage(unsigned int page) const
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
-    {
-        float ratio = static_cast<float>(height) / it->height;
+    if (page < m_cache->pages.size())
+        m_cache->pages[page].lastUse = ++m_cache->useClock;
+}
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
 
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
+////////////////////////////////////////////////////////////
+bool Font::reduceMemory(Uint64 extraBytes, unsigned int keepPage, const KerningTable* keepTable) const
+{
+    if (m_cache->memoryBudget == 0)
+        return false;
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
+    Uint64 usedBytes = extraBytes;
+    for (PageArray::const_iterator it = m_cache->pages.begin(); it != m_cache->pages.end(); ++it)
+        usedBytes += static_cast<Uint64>(it->texture.getSize().x) * it->texture.getSize().y * 4;
+    for (KerningTableTable::const_iterator it = m_cache->kerningTables.begin(); it != m_cache->kerningTables.end(); ++it)
+        usedBytes += it->second.getMemoryUsage();
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
-    }
+    // Pages and tables used since the start of the layouts in progress are kept, even if it exceeds the budget
+    Uint64 protectedUse = (m_cache->layoutDepth > 0) ? m_cache->layoutStart : m_cache->useClock;
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
+    bool evicted = false;
+    while (usedBytes > m_cache->memoryBudget)
     {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
+        // Find the least recently used page (empty pages have nothing to free)
+        unsigned int oldest = keepPage;
+        for (unsigned int i = 0; i < m_cache->pages.size(); ++i)
         {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
-            {
-                // Make the texture 2 times bigger
-                Texture newTexture;
-                newTexture.create(textureWidth * 2, textureHeight * 2);
-                newTexture.setSmooth(true);
-                newTexture.update(page.texture);
-                page.texture.swap(newTexture);
-            }
-            else
-            {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
-                return IntRect(0, 0, 2, 2);
-            }
+            const Page& page = m_cache->pages[i];
+            if ((i != keepPage) && (page.lastUse > 0) && (page.lastUse <= protectedUse) &&
+                ((oldest == keepPage) || (page.lastUse < m_cache->pages[oldest].lastUse)))
+                oldest = i;
+        }
+
+        // Find the least recently used kerning table
+        KerningTableTable::iterator oldestTable = m_cache->kerningTables.end();
+        for (KerningTableTable::iterator it = m_cache->kerningTables.begin(); it != m_cache->kerningTables.end(); ++it)
+        {
+            if ((&it->second != keepTable) && (it->second.lastUse <= protectedUse) &&
+                ((oldestTable == m_cache->kerningTables.end()) || (it->second.lastUse < oldestTable->second.lastUse)))
+                oldestTable = it;
+        }
+
+        // Evict the oldest of both
+        bool hasPage = (oldest != keepPage);
+        bool hasTable = (oldestTable != m_cache->kerningTables.end());
+        if (hasTable && (!hasPage || (oldestTable->second.lastUse < m_cache->pages[oldest].lastUse)))
+        {
+            usedBytes -= oldestTable->second.getMemoryUsage();
+            m_cache->kerningTables.erase(oldestTable);
         }
+        else if (hasPage)
+        {
+            Vector2u size = m_cache->pages[oldest].texture.getSize();
+            usedBytes -= static_cast<Uint64>(size.x) * size.y * 4;
+
+            evictPage(oldest);
+            evicted = true;
 
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
+            size = m_cache->pages[oldest].texture.getSize();
+            usedBytes += static_cast<Uint64>(size.x) * size.y * 4;
+        }
+        else
+        {
+            // Everything left is in use
+            break;
+        }
     }
 
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
+    return evicted;
+}
 
-    // Update the row informations
-    row->width += width;
 
-    return rect;
+////////////////////////////////////////////////////////////
+void Font::beginLayout() const
+{
+    // Keep the face locked until the matching endLayout
+    if (m_faceMutex)
+        m_faceMutex->lock();
+
+    if (m_cache->layoutDepth++ == 0)
+        m_cache->layoutStart = m_cache->useClock;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::endLayout() const
+{
+    if (m_cache->layoutDepth > 0)
+        --m_cache->layoutDepth;
+
+    if (m_faceMutex)
+        m_faceMutex->unlock();
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::evictPage(unsigned int page) const
+{
+    // Remove the glyphs of the page from all the character sizes
+    for (GlyphSetTable::iterator it = m_cache->glyphSets.begin(); it != m_cache->glyphSets.end(); ++it)
+        m_cache->evictionCount += it->second.glyphs.removePage(page);
+
+    // Start over with an empty texture, which compacts the glyphs that are loaded again
+    unsigned int evictionCount = m_cache->pages[page].evictionCount + 1;
+    m_cache->pages[page] = Page(m_cache->packing);
+    m_cache->pages[page].evictionCount = evictionCount;
+
+    ++m_cache->pageEvictions;
 }
 
 
@@ -797,8 +1764,57 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 
 
 ////////////////////////////////////////////////////////////
-Font::Page::Page() :
-nextRow(3)
+Font::GlyphSet& Font::getGlyphSet(unsigned int characterSize) const
+{
+    GlyphSetTable::iterator it = m_cache->glyphSets.find(characterSize);
+    if (it == m_cache->glyphSets.end())
+    {
+        it = m_cache->glyphSets.insert(std::make_pair(characterSize, GlyphSet())).first;
+
+        // Give the new size its own page, unless all the sizes share the same ones
+        // (distance field glyphs of all sizes are in the page of the reference size)
+        if (!m_cache->sharedAtlas && m_cache->distanceField && (characterSize != DistanceFieldSize))
+            it->second.page = getGlyphSet(DistanceFieldSize).page;
+        else if (!m_cache->sharedAtlas)
+            it->second.page = addPage();
+        else if (m_cache->pages.empty())
+            addPage();
+    }
+
+    return it->second;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::addPage() const
+{
+    m_cache->pages.push_back(Page(m_cache->packing));
+    return static_cast<unsigned int>(m_cache->pages.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::AtlasStats::AtlasStats() :
+pageCount        (0),
+glyphCount       (0),
+usedPixels       (0),
+texturePixels    (0),
+fillRatio        (0.f),
+regrowthCount    (0),
+hitCount         (0),
+missCount        (0),
+evictionCount    (0),
+pageEvictionCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page::Page(AtlasPacking packing) :
+packer       (NULL),
+regrowthCount(0),
+evictionCount(0),
+lastUse      (0)
 {
     // Make sure that the texture is initialized by default
     sf::Image image;
@@ -812,6 +1828,264 @@ nextRow(3)
     // Create the texture
     texture.loadFromImage(image);
     texture.setSmooth(true);
+
+    // Create the packer, and keep the white square (plus a padding pixel) out of it
+    priv::AtlasPacker::Algorithm algorithm = (packing == MaxRects) ? priv::AtlasPacker::MaxRects : priv::AtlasPacker::Skyline;
+    packer = priv::AtlasPacker::create(algorithm, 128, 128);
+
+    IntRect reserved;
+    packer->insert(3, 3, reserved);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page::Page(const Page& copy) :
+texture      (copy.texture),
+packer       (copy.packer->clone()),
+regrowthCount(copy.regrowthCount),
+evictionCount(copy.evictionCount),
+lastUse      (copy.lastUse)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page::~Page()
+{
+    delete packer;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page& Font::Page::operator =(const Page& right)
+{
+    Page temp(right);
+
+    std::swap(packer,        temp.packer);
+    std::swap(regrowthCount, temp.regrowthCount);
+    std::swap(evictionCount, temp.evictionCount);
+    std::swap(lastUse,       temp.lastUse);
+    texture.swap(temp.texture);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::GlyphTable::GlyphTable()
+{
+    std::fill(&ascii[0][0], &ascii[0][0] + 2 * 128, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph* Font::GlyphTable::find(Uint64 key) const
+{
+    if (slots.empty())
+        return NULL;
+
+    // Probe the slots until the key or an empty slot is found
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t i = hash(key) & mask; slots[i] > 0; i = (i + 1) & mask)
+    {
+        if (keys[i] == key)
+            return &glyphs[slots[i] - 1];
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::GlyphTable::insert(Uint64 key, const Glyph& glyph)
+{
+    // Keep the table at most half full, so that probe sequences stay short
+    if ((glyphs.size() + 1) * 2 > slots.size())
+    {
+        std::size_t capacity = std::max<std::size_t>(slots.size() * 2, 64);
+        std::vector<Uint64> oldKeys(capacity, 0);
+        std::vector<Uint32> oldSlots(capacity, 0);
+        keys.swap(oldKeys);
+        slots.swap(oldSlots);
+
+        for (std::size_t i = 0; i < oldSlots.size(); ++i)
+        {
+            if (oldSlots[i] > 0)
+            {
+                std::size_t j = hash(oldKeys[i]) & (capacity - 1);
+                while (slots[j] > 0)
+                    j = (j + 1) & (capacity - 1);
+
+                keys[j] = oldKeys[i];
+                slots[j] = oldSlots[i];
+            }
+        }
+    }
+
+    glyphs.push_back(glyph);
+    Uint32 index = static_cast<Uint32>(glyphs.size());
+
+    std::size_t mask = slots.size() - 1;
+    std::size_t i = hash(key) & mask;
+    while (slots[i] > 0)
+        i = (i + 1) & mask;
+
+    keys[i] = key;
+    slots[i] = index;
+
+    // Index ASCII glyphs without outline directly as well
+    if (((key >> 32) == 0) && ((key & 0x7FFFFFFF) < 128))
+        ascii[(key >> 31) & 1][key & 0x7F] = index;
+
+    return glyphs.back();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::GlyphTable::removePage(unsigned int page)
+{
+    // Rebuild the table with the glyphs of the other pages
+    GlyphTable table;
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        if ((slots[i] > 0) && (glyphs[slots[i] - 1].page != page))
+            table.insert(keys[i], glyphs[slots[i] - 1]);
+    }
+
+    std::size_t removed = glyphs.size() - table.glyphs.size();
+    if (removed > 0)
+        std::swap(*this, table);
+
+    return removed;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::GlyphTable::size() const
+{
+    return glyphs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Font::KerningTable::KerningTable() :
+count  (0),
+lastUse(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::KerningTable::find(Uint64 pair, float& kerning) const
+{
+    if (pairs.empty())
+        return false;
+
+    // Probe the slots until the pair or an empty slot is found
+    std::size_t mask = pairs.size() - 1;
+    for (std::size_t i = hash(pair) & mask; pairs[i] != 0; i = (i + 1) & mask)
+    {
+        if (pairs[i] == pair)
+        {
+            kerning = values[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::KerningTable::insert(Uint64 pair, float kerning)
+{
+    // Keep the table at most half full, so that probe sequences stay short
+    if ((count + 1) * 2 > pairs.size())
+    {
+        std::size_t capacity = std::max<std::size_t>(pairs.size() * 2, 256);
+        std::vector<Uint64> oldPairs(capacity, 0);
+        std::vector<float> oldValues(capacity, 0.f);
+        pairs.swap(oldPairs);
+        values.swap(oldValues);
+        count = 0;
+
+        for (std::size_t i = 0; i < oldPairs.size(); ++i)
+        {
+            if (oldPairs[i] != 0)
+                insert(oldPairs[i], oldValues[i]);
+        }
+    }
+
+    std::size_t mask = pairs.size() - 1;
+    std::size_t i = hash(pair) & mask;
+    while (pairs[i] != 0)
+        i = (i + 1) & mask;
+
+    pairs[i] = pair;
+    values[i] = kerning;
+    ++count;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Font::KerningTable::getMemoryUsage() const
+{
+    return static_cast<Uint64>(pairs.capacity()) * sizeof(Uint64) + static_cast<Uint64>(values.capacity()) * sizeof(float);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Cache::Cache() :
+glyphSets    (),
+kerningTables(),
+pages        (),
+packing      (Skyline),
+sharedAtlas  (false),
+distanceField(false),
+memoryBudget (0),
+useClock     (0),
+layoutStart  (0),
+layoutDepth  (0),
+hitCount     (0),
+missCount    (0),
+evictionCount(0),
+pageEvictions(0),
+refCount     (1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::Cache::hasSettingsOf(const Cache& other) const
+{
+    return (packing       == other.packing)       &&
+           (sharedAtlas   == other.sharedAtlas)   &&
+           (distanceField == other.distanceField) &&
+           (memoryBudget  == other.memoryBudget);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::Cache::copySettings(const Cache& other)
+{
+    packing       = other.packing;
+    sharedAtlas   = other.sharedAtlas;
+    distanceField = other.distanceField;
+    memoryBudget  = other.memoryBudget;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::Cache::clear()
+{
+    // The page eviction counter is kept: texts compare it to find out if their glyphs were evicted
+    glyphSets.clear();
+    kerningTables.clear();
+    pages.clear();
+    useClock      = 0;
+    hitCount      = 0;
+    missCount     = 0;
+    evictionCount = 0;
 }
 
 } // namespace sf
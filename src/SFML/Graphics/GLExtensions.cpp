@@ -37,6 +37,14 @@
     #define GL_MINOR_VERSION 0x821C
 #endif
 
+#if !defined(GL_CONTEXT_PROFILE_MASK)
+    #define GL_CONTEXT_PROFILE_MASK 0x9126
+#endif
+
+#if !defined(GL_CONTEXT_CORE_PROFILE_BIT)
+    #define GL_CONTEXT_CORE_PROFILE_BIT 0x00000001
+#endif
+
 
 namespace sf
 {
@@ -88,6 +96,30 @@ void ensureExtensionsInit()
 #endif
 }
 
+
+////////////////////////////////////////////////////////////
+bool isCoreProfile()
+{
+#if !defined(SFML_OPENGL_ES)
+
+    // Profiles were introduced with OpenGL 3.2, check the version
+    // first so that we don't generate errors with older contexts
+    const GLubyte* version = glGetString(GL_VERSION);
+    if (!version || (version[0] < '3') || ((version[0] == '3') && (version[2] < '2')))
+        return false;
+
+    GLint profileMask = 0;
+    glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profileMask);
+
+    return (profileMask & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+
+#else
+
+    return false;
+
+#endif
+}
+
 } // namespace priv
 
 } // namespace sf
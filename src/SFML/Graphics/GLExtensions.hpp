@@ -44,6 +44,7 @@
 
     // Core since 1.0
     #define GLEXT_multitexture                        true
+    #define GLEXT_client_multitexture                 true
     #define GLEXT_texture_edge_clamp                  true
     #define GLEXT_EXT_texture_edge_clamp              true
     #define GLEXT_blend_minmax                        true
@@ -57,6 +58,7 @@
     // 1.1 does not support GL_STREAM_DRAW so we just define it to GL_DYNAMIC_DRAW
     #define GLEXT_vertex_buffer_object                true
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW
     #define GLEXT_GL_STREAM_DRAW                      GL_DYNAMIC_DRAW
@@ -136,6 +138,67 @@
     // Core since 3.0 - NV_copy_buffer
     #define GLEXT_copy_buffer                         false
 
+    // Core since 3.0 - EXT_map_buffer_range
+    #define GLEXT_map_buffer_range                    false
+
+    // Core since 3.0 - OES_vertex_array_object
+    #define GLEXT_vertex_array_object                 false
+
+    // Core since 3.0 - APPLE_sync
+    #define GLEXT_sync                                false
+
+    // Core since 3.0 - EXT_draw_instanced
+    #define GLEXT_draw_instanced                      false
+
+    // Core since 3.0 - EXT_instanced_arrays
+    #define GLEXT_instanced_arrays                    false
+
+    // Core since 3.0 - EXT_occlusion_query_boolean
+    #define GLEXT_occlusion_query                     false
+
+    // EXT_disjoint_timer_query
+    #define GLEXT_timer_query                         false
+
+    // Core since 1.0 - compressed textures
+    #define GLEXT_texture_compression                 true
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+
+    // EXT_texture_compression_s3tc
+    #ifdef GL_EXT_texture_compression_s3tc
+        #define GLEXT_texture_compression_s3tc            GL_EXT_texture_compression_s3tc
+    #else
+        #define GLEXT_texture_compression_s3tc            false
+    #endif
+    #define GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1         0x83F0
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1        0x83F1
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3        0x83F2
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5        0x83F3
+    #define GLEXT_GL_COMPRESSED_SRGB_S3TC_DXT1        0x8C4C
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1  0x8C4D
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3  0x8C4E
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5  0x8C4F
+
+    // Core since 3.0 - ETC2/EAC compressed textures
+    #ifdef GL_ES_VERSION_3_0
+        #define GLEXT_texture_compression_etc2            true
+    #else
+        #define GLEXT_texture_compression_etc2            false
+    #endif
+    #define GLEXT_GL_COMPRESSED_RGB8_ETC2             0x9274
+    #define GLEXT_GL_COMPRESSED_SRGB8_ETC2            0x9275
+    #define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC        0x9278
+    #define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0x9279
+
+    // Core since 3.2 - KHR_texture_compression_astc_ldr
+    // (the formats of the other block sizes follow the 4x4 one)
+    #ifdef GL_KHR_texture_compression_astc_ldr
+        #define GLEXT_texture_compression_astc            GL_KHR_texture_compression_astc_ldr
+    #else
+        #define GLEXT_texture_compression_astc            false
+    #endif
+    #define GLEXT_GL_COMPRESSED_RGBA_ASTC_4x4         0x93B0
+    #define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4 0x93D0
+
     // Core since 3.0 - EXT_sRGB
     #ifdef GL_EXT_sRGB
         #define GLEXT_texture_sRGB                        GL_EXT_sRGB
@@ -181,7 +244,9 @@
     #define GLEXT_GL_FUNC_REVERSE_SUBTRACT            GL_FUNC_REVERSE_SUBTRACT_EXT
 
     // Core since 1.3 - ARB_multitexture
+    // The fixed-function glClientActiveTexture is not loaded when ARB_multitexture is promoted to core
     #define GLEXT_multitexture                        sfogl_ext_ARB_multitexture
+    #define GLEXT_client_multitexture                 (glClientActiveTextureARB != NULL)
     #define GLEXT_glClientActiveTexture               glClientActiveTextureARB
     #define GLEXT_glActiveTexture                     glActiveTextureARB
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0_ARB
@@ -193,6 +258,7 @@
     // Core since 1.5 - ARB_vertex_buffer_object
     #define GLEXT_vertex_buffer_object                sfogl_ext_ARB_vertex_buffer_object
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER_ARB
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW_ARB
     #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
@@ -206,6 +272,14 @@
     #define GLEXT_glMapBuffer                         glMapBufferARB
     #define GLEXT_glUnmapBuffer                       glUnmapBufferARB
 
+    // Core since 1.5 - ARB_occlusion_query
+    #define GLEXT_occlusion_query                     sfogl_ext_ARB_occlusion_query
+    #define GLEXT_GL_QUERY_RESULT                     GL_QUERY_RESULT_ARB
+    #define GLEXT_GL_QUERY_RESULT_AVAILABLE           GL_QUERY_RESULT_AVAILABLE_ARB
+    #define GLEXT_glGenQueries                        glGenQueriesARB
+    #define GLEXT_glDeleteQueries                     glDeleteQueriesARB
+    #define GLEXT_glGetQueryObjectiv                  glGetQueryObjectivARB
+
     // Core since 2.0 - ARB_shading_language_100
     #define GLEXT_shading_language_100                sfogl_ext_ARB_shading_language_100
 
@@ -246,6 +320,11 @@
     // Core since 2.0 - ARB_vertex_shader
     #define GLEXT_vertex_shader                       sfogl_ext_ARB_vertex_shader
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
+    #define GLEXT_glGetAttribLocation                 glGetAttribLocationARB
+    #define GLEXT_glBindAttribLocation                glBindAttribLocationARB
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
 
     // Core since 2.0 - ARB_fragment_shader
@@ -312,6 +391,72 @@
     #define GLEXT_geometry_shader4                    sfogl_ext_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    sfogl_ext_ARB_map_buffer_range
+    #define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         GL_MAP_INVALIDATE_RANGE_BIT
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+    #define GLEXT_glMapBufferRange                    glMapBufferRange
+
+    // Core since 3.0 - ARB_vertex_array_object
+    #define GLEXT_vertex_array_object                 sfogl_ext_ARB_vertex_array_object
+    #define GLEXT_glBindVertexArray                   glBindVertexArray
+    #define GLEXT_glDeleteVertexArrays                glDeleteVertexArrays
+    #define GLEXT_glGenVertexArrays                   glGenVertexArrays
+
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                sfogl_ext_ARB_sync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  GL_TIMEOUT_EXPIRED
+    #define GLEXT_GL_WAIT_FAILED                      GL_WAIT_FAILED
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      sfogl_ext_ARB_draw_instanced
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstancedARB
+    #define GLEXT_glDrawElementsInstanced             glDrawElementsInstancedARB
+
+    // Core since 3.3 - ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    sfogl_ext_ARB_instanced_arrays
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisorARB
+
+    // Core since 3.3 - ARB_timer_query
+    #define GLEXT_timer_query                         sfogl_ext_ARB_timer_query
+    #define GLEXT_GL_TIMESTAMP                        GL_TIMESTAMP
+    #define GLEXT_glQueryCounter                      glQueryCounter
+    #define GLEXT_glGetQueryObjectui64v               glGetQueryObjectui64v
+
+    // Core since 1.3 - ARB_texture_compression
+    #define GLEXT_texture_compression                 sfogl_ext_ARB_texture_compression
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2DARB
+
+    // EXT_texture_compression_s3tc
+    #define GLEXT_texture_compression_s3tc            sfogl_ext_EXT_texture_compression_s3tc
+    #define GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1         GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1        GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3        GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5        GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    #define GLEXT_GL_COMPRESSED_SRGB_S3TC_DXT1        GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1  GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3  GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5  GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+
+    // Core since 4.3 - ARB_ES3_compatibility
+    #define GLEXT_texture_compression_etc2            sfogl_ext_ARB_ES3_compatibility
+    #define GLEXT_GL_COMPRESSED_RGB8_ETC2             GL_COMPRESSED_RGB8_ETC2
+    #define GLEXT_GL_COMPRESSED_SRGB8_ETC2            GL_COMPRESSED_SRGB8_ETC2
+    #define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC        GL_COMPRESSED_RGBA8_ETC2_EAC
+    #define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+
+    // KHR_texture_compression_astc_ldr
+    // (the formats of the other block sizes follow the 4x4 one)
+    #define GLEXT_texture_compression_astc            sfogl_ext_KHR_texture_compression_astc_ldr
+    #define GLEXT_GL_COMPRESSED_RGBA_ASTC_4x4         GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+    #define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4 GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR
+
 #endif
 
 namespace sf
@@ -325,6 +470,17 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void ensureExtensionsInit();
 
+////////////////////////////////////////////////////////////
+/// \brief Check whether the active context uses a core profile
+///
+/// The fixed-function pipeline is not available in core
+/// profile contexts.
+///
+/// \return True if the active context is a core profile context
+///
+////////////////////////////////////////////////////////////
+bool isCoreProfile();
+
 } // namespace priv
 
 } // namespace sf
@@ -53,6 +53,17 @@ int sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_occlusion_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_compression = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_texture_compression_s3tc = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_ES3_compatibility = sfogl_LOAD_FAILED;
+int sfogl_ext_KHR_texture_compression_astc_ldr = sfogl_LOAD_FAILED;
 
 void (GL_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -935,6 +946,953 @@ static int Load_ARB_geometry_shader4()
     return numFailed;
 }
 
+void* (GL_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr) = NULL;
+
+static int Load_ARB_map_buffer_range()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glMapBufferRange = reinterpret_cast<void* (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr, GLbitfield)>(glLoaderGetProcAddress("glMapBufferRange"));
+    if (!sf_ptrc_glMapBufferRange)
+        numFailed++;
+
+    sf_ptrc_glFlushMappedBufferRange = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr)>(glLoaderGetProcAddress("glFlushMappedBufferRange"));
+    if (!sf_ptrc_glFlushMappedBufferRange)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync) = NULL;
+GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei*, GLint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsSync)(GLsync) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+
+static int Load_ARB_sync()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glClientWaitSync = reinterpret_cast<GLenum (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glClientWaitSync"));
+    if (!sf_ptrc_glClientWaitSync)
+        numFailed++;
+
+    sf_ptrc_glDeleteSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glDeleteSync"));
+    if (!sf_ptrc_glDeleteSync)
+        numFailed++;
+
+    sf_ptrc_glFenceSync = reinterpret_cast<GLsync (GL_FUNCPTR *)(GLenum, GLbitfield)>(glLoaderGetProcAddress("glFenceSync"));
+    if (!sf_ptrc_glFenceSync)
+        numFailed++;
+
+    sf_ptrc_glGetInteger64v = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint64*)>(glLoaderGetProcAddress("glGetInteger64v"));
+    if (!sf_ptrc_glGetInteger64v)
+        numFailed++;
+
+    sf_ptrc_glGetSynciv = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLenum, GLsizei, GLsizei*, GLint*)>(glLoaderGetProcAddress("glGetSynciv"));
+    if (!sf_ptrc_glGetSynciv)
+        numFailed++;
+
+    sf_ptrc_glIsSync = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glIsSync"));
+    if (!sf_ptrc_glIsSync)
+        numFailed++;
+
+    sf_ptrc_glWaitSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glWaitSync"));
+    if (!sf_ptrc_glWaitSync)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei) = NULL;
+
+static int Load_ARB_draw_instanced()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDrawArraysInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLsizei, GLsizei)>(glLoaderGetProcAddress("glDrawArraysInstancedARB"));
+    if (!sf_ptrc_glDrawArraysInstancedARB)
+        numFailed++;
+
+    sf_ptrc_glDrawElementsInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glDrawElementsInstancedARB"));
+    if (!sf_ptrc_glDrawElementsInstancedARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint) = NULL;
+
+static int Load_ARB_instanced_arrays()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glVertexAttribDivisorARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint)>(glLoaderGetProcAddress("glVertexAttribDivisorARB"));
+    if (!sf_ptrc_glVertexAttribDivisorARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBeginQueryARB)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glEndQueryARB)(GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectivARB)(GLuint, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryivARB)(GLenum, GLenum, GLint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsQueryARB)(GLuint) = NULL;
+
+static int Load_ARB_occlusion_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBeginQueryARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBeginQueryARB"));
+    if (!sf_ptrc_glBeginQueryARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteQueriesARB"));
+    if (!sf_ptrc_glDeleteQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glEndQueryARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glEndQueryARB"));
+    if (!sf_ptrc_glEndQueryARB)
+        numFailed++;
+
+    sf_ptrc_glGenQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenQueriesARB"));
+    if (!sf_ptrc_glGenQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetQueryObjectivARB"));
+    if (!sf_ptrc_glGetQueryObjectivARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectuivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint*)>(glLoaderGetProcAddress("glGetQueryObjectuivARB"));
+    if (!sf_ptrc_glGetQueryObjectuivARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetQueryivARB"));
+    if (!sf_ptrc_glGetQueryivARB)
+        numFailed++;
+
+    sf_ptrc_glIsQueryARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsQueryARB"));
+    if (!sf_ptrc_glIsQueryARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjecti64v)(GLuint, GLenum, GLint64*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum) = NULL;
+
+static int Load_ARB_timer_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetQueryObjecti64v = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint64*)>(glLoaderGetProcAddress("glGetQueryObjecti64v"));
+    if (!sf_ptrc_glGetQueryObjecti64v)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectui64v = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint64*)>(glLoaderGetProcAddress("glGetQueryObjectui64v"));
+    if (!sf_ptrc_glGetQueryObjectui64v)
+        numFailed++;
+
+    sf_ptrc_glQueryCounter = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum)>(glLoaderGetProcAddress("glQueryCounter"));
+    if (!sf_ptrc_glQueryCounter)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint) = NULL;
+
+static int Load_ARB_vertex_array_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindVertexArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glBindVertexArray"));
+    if (!sf_ptrc_glBindVertexArray)
+        numFailed++;
+
+    sf_ptrc_glDeleteVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteVertexArrays"));
+    if (!sf_ptrc_glDeleteVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glGenVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenVertexArrays"));
+    if (!sf_ptrc_glGenVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glIsVertexArray = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsVertexArray"));
+    if (!sf_ptrc_glIsVertexArray)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage1DARB)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage2DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage3DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexSubImage1DARB)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexSubImage2DARB)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexSubImage3DARB)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetCompressedTexImageARB)(GLenum, GLint, void*) = NULL;
+
+static int Load_ARB_texture_compression()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glCompressedTexImage1DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage1DARB"));
+    if (!sf_ptrc_glCompressedTexImage1DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexImage2DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage2DARB"));
+    if (!sf_ptrc_glCompressedTexImage2DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexImage3DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage3DARB"));
+    if (!sf_ptrc_glCompressedTexImage3DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexSubImage1DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexSubImage1DARB"));
+    if (!sf_ptrc_glCompressedTexSubImage1DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexSubImage2DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexSubImage2DARB"));
+    if (!sf_ptrc_glCompressedTexSubImage2DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexSubImage3DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexSubImage3DARB"));
+    if (!sf_ptrc_glCompressedTexSubImage3DARB)
+        numFailed++;
+
+    sf_ptrc_glGetCompressedTexImageARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, void*)>(glLoaderGetProcAddress("glGetCompressedTexImageARB"));
+    if (!sf_ptrc_glGetCompressedTexImageARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+// Entry points of OpenGL 2.0 used to emulate the ARB_shader_objects
+// functions that have no direct core equivalent
+#if !defined(__APPLE__)
+
+static void (GL_FUNCPTR *sf_ptrc_glDeleteProgram)(GLuint) = NULL;
+static void (GL_FUNCPTR *sf_ptrc_glDeleteShader)(GLuint) = NULL;
+static void (GL_FUNCPTR *sf_ptrc_glGetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = NULL;
+static void (GL_FUNCPTR *sf_ptrc_glGetProgramiv)(GLuint, GLenum, GLint*) = NULL;
+static void (GL_FUNCPTR *sf_ptrc_glGetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = NULL;
+static void (GL_FUNCPTR *sf_ptrc_glGetShaderiv)(GLuint, GLenum, GLint*) = NULL;
+static GLboolean (GL_FUNCPTR *sf_ptrc_glIsProgram)(GLuint) = NULL;
+
+static void APIENTRY coreAdapterDeleteObject(GLhandleARB obj)
+{
+    if (sf_ptrc_glIsProgram(obj))
+        sf_ptrc_glDeleteProgram(obj);
+    else
+        sf_ptrc_glDeleteShader(obj);
+}
+
+static GLhandleARB APIENTRY coreAdapterGetHandle(GLenum)
+{
+    // The only valid parameter is GL_PROGRAM_OBJECT_ARB
+    GLint program = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+
+    return static_cast<GLhandleARB>(program);
+}
+
+static void APIENTRY coreAdapterGetInfoLog(GLhandleARB obj, GLsizei maxLength, GLsizei* length, GLcharARB* infoLog)
+{
+    if (sf_ptrc_glIsProgram(obj))
+        sf_ptrc_glGetProgramInfoLog(obj, maxLength, length, infoLog);
+    else
+        sf_ptrc_glGetShaderInfoLog(obj, maxLength, length, infoLog);
+}
+
+static void APIENTRY coreAdapterGetObjectParameteriv(GLhandleARB obj, GLenum pname, GLint* params)
+{
+    // The GL_OBJECT_*_ARB parameters have the same values as their core equivalents
+    if (sf_ptrc_glIsProgram(obj))
+        sf_ptrc_glGetProgramiv(obj, pname, params);
+    else
+        sf_ptrc_glGetShaderiv(obj, pname, params);
+}
+
+static void APIENTRY coreAdapterGetObjectParameterfv(GLhandleARB obj, GLenum pname, GLfloat* params)
+{
+    GLint value = 0;
+    coreAdapterGetObjectParameteriv(obj, pname, &value);
+
+    *params = static_cast<GLfloat>(value);
+}
+
+#endif
+
+static int Load_EXT_blend_minmax_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBlendEquationEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glBlendEquation"));
+    if (!sf_ptrc_glBlendEquationEXT)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_ARB_multitexture_Core()
+{
+    int numFailed = 0;
+
+    // glClientActiveTexture and glMultiTexCoord* belong to the fixed-function
+    // pipeline, they were removed from the core profile and are not loaded here
+    sf_ptrc_glActiveTextureARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glActiveTexture"));
+    if (!sf_ptrc_glActiveTextureARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_EXT_blend_func_separate_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBlendFuncSeparateEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLenum)>(glLoaderGetProcAddress("glBlendFuncSeparate"));
+    if (!sf_ptrc_glBlendFuncSeparateEXT)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_ARB_vertex_buffer_object_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindBufferARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindBuffer"));
+    if (!sf_ptrc_glBindBufferARB)
+        numFailed++;
+
+    sf_ptrc_glBufferDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizeiptrARB, const void*, GLenum)>(glLoaderGetProcAddress("glBufferData"));
+    if (!sf_ptrc_glBufferDataARB)
+        numFailed++;
+
+    sf_ptrc_glBufferSubDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, const void*)>(glLoaderGetProcAddress("glBufferSubData"));
+    if (!sf_ptrc_glBufferSubDataARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteBuffersARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteBuffers"));
+    if (!sf_ptrc_glDeleteBuffersARB)
+        numFailed++;
+
+    sf_ptrc_glGenBuffersARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenBuffers"));
+    if (!sf_ptrc_glGenBuffersARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferParameterivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetBufferParameteriv"));
+    if (!sf_ptrc_glGetBufferParameterivARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferPointervARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, void**)>(glLoaderGetProcAddress("glGetBufferPointerv"));
+    if (!sf_ptrc_glGetBufferPointervARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferSubDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, void*)>(glLoaderGetProcAddress("glGetBufferSubData"));
+    if (!sf_ptrc_glGetBufferSubDataARB)
+        numFailed++;
+
+    sf_ptrc_glIsBufferARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsBuffer"));
+    if (!sf_ptrc_glIsBufferARB)
+        numFailed++;
+
+    sf_ptrc_glMapBufferARB = reinterpret_cast<void* (GL_FUNCPTR *)(GLenum, GLenum)>(glLoaderGetProcAddress("glMapBuffer"));
+    if (!sf_ptrc_glMapBufferARB)
+        numFailed++;
+
+    sf_ptrc_glUnmapBufferARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glUnmapBuffer"));
+    if (!sf_ptrc_glUnmapBufferARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+#if !defined(__APPLE__)
+
+static int Load_ARB_shader_objects_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDeleteProgram = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glDeleteProgram"));
+    sf_ptrc_glDeleteShader = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glDeleteShader"));
+    sf_ptrc_glGetProgramInfoLog = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLchar*)>(glLoaderGetProcAddress("glGetProgramInfoLog"));
+    sf_ptrc_glGetProgramiv = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetProgramiv"));
+    sf_ptrc_glGetShaderInfoLog = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLchar*)>(glLoaderGetProcAddress("glGetShaderInfoLog"));
+    sf_ptrc_glGetShaderiv = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetShaderiv"));
+    sf_ptrc_glIsProgram = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsProgram"));
+    if (!sf_ptrc_glDeleteProgram || !sf_ptrc_glDeleteShader || !sf_ptrc_glGetProgramInfoLog || !sf_ptrc_glGetProgramiv ||
+        !sf_ptrc_glGetShaderInfoLog || !sf_ptrc_glGetShaderiv || !sf_ptrc_glIsProgram)
+        numFailed++;
+
+    sf_ptrc_glAttachObjectARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLhandleARB)>(glLoaderGetProcAddress("glAttachShader"));
+    if (!sf_ptrc_glAttachObjectARB)
+        numFailed++;
+
+    sf_ptrc_glCompileShaderARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB)>(glLoaderGetProcAddress("glCompileShader"));
+    if (!sf_ptrc_glCompileShaderARB)
+        numFailed++;
+
+    sf_ptrc_glCreateProgramObjectARB = reinterpret_cast<GLhandleARB (GL_FUNCPTR *)()>(glLoaderGetProcAddress("glCreateProgram"));
+    if (!sf_ptrc_glCreateProgramObjectARB)
+        numFailed++;
+
+    sf_ptrc_glCreateShaderObjectARB = reinterpret_cast<GLhandleARB (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glCreateShader"));
+    if (!sf_ptrc_glCreateShaderObjectARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteObjectARB = coreAdapterDeleteObject;
+
+    sf_ptrc_glDetachObjectARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLhandleARB)>(glLoaderGetProcAddress("glDetachShader"));
+    if (!sf_ptrc_glDetachObjectARB)
+        numFailed++;
+
+    sf_ptrc_glGetActiveUniformARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLuint, GLsizei, GLsizei*, GLint*, GLenum*, GLcharARB*)>(glLoaderGetProcAddress("glGetActiveUniform"));
+    if (!sf_ptrc_glGetActiveUniformARB)
+        numFailed++;
+
+    sf_ptrc_glGetAttachedObjectsARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLsizei, GLsizei*, GLhandleARB*)>(glLoaderGetProcAddress("glGetAttachedShaders"));
+    if (!sf_ptrc_glGetAttachedObjectsARB)
+        numFailed++;
+
+    sf_ptrc_glGetHandleARB = coreAdapterGetHandle;
+
+    sf_ptrc_glGetInfoLogARB = coreAdapterGetInfoLog;
+
+    sf_ptrc_glGetObjectParameterfvARB = coreAdapterGetObjectParameterfv;
+
+    sf_ptrc_glGetObjectParameterivARB = coreAdapterGetObjectParameteriv;
+
+    sf_ptrc_glGetShaderSourceARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLsizei, GLsizei*, GLcharARB*)>(glLoaderGetProcAddress("glGetShaderSource"));
+    if (!sf_ptrc_glGetShaderSourceARB)
+        numFailed++;
+
+    sf_ptrc_glGetUniformLocationARB = reinterpret_cast<GLint (GL_FUNCPTR *)(GLhandleARB, const GLcharARB*)>(glLoaderGetProcAddress("glGetUniformLocation"));
+    if (!sf_ptrc_glGetUniformLocationARB)
+        numFailed++;
+
+    sf_ptrc_glGetUniformfvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLint, GLfloat*)>(glLoaderGetProcAddress("glGetUniformfv"));
+    if (!sf_ptrc_glGetUniformfvARB)
+        numFailed++;
+
+    sf_ptrc_glGetUniformivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLint, GLint*)>(glLoaderGetProcAddress("glGetUniformiv"));
+    if (!sf_ptrc_glGetUniformivARB)
+        numFailed++;
+
+    sf_ptrc_glLinkProgramARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB)>(glLoaderGetProcAddress("glLinkProgram"));
+    if (!sf_ptrc_glLinkProgramARB)
+        numFailed++;
+
+    sf_ptrc_glShaderSourceARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLsizei, const GLcharARB**, const GLint*)>(glLoaderGetProcAddress("glShaderSource"));
+    if (!sf_ptrc_glShaderSourceARB)
+        numFailed++;
+
+    sf_ptrc_glUniform1fARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLfloat)>(glLoaderGetProcAddress("glUniform1f"));
+    if (!sf_ptrc_glUniform1fARB)
+        numFailed++;
+
+    sf_ptrc_glUniform1fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLfloat*)>(glLoaderGetProcAddress("glUniform1fv"));
+    if (!sf_ptrc_glUniform1fvARB)
+        numFailed++;
+
+    sf_ptrc_glUniform1iARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint)>(glLoaderGetProcAddress("glUniform1i"));
+    if (!sf_ptrc_glUniform1iARB)
+        numFailed++;
+
+    sf_ptrc_glUniform1ivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLint*)>(glLoaderGetProcAddress("glUniform1iv"));
+    if (!sf_ptrc_glUniform1ivARB)
+        numFailed++;
+
+    sf_ptrc_glUniform2fARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLfloat, GLfloat)>(glLoaderGetProcAddress("glUniform2f"));
+    if (!sf_ptrc_glUniform2fARB)
+        numFailed++;
+
+    sf_ptrc_glUniform2fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLfloat*)>(glLoaderGetProcAddress("glUniform2fv"));
+    if (!sf_ptrc_glUniform2fvARB)
+        numFailed++;
+
+    sf_ptrc_glUniform2iARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint, GLint)>(glLoaderGetProcAddress("glUniform2i"));
+    if (!sf_ptrc_glUniform2iARB)
+        numFailed++;
+
+    sf_ptrc_glUniform2ivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLint*)>(glLoaderGetProcAddress("glUniform2iv"));
+    if (!sf_ptrc_glUniform2ivARB)
+        numFailed++;
+
+    sf_ptrc_glUniform3fARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLfloat, GLfloat, GLfloat)>(glLoaderGetProcAddress("glUniform3f"));
+    if (!sf_ptrc_glUniform3fARB)
+        numFailed++;
+
+    sf_ptrc_glUniform3fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLfloat*)>(glLoaderGetProcAddress("glUniform3fv"));
+    if (!sf_ptrc_glUniform3fvARB)
+        numFailed++;
+
+    sf_ptrc_glUniform3iARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint, GLint, GLint)>(glLoaderGetProcAddress("glUniform3i"));
+    if (!sf_ptrc_glUniform3iARB)
+        numFailed++;
+
+    sf_ptrc_glUniform3ivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLint*)>(glLoaderGetProcAddress("glUniform3iv"));
+    if (!sf_ptrc_glUniform3ivARB)
+        numFailed++;
+
+    sf_ptrc_glUniform4fARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLfloat, GLfloat, GLfloat, GLfloat)>(glLoaderGetProcAddress("glUniform4f"));
+    if (!sf_ptrc_glUniform4fARB)
+        numFailed++;
+
+    sf_ptrc_glUniform4fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLfloat*)>(glLoaderGetProcAddress("glUniform4fv"));
+    if (!sf_ptrc_glUniform4fvARB)
+        numFailed++;
+
+    sf_ptrc_glUniform4iARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint, GLint, GLint, GLint)>(glLoaderGetProcAddress("glUniform4i"));
+    if (!sf_ptrc_glUniform4iARB)
+        numFailed++;
+
+    sf_ptrc_glUniform4ivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLint*)>(glLoaderGetProcAddress("glUniform4iv"));
+    if (!sf_ptrc_glUniform4ivARB)
+        numFailed++;
+
+    sf_ptrc_glUniformMatrix2fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, GLboolean, const GLfloat*)>(glLoaderGetProcAddress("glUniformMatrix2fv"));
+    if (!sf_ptrc_glUniformMatrix2fvARB)
+        numFailed++;
+
+    sf_ptrc_glUniformMatrix3fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, GLboolean, const GLfloat*)>(glLoaderGetProcAddress("glUniformMatrix3fv"));
+    if (!sf_ptrc_glUniformMatrix3fvARB)
+        numFailed++;
+
+    sf_ptrc_glUniformMatrix4fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, GLboolean, const GLfloat*)>(glLoaderGetProcAddress("glUniformMatrix4fv"));
+    if (!sf_ptrc_glUniformMatrix4fvARB)
+        numFailed++;
+
+    sf_ptrc_glUseProgramObjectARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB)>(glLoaderGetProcAddress("glUseProgram"));
+    if (!sf_ptrc_glUseProgramObjectARB)
+        numFailed++;
+
+    sf_ptrc_glValidateProgramARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB)>(glLoaderGetProcAddress("glValidateProgram"));
+    if (!sf_ptrc_glValidateProgramARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+#endif
+
+#if !defined(__APPLE__)
+
+static int Load_ARB_vertex_shader_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindAttribLocationARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLuint, const GLcharARB*)>(glLoaderGetProcAddress("glBindAttribLocation"));
+    if (!sf_ptrc_glBindAttribLocationARB)
+        numFailed++;
+
+    sf_ptrc_glDisableVertexAttribArrayARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glDisableVertexAttribArray"));
+    if (!sf_ptrc_glDisableVertexAttribArrayARB)
+        numFailed++;
+
+    sf_ptrc_glEnableVertexAttribArrayARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glEnableVertexAttribArray"));
+    if (!sf_ptrc_glEnableVertexAttribArrayARB)
+        numFailed++;
+
+    sf_ptrc_glGetActiveAttribARB = reinterpret_cast<void (GL_FUNCPTR *)(GLhandleARB, GLuint, GLsizei, GLsizei*, GLint*, GLenum*, GLcharARB*)>(glLoaderGetProcAddress("glGetActiveAttrib"));
+    if (!sf_ptrc_glGetActiveAttribARB)
+        numFailed++;
+
+    sf_ptrc_glGetAttribLocationARB = reinterpret_cast<GLint (GL_FUNCPTR *)(GLhandleARB, const GLcharARB*)>(glLoaderGetProcAddress("glGetAttribLocation"));
+    if (!sf_ptrc_glGetAttribLocationARB)
+        numFailed++;
+
+    sf_ptrc_glGetVertexAttribPointervARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, void**)>(glLoaderGetProcAddress("glGetVertexAttribPointerv"));
+    if (!sf_ptrc_glGetVertexAttribPointervARB)
+        numFailed++;
+
+    sf_ptrc_glGetVertexAttribdvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLdouble*)>(glLoaderGetProcAddress("glGetVertexAttribdv"));
+    if (!sf_ptrc_glGetVertexAttribdvARB)
+        numFailed++;
+
+    sf_ptrc_glGetVertexAttribfvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLfloat*)>(glLoaderGetProcAddress("glGetVertexAttribfv"));
+    if (!sf_ptrc_glGetVertexAttribfvARB)
+        numFailed++;
+
+    sf_ptrc_glGetVertexAttribivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetVertexAttribiv"));
+    if (!sf_ptrc_glGetVertexAttribivARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib1dARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLdouble)>(glLoaderGetProcAddress("glVertexAttrib1d"));
+    if (!sf_ptrc_glVertexAttrib1dARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib1dvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLdouble*)>(glLoaderGetProcAddress("glVertexAttrib1dv"));
+    if (!sf_ptrc_glVertexAttrib1dvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib1fARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLfloat)>(glLoaderGetProcAddress("glVertexAttrib1f"));
+    if (!sf_ptrc_glVertexAttrib1fARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib1fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLfloat*)>(glLoaderGetProcAddress("glVertexAttrib1fv"));
+    if (!sf_ptrc_glVertexAttrib1fvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib1sARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLshort)>(glLoaderGetProcAddress("glVertexAttrib1s"));
+    if (!sf_ptrc_glVertexAttrib1sARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib1svARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLshort*)>(glLoaderGetProcAddress("glVertexAttrib1sv"));
+    if (!sf_ptrc_glVertexAttrib1svARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib2dARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLdouble, GLdouble)>(glLoaderGetProcAddress("glVertexAttrib2d"));
+    if (!sf_ptrc_glVertexAttrib2dARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib2dvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLdouble*)>(glLoaderGetProcAddress("glVertexAttrib2dv"));
+    if (!sf_ptrc_glVertexAttrib2dvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib2fARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLfloat, GLfloat)>(glLoaderGetProcAddress("glVertexAttrib2f"));
+    if (!sf_ptrc_glVertexAttrib2fARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib2fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLfloat*)>(glLoaderGetProcAddress("glVertexAttrib2fv"));
+    if (!sf_ptrc_glVertexAttrib2fvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib2sARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLshort, GLshort)>(glLoaderGetProcAddress("glVertexAttrib2s"));
+    if (!sf_ptrc_glVertexAttrib2sARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib2svARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLshort*)>(glLoaderGetProcAddress("glVertexAttrib2sv"));
+    if (!sf_ptrc_glVertexAttrib2svARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib3dARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLdouble, GLdouble, GLdouble)>(glLoaderGetProcAddress("glVertexAttrib3d"));
+    if (!sf_ptrc_glVertexAttrib3dARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib3dvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLdouble*)>(glLoaderGetProcAddress("glVertexAttrib3dv"));
+    if (!sf_ptrc_glVertexAttrib3dvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib3fARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLfloat, GLfloat, GLfloat)>(glLoaderGetProcAddress("glVertexAttrib3f"));
+    if (!sf_ptrc_glVertexAttrib3fARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib3fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLfloat*)>(glLoaderGetProcAddress("glVertexAttrib3fv"));
+    if (!sf_ptrc_glVertexAttrib3fvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib3sARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLshort, GLshort, GLshort)>(glLoaderGetProcAddress("glVertexAttrib3s"));
+    if (!sf_ptrc_glVertexAttrib3sARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib3svARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLshort*)>(glLoaderGetProcAddress("glVertexAttrib3sv"));
+    if (!sf_ptrc_glVertexAttrib3svARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4NbvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLbyte*)>(glLoaderGetProcAddress("glVertexAttrib4Nbv"));
+    if (!sf_ptrc_glVertexAttrib4NbvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4NivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLint*)>(glLoaderGetProcAddress("glVertexAttrib4Niv"));
+    if (!sf_ptrc_glVertexAttrib4NivARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4NsvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLshort*)>(glLoaderGetProcAddress("glVertexAttrib4Nsv"));
+    if (!sf_ptrc_glVertexAttrib4NsvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4NubARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLubyte, GLubyte, GLubyte, GLubyte)>(glLoaderGetProcAddress("glVertexAttrib4Nub"));
+    if (!sf_ptrc_glVertexAttrib4NubARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4NubvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLubyte*)>(glLoaderGetProcAddress("glVertexAttrib4Nubv"));
+    if (!sf_ptrc_glVertexAttrib4NubvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4NuivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLuint*)>(glLoaderGetProcAddress("glVertexAttrib4Nuiv"));
+    if (!sf_ptrc_glVertexAttrib4NuivARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4NusvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLushort*)>(glLoaderGetProcAddress("glVertexAttrib4Nusv"));
+    if (!sf_ptrc_glVertexAttrib4NusvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4bvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLbyte*)>(glLoaderGetProcAddress("glVertexAttrib4bv"));
+    if (!sf_ptrc_glVertexAttrib4bvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4dARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLdouble, GLdouble, GLdouble, GLdouble)>(glLoaderGetProcAddress("glVertexAttrib4d"));
+    if (!sf_ptrc_glVertexAttrib4dARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4dvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLdouble*)>(glLoaderGetProcAddress("glVertexAttrib4dv"));
+    if (!sf_ptrc_glVertexAttrib4dvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4fARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLfloat, GLfloat, GLfloat, GLfloat)>(glLoaderGetProcAddress("glVertexAttrib4f"));
+    if (!sf_ptrc_glVertexAttrib4fARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4fvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLfloat*)>(glLoaderGetProcAddress("glVertexAttrib4fv"));
+    if (!sf_ptrc_glVertexAttrib4fvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4ivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLint*)>(glLoaderGetProcAddress("glVertexAttrib4iv"));
+    if (!sf_ptrc_glVertexAttrib4ivARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4sARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLshort, GLshort, GLshort, GLshort)>(glLoaderGetProcAddress("glVertexAttrib4s"));
+    if (!sf_ptrc_glVertexAttrib4sARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4svARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLshort*)>(glLoaderGetProcAddress("glVertexAttrib4sv"));
+    if (!sf_ptrc_glVertexAttrib4svARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4ubvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLubyte*)>(glLoaderGetProcAddress("glVertexAttrib4ubv"));
+    if (!sf_ptrc_glVertexAttrib4ubvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4uivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLuint*)>(glLoaderGetProcAddress("glVertexAttrib4uiv"));
+    if (!sf_ptrc_glVertexAttrib4uivARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttrib4usvARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, const GLushort*)>(glLoaderGetProcAddress("glVertexAttrib4usv"));
+    if (!sf_ptrc_glVertexAttrib4usvARB)
+        numFailed++;
+
+    sf_ptrc_glVertexAttribPointerARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*)>(glLoaderGetProcAddress("glVertexAttribPointer"));
+    if (!sf_ptrc_glVertexAttribPointerARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+#endif
+
+static int Load_EXT_blend_equation_separate_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBlendEquationSeparateEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum)>(glLoaderGetProcAddress("glBlendEquationSeparate"));
+    if (!sf_ptrc_glBlendEquationSeparateEXT)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_EXT_framebuffer_object_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindFramebufferEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindFramebuffer"));
+    if (!sf_ptrc_glBindFramebufferEXT)
+        numFailed++;
+
+    sf_ptrc_glBindRenderbufferEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindRenderbuffer"));
+    if (!sf_ptrc_glBindRenderbufferEXT)
+        numFailed++;
+
+    sf_ptrc_glCheckFramebufferStatusEXT = reinterpret_cast<GLenum (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glCheckFramebufferStatus"));
+    if (!sf_ptrc_glCheckFramebufferStatusEXT)
+        numFailed++;
+
+    sf_ptrc_glDeleteFramebuffersEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteFramebuffers"));
+    if (!sf_ptrc_glDeleteFramebuffersEXT)
+        numFailed++;
+
+    sf_ptrc_glDeleteRenderbuffersEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteRenderbuffers"));
+    if (!sf_ptrc_glDeleteRenderbuffersEXT)
+        numFailed++;
+
+    sf_ptrc_glFramebufferRenderbufferEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLuint)>(glLoaderGetProcAddress("glFramebufferRenderbuffer"));
+    if (!sf_ptrc_glFramebufferRenderbufferEXT)
+        numFailed++;
+
+    sf_ptrc_glFramebufferTexture1DEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLuint, GLint)>(glLoaderGetProcAddress("glFramebufferTexture1D"));
+    if (!sf_ptrc_glFramebufferTexture1DEXT)
+        numFailed++;
+
+    sf_ptrc_glFramebufferTexture2DEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLuint, GLint)>(glLoaderGetProcAddress("glFramebufferTexture2D"));
+    if (!sf_ptrc_glFramebufferTexture2DEXT)
+        numFailed++;
+
+    sf_ptrc_glFramebufferTexture3DEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLuint, GLint, GLint)>(glLoaderGetProcAddress("glFramebufferTexture3D"));
+    if (!sf_ptrc_glFramebufferTexture3DEXT)
+        numFailed++;
+
+    sf_ptrc_glGenFramebuffersEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenFramebuffers"));
+    if (!sf_ptrc_glGenFramebuffersEXT)
+        numFailed++;
+
+    sf_ptrc_glGenRenderbuffersEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenRenderbuffers"));
+    if (!sf_ptrc_glGenRenderbuffersEXT)
+        numFailed++;
+
+    sf_ptrc_glGenerateMipmapEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glGenerateMipmap"));
+    if (!sf_ptrc_glGenerateMipmapEXT)
+        numFailed++;
+
+    sf_ptrc_glGetFramebufferAttachmentParameterivEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetFramebufferAttachmentParameteriv"));
+    if (!sf_ptrc_glGetFramebufferAttachmentParameterivEXT)
+        numFailed++;
+
+    sf_ptrc_glGetRenderbufferParameterivEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetRenderbufferParameteriv"));
+    if (!sf_ptrc_glGetRenderbufferParameterivEXT)
+        numFailed++;
+
+    sf_ptrc_glIsFramebufferEXT = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsFramebuffer"));
+    if (!sf_ptrc_glIsFramebufferEXT)
+        numFailed++;
+
+    sf_ptrc_glIsRenderbufferEXT = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsRenderbuffer"));
+    if (!sf_ptrc_glIsRenderbufferEXT)
+        numFailed++;
+
+    sf_ptrc_glRenderbufferStorageEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLsizei, GLsizei)>(glLoaderGetProcAddress("glRenderbufferStorage"));
+    if (!sf_ptrc_glRenderbufferStorageEXT)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_EXT_framebuffer_blit_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBlitFramebufferEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum)>(glLoaderGetProcAddress("glBlitFramebuffer"));
+    if (!sf_ptrc_glBlitFramebufferEXT)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_EXT_framebuffer_multisample_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glRenderbufferStorageMultisampleEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, GLsizei, GLsizei)>(glLoaderGetProcAddress("glRenderbufferStorageMultisample"));
+    if (!sf_ptrc_glRenderbufferStorageMultisampleEXT)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_ARB_draw_instanced_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDrawArraysInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLsizei, GLsizei)>(glLoaderGetProcAddress("glDrawArraysInstanced"));
+    if (!sf_ptrc_glDrawArraysInstancedARB)
+        numFailed++;
+
+    sf_ptrc_glDrawElementsInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glDrawElementsInstanced"));
+    if (!sf_ptrc_glDrawElementsInstancedARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_ARB_instanced_arrays_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glVertexAttribDivisorARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint)>(glLoaderGetProcAddress("glVertexAttribDivisor"));
+    if (!sf_ptrc_glVertexAttribDivisorARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_ARB_occlusion_query_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBeginQueryARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBeginQuery"));
+    if (!sf_ptrc_glBeginQueryARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteQueries"));
+    if (!sf_ptrc_glDeleteQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glEndQueryARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glEndQuery"));
+    if (!sf_ptrc_glEndQueryARB)
+        numFailed++;
+
+    sf_ptrc_glGenQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenQueries"));
+    if (!sf_ptrc_glGenQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetQueryObjectiv"));
+    if (!sf_ptrc_glGetQueryObjectivARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectuivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint*)>(glLoaderGetProcAddress("glGetQueryObjectuiv"));
+    if (!sf_ptrc_glGetQueryObjectuivARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetQueryiv"));
+    if (!sf_ptrc_glGetQueryivARB)
+        numFailed++;
+
+    sf_ptrc_glIsQueryARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsQuery"));
+    if (!sf_ptrc_glIsQueryARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+static int Load_ARB_texture_compression_Core()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glCompressedTexImage1DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage1D"));
+    if (!sf_ptrc_glCompressedTexImage1DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexImage2DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage2D"));
+    if (!sf_ptrc_glCompressedTexImage2DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexImage3DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage3D"));
+    if (!sf_ptrc_glCompressedTexImage3DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexSubImage1DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexSubImage1D"));
+    if (!sf_ptrc_glCompressedTexSubImage1DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexSubImage2DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexSubImage2D"));
+    if (!sf_ptrc_glCompressedTexSubImage2DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexSubImage3DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexSubImage3D"));
+    if (!sf_ptrc_glCompressedTexSubImage3DARB)
+        numFailed++;
+
+    sf_ptrc_glGetCompressedTexImageARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, void*)>(glLoaderGetProcAddress("glGetCompressedTexImage"));
+    if (!sf_ptrc_glGetCompressedTexImageARB)
+        numFailed++;
+
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)();
 typedef struct sfogl_StrToExtMap_s
 {
@@ -943,7 +1901,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[20] = {
+static sfogl_StrToExtMap ExtensionMap[31] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_texture_edge_clamp", &sfogl_ext_EXT_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
@@ -963,10 +1921,65 @@ static sfogl_StrToExtMap ExtensionMap[20] = {
     {"GL_EXT_framebuffer_blit", &sfogl_ext_EXT_framebuffer_blit, Load_EXT_framebuffer_blit},
     {"GL_EXT_framebuffer_multisample", &sfogl_ext_EXT_framebuffer_multisample, Load_EXT_framebuffer_multisample},
     {"GL_ARB_copy_buffer", &sfogl_ext_ARB_copy_buffer, Load_ARB_copy_buffer},
-    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4}
+    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4},
+    {"GL_ARB_map_buffer_range", &sfogl_ext_ARB_map_buffer_range, Load_ARB_map_buffer_range},
+    {"GL_ARB_sync", &sfogl_ext_ARB_sync, Load_ARB_sync},
+    {"GL_ARB_draw_instanced", &sfogl_ext_ARB_draw_instanced, Load_ARB_draw_instanced},
+    {"GL_ARB_instanced_arrays", &sfogl_ext_ARB_instanced_arrays, Load_ARB_instanced_arrays},
+    {"GL_ARB_occlusion_query", &sfogl_ext_ARB_occlusion_query, Load_ARB_occlusion_query},
+    {"GL_ARB_timer_query", &sfogl_ext_ARB_timer_query, Load_ARB_timer_query},
+    {"GL_ARB_vertex_array_object", &sfogl_ext_ARB_vertex_array_object, Load_ARB_vertex_array_object},
+    {"GL_ARB_texture_compression", &sfogl_ext_ARB_texture_compression, Load_ARB_texture_compression},
+    {"GL_EXT_texture_compression_s3tc", &sfogl_ext_EXT_texture_compression_s3tc, NULL},
+    {"GL_ARB_ES3_compatibility", &sfogl_ext_ARB_ES3_compatibility, NULL},
+    {"GL_KHR_texture_compression_astc_ldr", &sfogl_ext_KHR_texture_compression_astc_ldr, NULL}
 };
 
-static int g_extensionMapSize = 20;
+static int g_extensionMapSize = 31;
+
+typedef struct sfogl_PromotedExtMap_s
+{
+    int* extensionVariable;
+    int majorVersion;
+    int minorVersion;
+    PFN_LOADFUNCPOINTERS LoadExtension;
+} sfogl_PromotedExtMap;
+
+// Extensions that became part of the core API, and can be loaded by their core
+// names when the context doesn't advertise them (e.g. core profile contexts)
+static sfogl_PromotedExtMap PromotedExtensionMap[] = {
+    {&sfogl_ext_SGIS_texture_edge_clamp, 1, 2, NULL},
+    {&sfogl_ext_EXT_texture_edge_clamp, 1, 2, NULL},
+    {&sfogl_ext_EXT_blend_minmax, 1, 4, Load_EXT_blend_minmax_Core},
+    {&sfogl_ext_EXT_blend_subtract, 1, 4, NULL},
+    {&sfogl_ext_ARB_multitexture, 1, 3, Load_ARB_multitexture_Core},
+    {&sfogl_ext_EXT_blend_func_separate, 1, 4, Load_EXT_blend_func_separate_Core},
+    {&sfogl_ext_ARB_vertex_buffer_object, 1, 5, Load_ARB_vertex_buffer_object_Core},
+    {&sfogl_ext_ARB_shading_language_100, 2, 0, NULL},
+#if !defined(__APPLE__)
+    // GLhandleARB is not an integer on macOS, core shader functions are not compatible
+    {&sfogl_ext_ARB_shader_objects, 2, 0, Load_ARB_shader_objects_Core},
+    {&sfogl_ext_ARB_vertex_shader, 2, 0, Load_ARB_vertex_shader_Core},
+#endif
+    {&sfogl_ext_ARB_fragment_shader, 2, 0, NULL},
+    {&sfogl_ext_ARB_texture_non_power_of_two, 2, 0, NULL},
+    {&sfogl_ext_EXT_blend_equation_separate, 2, 0, Load_EXT_blend_equation_separate_Core},
+    {&sfogl_ext_EXT_texture_sRGB, 2, 1, NULL},
+    {&sfogl_ext_EXT_framebuffer_object, 3, 0, Load_EXT_framebuffer_object_Core},
+    {&sfogl_ext_EXT_packed_depth_stencil, 3, 0, NULL},
+    {&sfogl_ext_EXT_framebuffer_blit, 3, 0, Load_EXT_framebuffer_blit_Core},
+    {&sfogl_ext_EXT_framebuffer_multisample, 3, 0, Load_EXT_framebuffer_multisample_Core},
+    {&sfogl_ext_ARB_copy_buffer, 3, 1, Load_ARB_copy_buffer},
+    {&sfogl_ext_ARB_map_buffer_range, 3, 0, Load_ARB_map_buffer_range},
+    {&sfogl_ext_ARB_sync, 3, 2, Load_ARB_sync},
+    {&sfogl_ext_ARB_draw_instanced, 3, 1, Load_ARB_draw_instanced_Core},
+    {&sfogl_ext_ARB_instanced_arrays, 3, 3, Load_ARB_instanced_arrays_Core},
+    {&sfogl_ext_ARB_occlusion_query, 1, 5, Load_ARB_occlusion_query_Core},
+    {&sfogl_ext_ARB_timer_query, 3, 3, Load_ARB_timer_query},
+    {&sfogl_ext_ARB_vertex_array_object, 3, 0, Load_ARB_vertex_array_object},
+    {&sfogl_ext_ARB_texture_compression, 1, 3, Load_ARB_texture_compression_Core},
+    {&sfogl_ext_ARB_ES3_compatibility, 4, 3, NULL}
+};
 
 
 static void ClearExtensionVars()
@@ -991,6 +2004,17 @@ static void ClearExtensionVars()
     sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_occlusion_query = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_texture_compression = sfogl_LOAD_FAILED;
+    sfogl_ext_EXT_texture_compression_s3tc = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_ES3_compatibility = sfogl_LOAD_FAILED;
+    sfogl_ext_KHR_texture_compression_astc_ldr = sfogl_LOAD_FAILED;
 }
 
 
@@ -1016,4 +2040,32 @@ void sfogl_LoadFunctions()
         if (sf::Context::isExtensionAvailable(ExtensionMap[i].extensionName))
             LoadExtension(ExtensionMap[i]);
     }
+
+    // Retrieve the context version number, the beginning of the string is "major.minor"
+    const GLubyte* version = glGetString(GL_VERSION);
+    if (!version)
+        return;
+
+    int majorVersion = version[0] - '0';
+    int minorVersion = version[2] - '0';
+
+    // Load the extensions that were promoted to core by their core names
+    int promotedCount = static_cast<int>(sizeof(PromotedExtensionMap) / sizeof(PromotedExtensionMap[0]));
+
+    for (int i = 0; i < promotedCount; ++i)
+    {
+        sfogl_PromotedExtMap& extension = PromotedExtensionMap[i];
+
+        if (*(extension.extensionVariable) != sfogl_LOAD_FAILED)
+            continue;
+
+        if ((majorVersion > extension.majorVersion) ||
+            ((majorVersion == extension.majorVersion) && (minorVersion >= extension.minorVersion)))
+        {
+            if (extension.LoadExtension)
+                *(extension.extensionVariable) = sfogl_LOAD_SUCCEEDED + extension.LoadExtension();
+            else
+                *(extension.extensionVariable) = sfogl_LOAD_SUCCEEDED;
+        }
+    }
 }
@@ -190,6 +190,17 @@ extern int sfogl_ext_EXT_framebuffer_blit;
 extern int sfogl_ext_EXT_framebuffer_multisample;
 extern int sfogl_ext_ARB_copy_buffer;
 extern int sfogl_ext_ARB_geometry_shader4;
+extern int sfogl_ext_ARB_map_buffer_range;
+extern int sfogl_ext_ARB_sync;
+extern int sfogl_ext_ARB_draw_instanced;
+extern int sfogl_ext_ARB_instanced_arrays;
+extern int sfogl_ext_ARB_occlusion_query;
+extern int sfogl_ext_ARB_timer_query;
+extern int sfogl_ext_ARB_vertex_array_object;
+extern int sfogl_ext_ARB_texture_compression;
+extern int sfogl_ext_EXT_texture_compression_s3tc;
+extern int sfogl_ext_ARB_ES3_compatibility;
+extern int sfogl_ext_KHR_texture_compression_astc_ldr;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -454,6 +465,103 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_TRIANGLES_ADJACENCY_ARB 0x000C
 #define GL_TRIANGLE_STRIP_ADJACENCY_ARB 0x000D
 
+#define GL_MAP_FLUSH_EXPLICIT_BIT 0x0010
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_READ_BIT 0x0001
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#define GL_MAP_WRITE_BIT 0x0002
+
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_MAX_SERVER_WAIT_TIMEOUT 0x9111
+#define GL_OBJECT_TYPE 0x9112
+#define GL_SIGNALED 0x9119
+#define GL_SYNC_CONDITION 0x9113
+#define GL_SYNC_FENCE 0x9116
+#define GL_SYNC_FLAGS 0x9115
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_STATUS 0x9114
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_UNSIGNALED 0x9118
+#define GL_WAIT_FAILED 0x911D
+
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR_ARB 0x88FE
+
+#define GL_CURRENT_QUERY_ARB 0x8865
+#define GL_QUERY_COUNTER_BITS_ARB 0x8864
+#define GL_QUERY_RESULT_ARB 0x8866
+#define GL_QUERY_RESULT_AVAILABLE_ARB 0x8867
+#define GL_SAMPLES_PASSED_ARB 0x8914
+
+#define GL_TIMESTAMP 0x8E28
+#define GL_TIME_ELAPSED 0x88BF
+
+#define GL_VERTEX_ARRAY_BINDING 0x85B5
+
+#define GL_CURRENT_PROGRAM 0x8B8D
+
+#define GL_COMPRESSED_ALPHA_ARB 0x84E9
+#define GL_COMPRESSED_INTENSITY_ARB 0x84EC
+#define GL_COMPRESSED_LUMINANCE_ALPHA_ARB 0x84EB
+#define GL_COMPRESSED_LUMINANCE_ARB 0x84EA
+#define GL_COMPRESSED_RGBA_ARB 0x84EE
+#define GL_COMPRESSED_RGB_ARB 0x84ED
+#define GL_COMPRESSED_TEXTURE_FORMATS_ARB 0x86A3
+#define GL_NUM_COMPRESSED_TEXTURE_FORMATS_ARB 0x86A2
+#define GL_TEXTURE_COMPRESSED_ARB 0x86A1
+#define GL_TEXTURE_COMPRESSED_IMAGE_SIZE_ARB 0x86A0
+#define GL_TEXTURE_COMPRESSION_HINT_ARB 0x84EF
+
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+
+#define GL_ANY_SAMPLES_PASSED_CONSERVATIVE 0x8D6A
+#define GL_COMPRESSED_R11_EAC 0x9270
+#define GL_COMPRESSED_RG11_EAC 0x9272
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9276
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#define GL_COMPRESSED_SIGNED_R11_EAC 0x9271
+#define GL_COMPRESSED_SIGNED_RG11_EAC 0x9273
+#define GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0x9279
+#define GL_COMPRESSED_SRGB8_ETC2 0x9275
+#define GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9277
+#define GL_MAX_ELEMENT_INDEX 0x8D6B
+#define GL_PRIMITIVE_RESTART_FIXED_INDEX 0x8D69
+
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#define GL_COMPRESSED_RGBA_ASTC_5x4_KHR 0x93B1
+#define GL_COMPRESSED_RGBA_ASTC_5x5_KHR 0x93B2
+#define GL_COMPRESSED_RGBA_ASTC_6x5_KHR 0x93B3
+#define GL_COMPRESSED_RGBA_ASTC_6x6_KHR 0x93B4
+#define GL_COMPRESSED_RGBA_ASTC_8x5_KHR 0x93B5
+#define GL_COMPRESSED_RGBA_ASTC_8x6_KHR 0x93B6
+#define GL_COMPRESSED_RGBA_ASTC_8x8_KHR 0x93B7
+#define GL_COMPRESSED_RGBA_ASTC_10x5_KHR 0x93B8
+#define GL_COMPRESSED_RGBA_ASTC_10x6_KHR 0x93B9
+#define GL_COMPRESSED_RGBA_ASTC_10x8_KHR 0x93BA
+#define GL_COMPRESSED_RGBA_ASTC_10x10_KHR 0x93BB
+#define GL_COMPRESSED_RGBA_ASTC_12x10_KHR 0x93BC
+#define GL_COMPRESSED_RGBA_ASTC_12x12_KHR 0x93BD
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR 0x93D1
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR 0x93D2
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR 0x93D3
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR 0x93D4
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR 0x93D5
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR 0x93D6
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR 0x93D7
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR 0x93D8
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR 0x93D9
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR 0x93DA
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR 0x93DB
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR 0x93DC
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR 0x93DD
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -1353,6 +1461,106 @@ extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteriARB)(GLuint, GLenum, GLint);
 #define glProgramParameteriARB sf_ptrc_glProgramParameteriARB
 #endif // GL_ARB_geometry_shader4
 
+#ifndef GL_ARB_map_buffer_range
+#define GL_ARB_map_buffer_range 1
+extern void* (GL_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+#define glMapBufferRange sf_ptrc_glMapBufferRange
+extern void (GL_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr);
+#define glFlushMappedBufferRange sf_ptrc_glFlushMappedBufferRange
+#endif // GL_ARB_map_buffer_range
+
+#ifndef GL_ARB_sync
+#define GL_ARB_sync 1
+extern GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glClientWaitSync sf_ptrc_glClientWaitSync
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync);
+#define glDeleteSync sf_ptrc_glDeleteSync
+extern GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield);
+#define glFenceSync sf_ptrc_glFenceSync
+extern void (GL_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64*);
+#define glGetInteger64v sf_ptrc_glGetInteger64v
+extern void (GL_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei*, GLint*);
+#define glGetSynciv sf_ptrc_glGetSynciv
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsSync)(GLsync);
+#define glIsSync sf_ptrc_glIsSync
+extern void (GL_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glWaitSync sf_ptrc_glWaitSync
+#endif // GL_ARB_sync
+
+#ifndef GL_ARB_draw_instanced
+#define GL_ARB_draw_instanced 1
+extern void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei);
+#define glDrawArraysInstancedARB sf_ptrc_glDrawArraysInstancedARB
+extern void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei);
+#define glDrawElementsInstancedARB sf_ptrc_glDrawElementsInstancedARB
+#endif // GL_ARB_draw_instanced
+
+#ifndef GL_ARB_instanced_arrays
+#define GL_ARB_instanced_arrays 1
+extern void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint);
+#define glVertexAttribDivisorARB sf_ptrc_glVertexAttribDivisorARB
+#endif // GL_ARB_instanced_arrays
+
+#ifndef GL_ARB_occlusion_query
+#define GL_ARB_occlusion_query 1
+extern void (GL_FUNCPTR *sf_ptrc_glBeginQueryARB)(GLenum, GLuint);
+#define glBeginQueryARB sf_ptrc_glBeginQueryARB
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint*);
+#define glDeleteQueriesARB sf_ptrc_glDeleteQueriesARB
+extern void (GL_FUNCPTR *sf_ptrc_glEndQueryARB)(GLenum);
+#define glEndQueryARB sf_ptrc_glEndQueryARB
+extern void (GL_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint*);
+#define glGenQueriesARB sf_ptrc_glGenQueriesARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectivARB)(GLuint, GLenum, GLint*);
+#define glGetQueryObjectivARB sf_ptrc_glGetQueryObjectivARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint*);
+#define glGetQueryObjectuivARB sf_ptrc_glGetQueryObjectuivARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryivARB)(GLenum, GLenum, GLint*);
+#define glGetQueryivARB sf_ptrc_glGetQueryivARB
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsQueryARB)(GLuint);
+#define glIsQueryARB sf_ptrc_glIsQueryARB
+#endif // GL_ARB_occlusion_query
+
+#ifndef GL_ARB_timer_query
+#define GL_ARB_timer_query 1
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjecti64v)(GLuint, GLenum, GLint64*);
+#define glGetQueryObjecti64v sf_ptrc_glGetQueryObjecti64v
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64*);
+#define glGetQueryObjectui64v sf_ptrc_glGetQueryObjectui64v
+extern void (GL_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum);
+#define glQueryCounter sf_ptrc_glQueryCounter
+#endif // GL_ARB_timer_query
+
+#ifndef GL_ARB_vertex_array_object
+#define GL_ARB_vertex_array_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint);
+#define glBindVertexArray sf_ptrc_glBindVertexArray
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*);
+#define glDeleteVertexArrays sf_ptrc_glDeleteVertexArrays
+extern void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*);
+#define glGenVertexArrays sf_ptrc_glGenVertexArrays
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint);
+#define glIsVertexArray sf_ptrc_glIsVertexArray
+#endif // GL_ARB_vertex_array_object
+
+#ifndef GL_ARB_texture_compression
+#define GL_ARB_texture_compression 1
+extern void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage1DARB)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void*);
+#define glCompressedTexImage1DARB sf_ptrc_glCompressedTexImage1DARB
+extern void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage2DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*);
+#define glCompressedTexImage2DARB sf_ptrc_glCompressedTexImage2DARB
+extern void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage3DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void*);
+#define glCompressedTexImage3DARB sf_ptrc_glCompressedTexImage3DARB
+extern void (GL_FUNCPTR *sf_ptrc_glCompressedTexSubImage1DARB)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void*);
+#define glCompressedTexSubImage1DARB sf_ptrc_glCompressedTexSubImage1DARB
+extern void (GL_FUNCPTR *sf_ptrc_glCompressedTexSubImage2DARB)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void*);
+#define glCompressedTexSubImage2DARB sf_ptrc_glCompressedTexSubImage2DARB
+extern void (GL_FUNCPTR *sf_ptrc_glCompressedTexSubImage3DARB)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void*);
+#define glCompressedTexSubImage3DARB sf_ptrc_glCompressedTexSubImage3DARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetCompressedTexImageARB)(GLenum, GLint, void*);
+#define glGetCompressedTexImageARB sf_ptrc_glGetCompressedTexImageARB
+#endif // GL_ARB_texture_compression
+
 GLAPI void APIENTRY glAccum(GLenum, GLfloat);
 GLAPI void APIENTRY glAlphaFunc(GLenum, GLfloat);
 GLAPI void APIENTRY glBegin(GLenum);
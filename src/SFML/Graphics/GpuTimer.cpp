@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuTimer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GpuTimer::GpuTimer(const std::string& name) :
+m_name     (name),
+m_current  (0),
+m_running  (false),
+m_contextId(0),
+m_elapsed  (Time::Zero)
+{
+    for (unsigned int i = 0; i < MeasurementCount * 2; ++i)
+        m_queries[i] = 0;
+
+    for (unsigned int i = 0; i < MeasurementCount; ++i)
+        m_pending[i] = false;
+}
+
+
+////////////////////////////////////////////////////////////
+GpuTimer::~GpuTimer()
+{
+    // Query objects are not shared between contexts: we can only
+    // delete them if their context is still the active one,
+    // otherwise they will be released along with it
+#ifndef SFML_OPENGL_ES
+
+    if (m_queries[0] && (Context::getActiveContextId() == m_contextId))
+        glCheck(GLEXT_glDeleteQueries(MeasurementCount * 2, m_queries));
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& GpuTimer::getName() const
+{
+    return m_name;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::begin(RenderTarget& target)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!isAvailable() || m_running)
+        return;
+
+    // Don't account the pending batch to this section
+    target.flush();
+
+    if (!target.setActive(true))
+        return;
+
+    if (!m_queries[0])
+    {
+        glCheck(GLEXT_glGenQueries(MeasurementCount * 2, m_queries));
+
+        if (!m_queries[0])
+        {
+            err() << "Failed to create GPU timer queries" << std::endl;
+            return;
+        }
+
+        m_contextId = Context::getActiveContextId();
+    }
+    else if (Context::getActiveContextId() != m_contextId)
+    {
+        err() << "GPU timer \"" << m_name << "\" was used with another render target" << std::endl;
+        return;
+    }
+
+    collect();
+
+    // Skip this measurement if all the slots are still waiting for the GPU
+    if (m_pending[m_current])
+        return;
+
+    glCheck(GLEXT_glQueryCounter(m_queries[m_current * 2], GLEXT_GL_TIMESTAMP));
+    m_running = true;
+
+#else
+
+    (void)target;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::end(RenderTarget& target)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_running)
+        return;
+
+    target.flush();
+
+    m_running = false;
+
+    if (!target.setActive(true) || (Context::getActiveContextId() != m_contextId))
+        return;
+
+    glCheck(GLEXT_glQueryCounter(m_queries[m_current * 2 + 1], GLEXT_GL_TIMESTAMP));
+
+    m_pending[m_current] = true;
+    m_current = (m_current + 1) % MeasurementCount;
+
+    collect();
+
+#else
+
+    (void)target;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+Time GpuTimer::getElapsedTime() const
+{
+    return m_elapsed;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuTimer::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_occlusion_query && GLEXT_timer_query;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::collect()
+{
+#ifndef SFML_OPENGL_ES
+
+    // Go from the oldest measurement to the newest, so that
+    // we end up with the most recent result
+    for (unsigned int i = 0; i < MeasurementCount; ++i)
+    {
+        unsigned int index = (m_current + i) % MeasurementCount;
+
+        if (!m_pending[index])
+            continue;
+
+        // The end query completes last, so checking it is enough
+        GLint available = GL_FALSE;
+        glCheck(GLEXT_glGetQueryObjectiv(m_queries[index * 2 + 1], GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+
+        if (!available)
+            continue;
+
+        GLuint64 start = 0;
+        GLuint64 end = 0;
+        glCheck(GLEXT_glGetQueryObjectui64v(m_queries[index * 2], GLEXT_GL_QUERY_RESULT, &start));
+        glCheck(GLEXT_glGetQueryObjectui64v(m_queries[index * 2 + 1], GLEXT_GL_QUERY_RESULT, &end));
+
+        // Timestamps are in nanoseconds
+        m_elapsed = microseconds(static_cast<Int64>((end - start) / 1000));
+        m_pending[index] = false;
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+} // namespace sf
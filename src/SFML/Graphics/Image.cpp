@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
@@ -35,20 +36,42 @@
 #include <cstring>
 
 
+namespace
+{
+    // Release pixels allocated by the image itself
+    void deletePixels(sf::Uint8* pixels)
+    {
+        delete[] pixels;
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Image::Image() :
-m_size(0, 0)
+m_size   (0, 0),
+m_pixels (NULL),
+m_deleter(NULL)
 {
 
 }
 
 
 ////////////////////////////////////////////////////////////
-Image::~Image()
+Image::Image(const Image& copy) :
+m_size   (0, 0),
+m_pixels (NULL),
+m_deleter(NULL)
 {
+    create(copy.m_size.x, copy.m_size.y, copy.m_pixels);
+}
+
 
+////////////////////////////////////////////////////////////
+Image::~Image()
+{
+    cleanup();
 }
 
 
@@ -58,34 +81,19 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
     if (width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(width * height * 4);
-    
+        std::size_t size = static_cast<std::size_t>(width) * height * 4;
+        Uint8* newPixels = new Uint8[size];
+
         // Fill it with the specified color
-        Uint8* ptr = &newPixels[0];
-        Uint8* end = ptr + newPixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
-    
+        priv::fillPixels(newPixels, size / 4, color);
+
         // Commit the new pixel buffer
-        m_pixels.swap(newPixels);
-        
-        // Assign the new size
-        m_size.x = width;
-        m_size.y = height;
+        adoptPixels(width, height, newPixels, &deletePixels);
     }
     else
     {
         // Dump the pixel buffer
-        std::vector<Uint8>().swap(m_pixels);
-        
-        // Assign the new size
-        m_size.x = 0;
-        m_size.y = 0;
+        cleanup();
     }
 }
 
@@ -96,23 +104,41 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
     if (pixels && width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(pixels, pixels + width * height * 4);
-        
+        std::size_t size = static_cast<std::size_t>(width) * height * 4;
+        Uint8* newPixels = new Uint8[size];
+        std::memcpy(newPixels, pixels, size);
+
         // Commit the new pixel buffer
-        m_pixels.swap(newPixels);
-        
-        // Assign the new size
-        m_size.x = width;
-        m_size.y = height;
+        adoptPixels(width, height, newPixels, &deletePixels);
     }
     else
     {
         // Dump the pixel buffer
-        std::vector<Uint8>().swap(m_pixels);
-        
-        // Assign the new size
-        m_size.x = 0;
-        m_size.y = 0;
+        cleanup();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::adoptPixels(unsigned int width, unsigned int height, Uint8* pixels, PixelsDeleter deleter)
+{
+    // Adopting the current pixels again must not release them
+    if (pixels == m_pixels)
+        m_pixels = NULL;
+
+    cleanup();
+
+    if (pixels && width && height)
+    {
+        m_pixels  = pixels;
+        m_deleter = deleter;
+        m_size.x  = width;
+        m_size.y  = height;
+    }
+    else if (pixels && deleter)
+    {
+        // Nothing to show, release the pixels right away
+        deleter(pixels);
     }
 }
 
@@ -122,7 +148,14 @@ bool Image::loadFromFile(const std::string& filename)
 {
     #ifndef SFML_SYSTEM_ANDROID
 
-        return priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size);
+        // The pixels are decoded in their own buffer, which the image adopts without copying it
+        Uint8* pixels = NULL;
+        Vector2u size;
+        if (!priv::ImageLoader::getInstance().loadImageFromFile(filename, pixels, size))
+            return false;
+
+        adoptPixels(size.x, size.y, pixels, &priv::ImageLoader::freePixels);
+        return true;
 
     #else
 
@@ -136,14 +169,26 @@ bool Image::loadFromFile(const std::string& filename)
 ////////////////////////////////////////////////////////////
 bool Image::loadFromMemory(const void* data, std::size_t size)
 {
-    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    Uint8* pixels = NULL;
+    Vector2u imageSize;
+    if (!priv::ImageLoader::getInstance().loadImageFromMemory(data, size, pixels, imageSize))
+        return false;
+
+    adoptPixels(imageSize.x, imageSize.y, pixels, &priv::ImageLoader::freePixels);
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::loadFromStream(InputStream& stream)
 {
-    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    Uint8* pixels = NULL;
+    Vector2u size;
+    if (!priv::ImageLoader::getInstance().loadImageFromStream(stream, pixels, size))
+        return false;
+
+    adoptPixels(size.x, size.y, pixels, &priv::ImageLoader::freePixels);
+    return true;
 }
 
 
@@ -165,17 +210,10 @@ Vector2u Image::getSize() const
 void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 {
     // Make sure that the image is not empty
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        priv::maskPixels(m_pixels, static_cast<std::size_t>(m_size.x) * m_size.y, color, alpha);
     }
 }
 
@@ -219,29 +257,16 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     int          rows      = height;
     int          srcStride = source.m_size.x * 4;
     int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
-    Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
+    const Uint8* srcPixels = source.m_pixels + (srcRect.left + srcRect.top * source.m_size.x) * 4;
+    Uint8*       dstPixels = m_pixels + (destX + destY * m_size.x) * 4;
 
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row (slower)
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
+            priv::blendPixels(dstPixels, srcPixels, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
@@ -281,9 +306,9 @@ Color Image::getPixel(unsigned int x, unsigned int y) const
 ////////////////////////////////////////////////////////////
 const Uint8* Image::getPixelsPtr() const
 {
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
-        return &m_pixels[0];
+        return m_pixels;
     }
     else
     {
@@ -296,23 +321,12 @@ const Uint8* Image::getPixelsPtr() const
 ////////////////////////////////////////////////////////////
 void Image::flipHorizontally()
 {
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
         std::size_t rowSize = m_size.x * 4;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
-        }
+            priv::reversePixels(m_pixels + y * rowSize, m_size.x);
     }
 }
 
@@ -320,16 +334,16 @@ void Image::flipHorizontally()
 ////////////////////////////////////////////////////////////
 void Image::flipVertically()
 {
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
         std::size_t rowSize = m_size.x * 4;
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        Uint8* top = m_pixels;
+        Uint8* bottom = m_pixels + (m_size.y - 1) * rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
+            priv::swapPixels(top, bottom, m_size.x);
 
             top += rowSize;
             bottom -= rowSize;
@@ -337,4 +351,92 @@ void Image::flipVertically()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    if (m_pixels)
+        priv::premultiplyPixels(m_pixels, static_cast<std::size_t>(m_size.x) * m_size.y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::unpremultiplyAlpha()
+{
+    if (m_pixels)
+        priv::unpremultiplyPixels(m_pixels, static_cast<std::size_t>(m_size.x) * m_size.y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::resize(unsigned int width, unsigned int height, ResamplingFilter filter, unsigned int threadCount)
+{
+    if (!width || !height)
+    {
+        // Dump the pixel buffer
+        cleanup();
+    }
+    else if (m_pixels && ((width != m_size.x) || (height != m_size.y)))
+    {
+        // Resample into a new pixel buffer, then commit it
+        Uint8* newPixels = new Uint8[static_cast<std::size_t>(width) * height * 4];
+        priv::resamplePixels(m_pixels, m_size, newPixels, Vector2u(width, height), filter, threadCount);
+
+        adoptPixels(width, height, newPixels, &deletePixels);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::generateMipChain(std::vector<Image>& levels, ResamplingFilter filter, unsigned int threadCount) const
+{
+    levels.clear();
+
+    if (!m_pixels)
+        return;
+
+    // Count the levels first, so that the vector never reallocates the previous level
+    std::size_t count = 0;
+    for (Vector2u size = m_size; (size.x > 1) || (size.y > 1); ++count)
+        size = Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+
+    levels.resize(count);
+
+    // Compute each level from the previous one
+    const Image* previous = this;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Vector2u size(std::max(previous->m_size.x / 2, 1u), std::max(previous->m_size.y / 2, 1u));
+
+        Uint8* pixels = new Uint8[static_cast<std::size_t>(size.x) * size.y * 4];
+        priv::resamplePixels(previous->m_pixels, previous->m_size, pixels, size, filter, threadCount);
+
+        levels[i].adoptPixels(size.x, size.y, pixels, &deletePixels);
+        previous = &levels[i];
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Image& Image::operator =(const Image& right)
+{
+    if (&right != this)
+        create(right.m_size.x, right.m_size.y, right.m_pixels);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::cleanup()
+{
+    if (m_pixels && m_deleter)
+        m_deleter(m_pixels);
+
+    m_pixels  = NULL;
+    m_deleter = NULL;
+    m_size.x  = 0;
+    m_size.y  = 0;
+}
+
 } // namespace sf
@@ -0,0 +1,613 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define SFML_IMAGEKERNELS_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+namespace
+{
+    // Scalar versions of the kernels, for a single pixel; the vector
+    // versions must give exactly the same results
+    void blendPixel(sf::Uint8* dst, const sf::Uint8* src)
+    {
+        unsigned int alpha = src[3];
+        dst[0] = static_cast<sf::Uint8>((src[0] * alpha + dst[0] * (255 - alpha)) / 255);
+        dst[1] = static_cast<sf::Uint8>((src[1] * alpha + dst[1] * (255 - alpha)) / 255);
+        dst[2] = static_cast<sf::Uint8>((src[2] * alpha + dst[2] * (255 - alpha)) / 255);
+        dst[3] = static_cast<sf::Uint8>(alpha + dst[3] * (255 - alpha) / 255);
+    }
+
+    void premultiplyPixel(sf::Uint8* pixel)
+    {
+        unsigned int alpha = pixel[3];
+        for (int i = 0; i < 3; ++i)
+            pixel[i] = static_cast<sf::Uint8>((pixel[i] * alpha + 127) / 255);
+    }
+
+    void unpremultiplyPixel(sf::Uint8* pixel)
+    {
+        unsigned int alpha = pixel[3];
+        for (int i = 0; i < 3; ++i)
+            pixel[i] = alpha ? static_cast<sf::Uint8>(std::min((pixel[i] * 255 + alpha / 2) / alpha, 255u)) : 0;
+    }
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+
+    // Byte mask selecting the alpha component of each pixel
+    __m128i alphaMask()
+    {
+        const sf::Uint8 pixel[4] = {0, 0, 0, 0xFF};
+        int mask;
+        std::memcpy(&mask, pixel, sizeof(mask));
+        return _mm_set1_epi32(mask);
+    }
+
+    // Color packed in the same byte order as the pixels
+    __m128i splatColor(const sf::Color& color)
+    {
+        const sf::Uint8 pixel[4] = {color.r, color.g, color.b, color.a};
+        int value;
+        std::memcpy(&value, pixel, sizeof(value));
+        return _mm_set1_epi32(value);
+    }
+
+    // Exact x / 255 of 16-bit components, for x <= 65152
+    __m128i divideBy255(__m128i x)
+    {
+        x = _mm_add_epi16(x, _mm_set1_epi16(1));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Broadcast the alpha of each pixel to its 4 components (two pixels of 16-bit components)
+    __m128i broadcastAlpha(__m128i x)
+    {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    // (src * a + dst * (255 - a)) / 255 for two pixels, with a = 255 on the alpha component
+    __m128i blend2(__m128i src, __m128i dst, __m128i alphaLanes)
+    {
+        __m128i alpha      = broadcastAlpha(src);
+        __m128i inverse    = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        __m128i multiplier = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), _mm_and_si128(alphaLanes, _mm_set1_epi16(255)));
+        __m128i sum        = _mm_add_epi16(_mm_mullo_epi16(src, multiplier), _mm_mullo_epi16(dst, inverse));
+        return divideBy255(sum);
+    }
+
+    // (c * a + 127) / 255 for two pixels, with a = 255 on the alpha component
+    __m128i premultiply2(__m128i pixels, __m128i alphaLanes)
+    {
+        __m128i alpha      = broadcastAlpha(pixels);
+        __m128i multiplier = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), _mm_and_si128(alphaLanes, _mm_set1_epi16(255)));
+        return divideBy255(_mm_add_epi16(_mm_mullo_epi16(pixels, multiplier), _mm_set1_epi16(127)));
+    }
+
+    // (c * 255 + a / 2) / a for one pixel of 32-bit components; the quotient is
+    // exact below 256, and 0 / 0 converts to an out of range value that packing clamps to 0
+    __m128i unpremultiply1(__m128i pixel)
+    {
+        __m128i alpha     = _mm_shuffle_epi32(pixel, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i numerator = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(pixel, 8), pixel), _mm_srli_epi32(alpha, 1));
+        return _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(numerator), _mm_cvtepi32_ps(alpha)));
+    }
+
+#endif
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+
+    // Premultiplied RGBA components, as floats
+    typedef __m128 Sample;
+
+    Sample zeroSample()
+    {
+        return _mm_setzero_ps();
+    }
+
+    Sample loadSample(const float* components)
+    {
+        return _mm_loadu_ps(components);
+    }
+
+    void storeSample(float* components, Sample sample)
+    {
+        _mm_storeu_ps(components, sample);
+    }
+
+    Sample addWeighted(Sample sum, Sample sample, float weight)
+    {
+        return _mm_add_ps(sum, _mm_mul_ps(sample, _mm_set1_ps(weight)));
+    }
+
+#else
+
+    // Premultiplied RGBA components, as floats
+    struct Sample
+    {
+        float components[4];
+    };
+
+    Sample zeroSample()
+    {
+        Sample sample = {{0.f, 0.f, 0.f, 0.f}};
+        return sample;
+    }
+
+    Sample loadSample(const float* components)
+    {
+        Sample sample = {{components[0], components[1], components[2], components[3]}};
+        return sample;
+    }
+
+    void storeSample(float* components, Sample sample)
+    {
+        std::memcpy(components, sample.components, sizeof(sample.components));
+    }
+
+    Sample addWeighted(Sample sum, Sample sample, float weight)
+    {
+        for (int i = 0; i < 4; ++i)
+            sum.components[i] += sample.components[i] * weight;
+        return sum;
+    }
+
+#endif
+
+    // Filter kernels, as a function of the distance to the sample in source pixels
+    float filterRadius(sf::Image::ResamplingFilter filter)
+    {
+        switch (filter)
+        {
+            case sf::Image::Box:      return 0.5f;
+            case sf::Image::Bilinear: return 1.f;
+            default:                  return 3.f;
+        }
+    }
+
+    float sinc(float x)
+    {
+        if (x == 0.f)
+            return 1.f;
+
+        x *= 3.14159265358979f;
+        return std::sin(x) / x;
+    }
+
+    float filterWeight(sf::Image::ResamplingFilter filter, float x)
+    {
+        switch (filter)
+        {
+            case sf::Image::Box:      return ((x >= -0.5f) && (x < 0.5f)) ? 1.f : 0.f;
+            case sf::Image::Bilinear: return std::max(1.f - std::fabs(x), 0.f);
+            default:                  return (std::fabs(x) < 3.f) ? sinc(x) * sinc(x / 3.f) : 0.f;
+        }
+    }
+
+    // Source pixels and weights contributing to each destination pixel, along one axis
+    struct Taps
+    {
+        std::vector<unsigned int> first;   // First source pixel of each destination pixel
+        std::vector<unsigned int> count;   // Number of source pixels of each destination pixel
+        std::vector<float>        weights; // Normalized weights, 'stride' per destination pixel
+        unsigned int              stride;  // Maximum number of source pixels of a destination pixel
+    };
+
+    void computeTaps(Taps& taps, unsigned int sourceSize, unsigned int destinationSize, sf::Image::ResamplingFilter filter)
+    {
+        // When shrinking, the filter is stretched to cover all the source pixels
+        float scale       = static_cast<float>(sourceSize) / destinationSize;
+        float filterScale = std::max(scale, 1.f);
+        float radius      = filterRadius(filter) * filterScale;
+
+        taps.stride = static_cast<unsigned int>(std::ceil(radius * 2)) + 2;
+        taps.first.resize(destinationSize);
+        taps.count.resize(destinationSize);
+        taps.weights.assign(destinationSize * taps.stride, 0.f);
+
+        for (unsigned int i = 0; i < destinationSize; ++i)
+        {
+            float center = (i + 0.5f) * scale;
+            int   begin  = std::max(static_cast<int>(std::floor(center - radius)), 0);
+            int   end    = std::min(static_cast<int>(std::ceil(center + radius)), static_cast<int>(sourceSize));
+
+            float*       weights = &taps.weights[i * taps.stride];
+            unsigned int count   = 0;
+            float        total   = 0.f;
+            for (int j = begin; (j < end) && (count < taps.stride); ++j)
+            {
+                float weight = filterWeight(filter, (j + 0.5f - center) / filterScale);
+
+                // Skip the leading source pixels that don't contribute
+                if ((count == 0) && (weight == 0.f))
+                {
+                    ++begin;
+                    continue;
+                }
+
+                weights[count++] = weight;
+                total += weight;
+            }
+
+            if (total != 0.f)
+            {
+                for (unsigned int j = 0; j < count; ++j)
+                    weights[j] /= total;
+            }
+            else
+            {
+                // No pixel under the filter (only possible at the edges): use the nearest one
+                begin      = std::min(static_cast<int>(center), static_cast<int>(sourceSize) - 1);
+                weights[0] = 1.f;
+                count      = 1;
+            }
+
+            taps.first[i] = static_cast<unsigned int>(begin);
+            taps.count[i] = count;
+        }
+    }
+
+    // Rows of the destination computed by a thread
+    struct ResampleJob
+    {
+        const sf::Uint8* source;
+        sf::Vector2u     sourceSize;
+        sf::Uint8*       destination;
+        sf::Vector2u     destinationSize;
+        const Taps*      horizontal;
+        const Taps*      vertical;
+        unsigned int     rowBegin;
+        unsigned int     rowEnd;
+    };
+
+    void resampleRows(ResampleJob* job)
+    {
+        // Destination rows are computed by chunks, so that the horizontally
+        // filtered source rows that they need stay small
+        const unsigned int chunkSize = 32;
+
+        const unsigned int sourceWidth      = job->sourceSize.x;
+        const unsigned int destinationWidth = job->destinationSize.x;
+        const Taps&        horizontal       = *job->horizontal;
+        const Taps&        vertical         = *job->vertical;
+
+        std::vector<float> sourceRow(sourceWidth * 4);
+        std::vector<float> filteredRows;
+        std::vector<float> sums(destinationWidth * 4);
+
+        for (unsigned int chunkBegin = job->rowBegin; chunkBegin < job->rowEnd; chunkBegin += chunkSize)
+        {
+            unsigned int chunkEnd = std::min(chunkBegin + chunkSize, job->rowEnd);
+
+            // Find the source rows needed by the chunk
+            unsigned int firstRow = vertical.first[chunkBegin];
+            unsigned int lastRow  = firstRow;
+            for (unsigned int y = chunkBegin; y < chunkEnd; ++y)
+            {
+                firstRow = std::min(firstRow, vertical.first[y]);
+                lastRow  = std::max(lastRow, vertical.first[y] + vertical.count[y]);
+            }
+
+            // Filter them horizontally, with premultiplied colors
+            filteredRows.resize((lastRow - firstRow) * destinationWidth * 4);
+            for (unsigned int y = firstRow; y < lastRow; ++y)
+            {
+                const sf::Uint8* pixel = job->source + static_cast<std::size_t>(y) * sourceWidth * 4;
+                for (unsigned int x = 0; x < sourceWidth; ++x, pixel += 4)
+                {
+                    float alpha = pixel[3] * (1.f / 255.f);
+                    sourceRow[x * 4 + 0] = pixel[0] * alpha;
+                    sourceRow[x * 4 + 1] = pixel[1] * alpha;
+                    sourceRow[x * 4 + 2] = pixel[2] * alpha;
+                    sourceRow[x * 4 + 3] = pixel[3];
+                }
+
+                float* filtered = &filteredRows[(y - firstRow) * destinationWidth * 4];
+                for (unsigned int x = 0; x < destinationWidth; ++x)
+                {
+                    const float* samples = &sourceRow[horizontal.first[x] * 4];
+                    const float* weights = &horizontal.weights[x * horizontal.stride];
+
+                    Sample sum = zeroSample();
+                    for (unsigned int i = 0; i < horizontal.count[x]; ++i)
+                        sum = addWeighted(sum, loadSample(samples + i * 4), weights[i]);
+                    storeSample(filtered + x * 4, sum);
+                }
+            }
+
+            // Then filter the chunk vertically, and convert it back to straight alpha
+            for (unsigned int y = chunkBegin; y < chunkEnd; ++y)
+            {
+                std::fill(sums.begin(), sums.end(), 0.f);
+
+                const float* weights = &vertical.weights[y * vertical.stride];
+                for (unsigned int i = 0; i < vertical.count[y]; ++i)
+                {
+                    const float* filtered = &filteredRows[(vertical.first[y] + i - firstRow) * destinationWidth * 4];
+                    for (unsigned int x = 0; x < destinationWidth; ++x)
+                        storeSample(&sums[x * 4], addWeighted(loadSample(&sums[x * 4]), loadSample(filtered + x * 4), weights[i]));
+                }
+
+                sf::Uint8* pixel = job->destination + static_cast<std::size_t>(y) * destinationWidth * 4;
+                for (unsigned int x = 0; x < destinationWidth; ++x, pixel += 4)
+                {
+                    // Negative lobes may produce out of range components, which are clamped
+                    const float* sum    = &sums[x * 4];
+                    float        alpha  = std::min(std::max(sum[3], 0.f), 255.f);
+                    float        factor = (alpha > 0.f) ? 255.f / alpha : 0.f;
+                    for (int i = 0; i < 3; ++i)
+                        pixel[i] = static_cast<sf::Uint8>(std::min(std::max(sum[i], 0.f), alpha) * factor + 0.5f);
+                    pixel[3] = static_cast<sf::Uint8>(alpha + 0.5f);
+                }
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t count, const Color& color)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+    __m128i value = splatColor(color);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), value);
+#endif
+
+    for (Uint8* pixel = pixels + i * 4; i < count; ++i, pixel += 4)
+    {
+        pixel[0] = color.r;
+        pixel[1] = color.g;
+        pixel[2] = color.b;
+        pixel[3] = color.a;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* dst, const Uint8* src, std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+    const __m128i zero       = _mm_setzero_si128();
+    const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i source      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        __m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+
+        __m128i low  = blend2(_mm_unpacklo_epi8(source, zero), _mm_unpacklo_epi8(destination, zero), alphaLanes);
+        __m128i high = blend2(_mm_unpackhi_epi8(source, zero), _mm_unpackhi_epi8(destination, zero), alphaLanes);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(low, high));
+    }
+#endif
+
+    for (; i < count; ++i)
+        blendPixel(dst + i * 4, src + i * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Color& color, Uint8 alpha)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+    const __m128i key      = splatColor(color);
+    const __m128i mask     = alphaMask();
+    const __m128i newAlpha = _mm_and_si128(_mm_set1_epi8(static_cast<char>(alpha)), mask);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* block = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  value = _mm_loadu_si128(block);
+
+        // Select the alpha component of the pixels that match the key
+        __m128i selected = _mm_and_si128(_mm_cmpeq_epi32(value, key), mask);
+        if (_mm_movemask_epi8(selected))
+            _mm_storeu_si128(block, _mm_or_si128(_mm_andnot_si128(selected, value), _mm_and_si128(selected, newAlpha)));
+    }
+#endif
+
+    for (Uint8* pixel = pixels + i * 4; i < count; ++i, pixel += 4)
+    {
+        if ((pixel[0] == color.r) && (pixel[1] == color.g) && (pixel[2] == color.b) && (pixel[3] == color.a))
+            pixel[3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count)
+{
+    Uint8* left  = pixels;
+    Uint8* right = pixels + count * 4;
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+    // Exchange blocks of 4 pixels from both ends, reversing each block
+    while (right - left >= 32)
+    {
+        right -= 16;
+
+        __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left), _mm_shuffle_epi32(second, _MM_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(first, _MM_SHUFFLE(0, 1, 2, 3)));
+
+        left += 16;
+    }
+#endif
+
+    while (right - left >= 8)
+    {
+        right -= 4;
+        std::swap_ranges(left, left + 4, right);
+        left += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* a = reinterpret_cast<__m128i*>(first + i * 4);
+        __m128i* b = reinterpret_cast<__m128i*>(second + i * 4);
+
+        __m128i value = _mm_loadu_si128(a);
+        _mm_storeu_si128(a, _mm_loadu_si128(b));
+        _mm_storeu_si128(b, value);
+    }
+#endif
+
+    std::swap_ranges(first + i * 4, first + count * 4, second + i * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+    const __m128i zero       = _mm_setzero_si128();
+    const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* block = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  value = _mm_loadu_si128(block);
+
+        __m128i low  = premultiply2(_mm_unpacklo_epi8(value, zero), alphaLanes);
+        __m128i high = premultiply2(_mm_unpackhi_epi8(value, zero), alphaLanes);
+
+        _mm_storeu_si128(block, _mm_packus_epi16(low, high));
+    }
+#endif
+
+    for (; i < count; ++i)
+        premultiplyPixel(pixels + i * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void unpremultiplyPixels(Uint8* pixels, std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = alphaMask();
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* block = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  value = _mm_loadu_si128(block);
+
+        // Widen each pixel to 32-bit components
+        __m128i low  = _mm_unpacklo_epi8(value, zero);
+        __m128i high = _mm_unpackhi_epi8(value, zero);
+        __m128i p0   = unpremultiply1(_mm_unpacklo_epi16(low, zero));
+        __m128i p1   = unpremultiply1(_mm_unpackhi_epi16(low, zero));
+        __m128i p2   = unpremultiply1(_mm_unpacklo_epi16(high, zero));
+        __m128i p3   = unpremultiply1(_mm_unpackhi_epi16(high, zero));
+
+        // Narrow back with saturation, then restore the original alpha
+        __m128i result = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+        _mm_storeu_si128(block, _mm_or_si128(_mm_andnot_si128(mask, result), _mm_and_si128(mask, value)));
+    }
+#endif
+
+    for (; i < count; ++i)
+        unpremultiplyPixel(pixels + i * 4);
+}
+
+
+
+////////////////////////////////////////////////////////////
+void resamplePixels(const Uint8* source, const Vector2u& sourceSize, Uint8* destination, const Vector2u& destinationSize,
+                    Image::ResamplingFilter filter, unsigned int threadCount)
+{
+    Taps horizontal;
+    Taps vertical;
+    computeTaps(horizontal, sourceSize.x, destinationSize.x, filter);
+    computeTaps(vertical, sourceSize.y, destinationSize.y, filter);
+
+    // Give each thread a band of at least a few rows
+    threadCount = std::max(std::min(threadCount, destinationSize.y / 16), 1u);
+
+    std::vector<ResampleJob> jobs(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        jobs[i].source          = source;
+        jobs[i].sourceSize      = sourceSize;
+        jobs[i].destination     = destination;
+        jobs[i].destinationSize = destinationSize;
+        jobs[i].horizontal      = &horizontal;
+        jobs[i].vertical        = &vertical;
+        jobs[i].rowBegin        = destinationSize.y * i / threadCount;
+        jobs[i].rowEnd          = destinationSize.y * (i + 1) / threadCount;
+    }
+
+    // The calling thread computes the first band
+    std::vector<Thread*> threads;
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads.push_back(new Thread(&resampleRows, &jobs[i]));
+        threads.back()->launch();
+    }
+
+    resampleRows(&jobs[0]);
+
+    for (std::vector<Thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
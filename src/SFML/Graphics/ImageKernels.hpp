@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEKERNELS_HPP
+#define SFML_IMAGEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// Pixel kernels used by sf::Image
+//
+// All the kernels work on contiguous RGBA pixels, and use
+// SSE2 when the compiler targets it. The integer kernels
+// produce exactly the same results as their scalar versions
+// on any platform.
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \brief Fill pixels with a color
+///
+/// \param pixels Pixels to fill
+/// \param count  Number of pixels
+/// \param color  Fill color
+///
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t count, const Color& color);
+
+////////////////////////////////////////////////////////////
+/// \brief Blend source pixels over destination pixels
+///
+/// Each color component becomes (src * a + dst * (255 - a)) / 255
+/// and the alpha becomes a + dst * (255 - a) / 255, where a is
+/// the alpha of the source pixel.
+///
+/// \param dst   Destination pixels
+/// \param src   Source pixels
+/// \param count Number of pixels
+///
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* dst, const Uint8* src, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Replace the alpha of the pixels that match a color
+///
+/// \param pixels Pixels to modify
+/// \param count  Number of pixels
+/// \param color  Color to match, alpha included
+/// \param alpha  New alpha of the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Color& color, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of pixels (mirror a row)
+///
+/// \param pixels Pixels to reverse
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Exchange two non-overlapping ranges of pixels
+///
+/// \param first  First range of pixels
+/// \param second Second range of pixels
+/// \param count  Number of pixels in each range
+///
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply the color components of pixels by their alpha
+///
+/// Each color component becomes (c * a + 127) / 255,
+/// the alpha is left unchanged.
+///
+/// \param pixels Pixels to modify
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Divide the color components of pixels by their alpha
+///
+/// Each color component becomes min((c * 255 + a / 2) / a, 255),
+/// or 0 if the pixel is fully transparent. The alpha is left
+/// unchanged.
+///
+/// \param pixels Pixels to modify
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void unpremultiplyPixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Resample pixels to a new size
+///
+/// The filter is applied separably (rows, then columns) on
+/// premultiplied colors, and widened when shrinking so that
+/// every source pixel contributes to the result.
+///
+/// \param source          Source pixels
+/// \param sourceSize      Size of the source, in pixels
+/// \param destination     Destination pixels
+/// \param destinationSize Size of the destination, in pixels
+/// \param filter          Resampling filter
+/// \param threadCount     Number of threads sharing the rows of the destination
+///
+////////////////////////////////////////////////////////////
+void resamplePixels(const Uint8* source, const Vector2u& sourceSize, Uint8* destination, const Vector2u& destinationSize,
+                    Image::ResamplingFilter filter, unsigned int threadCount);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEKERNELS_HPP
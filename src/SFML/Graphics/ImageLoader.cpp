@@ -27,12 +27,15 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FileInputStream.hpp>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 #include <cctype>
+#include <cstdlib>
 
 
 namespace
@@ -61,6 +64,29 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+    // Decompress the base level of a KTX or DDS file, into pixels released like stb_image's ones
+    bool decompressImage(const void* data, std::size_t dataSize, sf::Uint8*& pixels, sf::Vector2u& size)
+    {
+        sf::priv::CompressedImage image;
+        if (!sf::priv::loadCompressedImage(data, dataSize, image))
+            return false;
+
+        const sf::Vector2u imageSize   = image.levels[0].size;
+        sf::Uint8*         imagePixels = static_cast<sf::Uint8*>(std::malloc(static_cast<std::size_t>(imageSize.x) * imageSize.y * 4));
+
+        if (!imagePixels || !sf::priv::decompressLevel(image, 0, imagePixels))
+        {
+            std::free(imagePixels);
+            sf::err() << "Failed to decompress image, unsupported format (" << image.format << ")" << std::endl;
+            return false;
+        }
+
+        size   = imageSize;
+        pixels = imagePixels;
+
+        return true;
+    }
 }
 
 
@@ -92,10 +118,20 @@ ImageLoader::~ImageLoader()
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromFile(const std::string& filename, Uint8*& pixels, Vector2u& size)
 {
-    // Clear the array (just in case)
-    pixels.clear();
+    // Compressed image files are not supported by stb_image
+    const std::size_t dot = filename.find_last_of('.');
+    const std::string extension = dot != std::string::npos ? toLower(filename.substr(dot + 1)) : "";
+    if ((extension == "dds") || (extension == "ktx"))
+    {
+        FileInputStream stream;
+        if (stream.open(filename) && loadImageFromStream(stream, pixels, size))
+            return true;
+
+        err() << "Failed to load image \"" << filename << "\"" << std::endl;
+        return false;
+    }
 
     // Load the image and get a pointer to the pixels in memory
     int width = 0;
@@ -105,19 +141,10 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
 
     if (ptr)
     {
-        // Assign the image properties
+        // Hand the decoded pixels over to the caller, without copying them
         size.x = width;
         size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        pixels = ptr;
 
         return true;
     }
@@ -132,13 +159,14 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, Uint8*& pixels, Vector2u& size)
 {
     // Check input parameters
     if (data && dataSize)
     {
-        // Clear the array (just in case)
-        pixels.clear();
+        // Compressed image files are not supported by stb_image
+        if (isCompressedImageFile(data, dataSize))
+            return decompressImage(data, dataSize, pixels, size);
 
         // Load the image and get a pointer to the pixels in memory
         int width = 0;
@@ -149,19 +177,10 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
 
         if (ptr)
         {
-            // Assign the image properties
+            // Hand the decoded pixels over to the caller, without copying them
             size.x = width;
             size.y = height;
-
-            if (width && height)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(width * height * 4);
-                memcpy(&pixels[0], ptr, pixels.size());
-            }
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
+            pixels = ptr;
 
             return true;
         }
@@ -182,10 +201,20 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromStream(InputStream& stream, Uint8*& pixels, Vector2u& size)
 {
-    // Clear the array (just in case)
-    pixels.clear();
+    // Compressed image files are not supported by stb_image, they are read entirely
+    Uint8 identifier[12];
+    stream.seek(0);
+    if ((stream.read(identifier, sizeof(identifier)) == sizeof(identifier)) && isCompressedImageFile(identifier, sizeof(identifier)))
+    {
+        std::vector<Uint8> data(static_cast<std::size_t>(stream.getSize()));
+        if ((stream.seek(0) == 0) && (stream.read(&data[0], data.size()) == static_cast<Int64>(data.size())))
+            return decompressImage(&data[0], data.size(), pixels, size);
+
+        err() << "Failed to load image from stream, failed to read the data" << std::endl;
+        return false;
+    }
 
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
@@ -204,19 +233,10 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
     if (ptr)
     {
-        // Assign the image properties
+        // Hand the decoded pixels over to the caller, without copying them
         size.x = width;
         size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        pixels = ptr;
 
         return true;
     }
@@ -231,10 +251,10 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToFile(const std::string& filename, const Uint8* pixels, const Vector2u& size)
 {
     // Make sure the image is not empty
-    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
+    if (pixels && (size.x > 0) && (size.y > 0))
     {
         // Deduce the image type from its extension
 
@@ -245,25 +265,25 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
         if (extension == "bmp")
         {
             // BMP format
-            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, pixels))
                 return true;
         }
         else if (extension == "tga")
         {
             // TGA format
-            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, pixels))
                 return true;
         }
         else if (extension == "png")
         {
             // PNG format
-            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
+            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, pixels, 0))
                 return true;
         }
         else if (extension == "jpg" || extension == "jpeg")
         {
             // JPG format
-            if (stbi_write_jpg(filename.c_str(), size.x, size.y, 4, &pixels[0], 90))
+            if (stbi_write_jpg(filename.c_str(), size.x, size.y, 4, pixels, 90))
                 return true;
         }
     }
@@ -272,6 +292,13 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
     return false;
 }
 
+
+////////////////////////////////////////////////////////////
+void ImageLoader::freePixels(Uint8* pixels)
+{
+    stbi_image_free(pixels);
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -43,6 +43,11 @@ namespace priv
 ////////////////////////////////////////////////////////////
 /// \brief Load/save image files
 ///
+/// The loader has no state of its own, so its functions can be
+/// called from several threads at once (see sf::AssetLoader).
+/// Only the failure reason reported by stb_image is global, so
+/// the error message of concurrent failures may be mixed up.
+///
 ////////////////////////////////////////////////////////////
 class ImageLoader : NonCopyable
 {
@@ -60,38 +65,38 @@ public:
     /// \brief Load an image from a file on disk
     ///
     /// \param filename Path of image file to load
-    /// \param pixels   Array of pixels to fill with loaded image
+    /// \param pixels   Receives the pixels of the loaded image, to release with freePixels
     /// \param size     Size of loaded image, in pixels
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromFile(const std::string& filename, Uint8*& pixels, Vector2u& size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file in memory
     ///
     /// \param data     Pointer to the file data in memory
     /// \param dataSize Size of the data to load, in bytes
-    /// \param pixels   Array of pixels to fill with loaded image
+    /// \param pixels   Receives the pixels of the loaded image, to release with freePixels
     /// \param size     Size of loaded image, in pixels
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, Uint8*& pixels, Vector2u& size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a custom stream
     ///
     /// \param stream Source stream to read from
-    /// \param pixels Array of pixels to fill with loaded image
+    /// \param pixels Receives the pixels of the loaded image, to release with freePixels
     /// \param size   Size of loaded image, in pixels
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromStream(InputStream& stream, Uint8*& pixels, Vector2u& size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
@@ -103,7 +108,15 @@ public:
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToFile(const std::string& filename, const Uint8* pixels, const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the pixels of a loaded image
+    ///
+    /// \param pixels Pixels returned by one of the load functions
+    ///
+    ////////////////////////////////////////////////////////////
+    static void freePixels(Uint8* pixels);
 
 private:
 
@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/InstanceBuffer.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    // Layout of a single instance in graphics memory
+    struct PackedInstance
+    {
+        float     row0[3];
+        float     row1[3];
+        sf::Uint8 color[4];
+        float     textureRect[4];
+    };
+
+    // Convert an instance to its layout in graphics memory
+    PackedInstance pack(const sf::InstanceBuffer::Instance& instance)
+    {
+        const float* matrix = instance.transform.getMatrix();
+
+        PackedInstance packed;
+        packed.row0[0] = matrix[0];
+        packed.row0[1] = matrix[4];
+        packed.row0[2] = matrix[12];
+        packed.row1[0] = matrix[1];
+        packed.row1[1] = matrix[5];
+        packed.row1[2] = matrix[13];
+        packed.color[0] = instance.color.r;
+        packed.color[1] = instance.color.g;
+        packed.color[2] = instance.color.b;
+        packed.color[3] = instance.color.a;
+        packed.textureRect[0] = instance.textureRect.left;
+        packed.textureRect[1] = instance.textureRect.top;
+        packed.textureRect[2] = instance.textureRect.width;
+        packed.textureRect[3] = instance.textureRect.height;
+
+        return packed;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+InstanceBuffer::Instance::Instance() :
+transform  (),
+color      (Color::White),
+textureRect(0, 0, 1, 1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer::Instance::Instance(const Transform& theTransform, const Color& theColor, const FloatRect& theTextureRect) :
+transform  (theTransform),
+color      (theColor),
+textureRect(theTextureRect)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer::InstanceBuffer() :
+m_instances (),
+m_buffer    (0),
+m_size      (0),
+m_needUpload(true),
+m_geometry  (),
+m_geometryId(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer::InstanceBuffer(const InstanceBuffer& copy) :
+m_instances (copy.m_instances),
+m_buffer    (0),
+m_size      (0),
+m_needUpload(true),
+m_geometry  (copy.m_geometry),
+m_geometryId(copy.m_geometryId)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer::~InstanceBuffer()
+{
+    if (m_buffer)
+    {
+        TransientContextLock contextLock;
+
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t InstanceBuffer::getInstanceCount() const
+{
+    return m_instances.size();
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer::Instance& InstanceBuffer::operator [](std::size_t index)
+{
+    m_needUpload = true;
+
+    return m_instances[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const InstanceBuffer::Instance& InstanceBuffer::operator [](std::size_t index) const
+{
+    return m_instances[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::clear()
+{
+    m_instances.clear();
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::resize(std::size_t instanceCount)
+{
+    m_instances.resize(instanceCount);
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::append(const Instance& instance)
+{
+    m_instances.push_back(instance);
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer& InstanceBuffer::operator =(const InstanceBuffer& right)
+{
+    InstanceBuffer temp(right);
+
+    swap(temp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::swap(InstanceBuffer& right)
+{
+    std::swap(m_instances,  right.m_instances);
+    std::swap(m_buffer,     right.m_buffer);
+    std::swap(m_size,       right.m_size);
+    std::swap(m_needUpload, right.m_needUpload);
+    std::swap(m_geometry,   right.m_geometry);
+    std::swap(m_geometryId, right.m_geometryId);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int InstanceBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstanceBuffer::bind(const InstanceBuffer* instanceBuffer)
+{
+    if (!VertexBuffer::isAvailable())
+        return false;
+
+    TransientContextLock lock;
+
+    if (!instanceBuffer)
+    {
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+        return true;
+    }
+
+    if (!instanceBuffer->m_buffer)
+        glCheck(GLEXT_glGenBuffers(1, &instanceBuffer->m_buffer));
+
+    if (!instanceBuffer->m_buffer)
+    {
+        err() << "Could not create instance buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, instanceBuffer->m_buffer));
+
+    if (instanceBuffer->m_needUpload)
+    {
+        std::vector<PackedInstance> packed(instanceBuffer->m_instances.size());
+        for (std::size_t i = 0; i < packed.size(); ++i)
+            packed[i] = pack(instanceBuffer->m_instances[i]);
+
+        std::size_t size = sizeof(PackedInstance) * packed.size();
+
+        // Respecify the storage (keeping its largest size) so that the
+        // driver can orphan it rather than wait for previous draws
+        instanceBuffer->m_size = std::max(instanceBuffer->m_size, packed.size());
+
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(PackedInstance) * instanceBuffer->m_size, 0, GLEXT_GL_STREAM_DRAW));
+
+        if (size)
+            glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, 0, size, &packed[0]));
+
+        instanceBuffer->m_needUpload = false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstanceBuffer::isAvailable()
+{
+    // Hardware instancing relies on our own instancing shader
+    if (!VertexBuffer::isAvailable() || !Shader::isAvailable())
+        return false;
+
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_draw_instanced && GLEXT_instanced_arrays;
+    }
+
+    return available;
+}
+
+} // namespace sf
@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderCommandList.hpp>
+#include <SFML/Graphics/DrawRecorder.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/InstanceBuffer.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderCommandList::RenderCommandList() :
+m_recorder(NULL),
+m_commands(),
+m_vertices()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderCommandList::~RenderCommandList()
+{
+    delete m_recorder;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(const Drawable& drawable, const RenderStates& states)
+{
+    if (!m_recorder)
+        m_recorder = new priv::DrawRecorder<RenderCommandList>(*this);
+
+    m_recorder->draw(drawable, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(const Vertex* vertices, std::size_t vertexCount,
+                             PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    Command command;
+    command.states         = states;
+    command.type           = type;
+    command.vertexBuffer   = NULL;
+    command.indexBuffer    = NULL;
+    command.instanceBuffer = NULL;
+    command.firstVertex    = m_vertices.size();
+    command.vertexCount    = vertexCount;
+
+    m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+    m_commands.push_back(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (vertexCount == 0)
+        return;
+
+    Command command;
+    command.states         = states;
+    command.type           = vertexBuffer.getPrimitiveType();
+    command.vertexBuffer   = &vertexBuffer;
+    command.indexBuffer    = NULL;
+    command.instanceBuffer = NULL;
+    command.firstVertex    = firstVertex;
+    command.vertexCount    = vertexCount;
+
+    m_commands.push_back(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, indexBuffer, 0, indexBuffer.getIndexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (indexCount == 0)
+        return;
+
+    Command command;
+    command.states         = states;
+    command.type           = vertexBuffer.getPrimitiveType();
+    command.vertexBuffer   = &vertexBuffer;
+    command.indexBuffer    = &indexBuffer;
+    command.instanceBuffer = NULL;
+    command.firstVertex    = firstIndex;
+    command.vertexCount    = indexCount;
+
+    m_commands.push_back(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::drawInstanced(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states)
+{
+    // Nothing to draw? (the vertex buffer is checked when the instances are replayed)
+    if (instanceBuffer.getInstanceCount() == 0)
+        return;
+
+    Command command;
+    command.states         = states;
+    command.type           = vertexBuffer.getPrimitiveType();
+    command.vertexBuffer   = &vertexBuffer;
+    command.indexBuffer    = NULL;
+    command.instanceBuffer = &instanceBuffer;
+    command.firstVertex    = 0;
+    command.vertexCount    = vertexBuffer.getVertexCount();
+
+    m_commands.push_back(command);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderCommandList::getCommandCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderCommandList::getVertexCount() const
+{
+    return m_vertices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::reserve(std::size_t commandCount, std::size_t vertexCount)
+{
+    m_commands.reserve(commandCount);
+    m_vertices.reserve(vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::clear()
+{
+    m_commands.clear();
+    m_vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::replay(RenderTarget& target) const
+{
+    for (std::vector<Command>::const_iterator it = m_commands.begin(); it != m_commands.end(); ++it)
+    {
+        if (it->instanceBuffer)
+            target.drawInstanced(*it->vertexBuffer, *it->instanceBuffer, it->states);
+        else if (it->indexBuffer)
+            target.draw(*it->vertexBuffer, *it->indexBuffer, it->firstVertex, it->vertexCount, it->states);
+        else if (it->vertexBuffer)
+            target.draw(*it->vertexBuffer, it->firstVertex, it->vertexCount, it->states);
+        else
+            target.draw(&m_vertices[it->firstVertex], it->vertexCount, it->type, it->states);
+    }
+}
+
+} // namespace sf
@@ -27,19 +27,27 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/GpuTimer.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/InstanceBuffer.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexRingBuffer.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Window/Context.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <cassert>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
 #include <map>
+#include <utility>
 
 
 // GL_QUADS is unavailable on OpenGL ES, thus we need to define GL_QUADS ourselves
@@ -50,38 +58,71 @@
 #endif // SFML_OPENGL_ES
 
 
-namespace
-{
-    // Mutex to protect ID generation and our context-RenderTarget-map
-    sf::Mutex mutex;
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
 
-    // Unique identifier, used for identifying RenderTargets when
-    // tracking the currently active RenderTarget within a given context
-    sf::Uint64 getUniqueId()
-    {
-        sf::Lock lock(mutex);
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
 
-        static sf::Uint64 id = 1; // start at 1, zero is "no RenderTarget"
+    #define castToGlHandle(x) (x)
 
-        return id++;
+#endif
+
+
+namespace
+{
+    // RenderTarget that was last activated in the current thread, to help us
+    // detect whether a different RenderTarget has been activated since then
+    // A context can only be active in one thread at a time, so tracking
+    // this per thread requires neither a lock nor a lookup
+    sf::ThreadLocalPtr<sf::RenderTarget> activeTarget(NULL);
+
+    // Check if a RenderTarget is active in the current context, given the
+    // activation of the context in which it was last activated; a context
+    // that was released (and maybe used by another thread) in the meantime
+    // has a new activation number, so the target must be activated again
+    bool isActive(const sf::RenderTarget* target, sf::Uint64 activationId)
+    {
+        return (activeTarget == target) && (activationId == sf::Context::getActivationId());
     }
 
-    // Map to help us detect whether a different RenderTarget
-    // has been activated within a single context
-    typedef std::map<sf::Uint64, sf::Uint64> ContextRenderTargetMap;
-    ContextRenderTargetMap contextRenderTargetMap;
+    // Vertex array objects of the core profile backend, one per context
+    // Vertex array objects are not shared between contexts, so each context
+    // gets its own on first use, shared by all the targets drawing in it
+    std::map<sf::Uint64, unsigned int> vertexArrays;
+
+    // Mutex to protect the vertex array objects
+    sf::Mutex vertexArraysMutex;
 
-    // Check if a RenderTarget with the given ID is active in the current context
-    bool isActive(sf::Uint64 id)
+    // Callback that is called every time a context is destroyed
+    void destroyVertexArray(void* /* arg */)
     {
-        ContextRenderTargetMap::iterator iter = contextRenderTargetMap.find(sf::Context::getActiveContextId());
+#ifndef SFML_OPENGL_ES
+
+        sf::Lock lock(vertexArraysMutex);
+
+        std::map<sf::Uint64, unsigned int>::iterator iter = vertexArrays.find(sf::Context::getActiveContextId());
 
-        if ((iter == contextRenderTargetMap.end()) || (iter->second != id))
-            return false;
+        if (iter != vertexArrays.end())
+        {
+            GLuint vertexArray = static_cast<GLuint>(iter->second);
+            glCheck(GLEXT_glDeleteVertexArrays(1, &vertexArray));
+
+            vertexArrays.erase(iter);
+        }
 
-        return true;
+#endif // SFML_OPENGL_ES
     }
 
+    // Gives access to the context destruction callbacks of sf::GlResource
+    struct VertexArrayResource : sf::GlResource
+    {
+        static void registerCallback()
+        {
+            registerContextDestroyCallback(destroyVertexArray, 0);
+        }
+    };
+
     // Convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
     sf::Uint32 factorToGlConstant(sf::BlendMode::Factor blendFactor)
     {
@@ -119,32 +160,238 @@ namespace
         assert(false);
         return GLEXT_GL_FUNC_ADD;
     }
+
+    // Built-in shader drawing the instances of sf::InstanceBuffer
+    const char instancingVertexShader[] =
+        "attribute vec3 instanceRow0;\n"
+        "attribute vec3 instanceRow1;\n"
+        "attribute vec4 instanceColor;\n"
+        "attribute vec4 instanceTextureRect;\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 position = vec3(gl_Vertex.xy, 1.0);\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * vec4(dot(instanceRow0, position), dot(instanceRow1, position), 0.0, 1.0);\n"
+        "    vec2 texCoords = instanceTextureRect.xy + gl_MultiTexCoord0.xy * instanceTextureRect.zw;\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * vec4(texCoords, 0.0, 1.0);\n"
+        "    gl_FrontColor = gl_Color * instanceColor;\n"
+        "}\n";
+
+    const char instancingFragmentShader[] =
+        "uniform sampler2D texture;\n"
+        "uniform float textured;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 pixel = vec4(1.0);\n"
+        "    if (textured > 0.5)\n"
+        "        pixel = texture2D(texture, gl_TexCoord[0].xy);\n"
+        "    gl_FragColor = gl_Color * pixel;\n"
+        "}\n";
+
+    // Attributes of the instancing shader, matching the layout uploaded by sf::InstanceBuffer
+    struct InstanceAttribute
+    {
+        const char*  name;
+        GLint        size;
+        GLenum       type;
+        GLboolean    normalized;
+        std::size_t  offset;
+    };
+
+    const InstanceAttribute instanceAttributes[] =
+    {
+        {"instanceRow0",        3, GL_FLOAT,         GL_FALSE, 0},
+        {"instanceRow1",        3, GL_FLOAT,         GL_FALSE, 12},
+        {"instanceColor",       4, GL_UNSIGNED_BYTE, GL_TRUE,  24},
+        {"instanceTextureRect", 4, GL_FLOAT,         GL_FALSE, 28}
+    };
+
+    const GLsizei instanceStride = 44;
+
+    // Built-in shader replacing the fixed-function pipeline in core profile contexts;
+    // the attribute locations are bound by sf::Shader before linking
+    const char coreVertexShader[] =
+        "#version 150\n"
+        "uniform mat4 sf_projectionMatrix;\n"
+        "uniform mat4 sf_modelViewMatrix;\n"
+        "uniform mat4 sf_textureMatrix;\n"
+        "in vec2 sf_position;\n"
+        "in vec4 sf_color;\n"
+        "in vec2 sf_texCoords;\n"
+        "out vec4 color;\n"
+        "out vec2 texCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_projectionMatrix * sf_modelViewMatrix * vec4(sf_position, 0.0, 1.0);\n"
+        "    texCoords = (sf_textureMatrix * vec4(sf_texCoords, 0.0, 1.0)).xy;\n"
+        "    color = sf_color;\n"
+        "}\n";
+
+    const char coreFragmentShader[] =
+        "#version 150\n"
+        "uniform sampler2D sf_texture;\n"
+        "uniform float sf_textured;\n"
+        "in vec4 color;\n"
+        "in vec2 texCoords;\n"
+        "out vec4 fragColor;\n"
+        "void main()\n"
+        "{\n"
+        "    fragColor = color * mix(vec4(1.0), texture(sf_texture, texCoords), sf_textured);\n"
+        "}\n";
+
+    // Attribute locations of the core profile shaders
+    enum CoreAttribute
+    {
+        PositionAttribute  = 0,
+        ColorAttribute     = 1,
+        TexCoordsAttribute = 2
+    };
+
+    // Vertex buffers can't be split into triangles on the fly like vertex arrays
+    void warnCoreQuads()
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            sf::err() << "sf::Quads primitive type is not supported by vertex buffers in core profile contexts, drawing skipped" << std::endl;
+            warned = true;
+        }
+    }
+
+    // Get the primitive type that a strip or fan is converted to, so that it can be concatenated
+    sf::PrimitiveType listType(sf::PrimitiveType type)
+    {
+        switch (type)
+        {
+            case sf::TriangleStrip:
+            case sf::TriangleFan:   return sf::Triangles;
+            case sf::LineStrip:     return sf::Lines;
+            default:                return type;
+        }
+    }
+
+
+    // Append primitives to a vertex array, converting strips and fans to lists
+    void appendAsList(std::vector<sf::Vertex>& list, const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type)
+    {
+        switch (type)
+        {
+            case sf::TriangleStrip:
+            {
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    list.push_back(vertices[i - 2]);
+                    list.push_back(vertices[i - 1]);
+                    list.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case sf::TriangleFan:
+            {
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    list.push_back(vertices[0]);
+                    list.push_back(vertices[i - 1]);
+                    list.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case sf::LineStrip:
+            {
+                for (std::size_t i = 1; i < vertexCount; ++i)
+                {
+                    list.push_back(vertices[i - 1]);
+                    list.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            default:
+            {
+                list.insert(list.end(), vertices, vertices + vertexCount);
+                break;
+            }
+        }
+    }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+RenderTarget::Statistics::Statistics() :
+drawCalls       (0),
+vertices        (0),
+textureBinds    (0),
+shaderBinds     (0),
+blendModeChanges(0),
+cacheMisses     (0),
+gpuTime         (Time::Zero)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
-m_cache      (),
-m_id         (0)
+m_cache          (),
+m_batch          (),
+m_core           (),
+m_indexedVertices(),
+m_ringBuffer     (NULL),
+m_instancing     (NULL),
+m_stats          (),
+m_frameStats     (),
+m_frameTimer     (NULL),
+m_contextId      (0),
+m_activationId   (0)
 {
     m_cache.glStatesSet = false;
+    m_batch.enabled = false;
+    m_batch.type = Points;
+    m_batch.texture = NULL;
+    m_batch.textureId = 0;
+    m_batch.shader = NULL;
+    m_core.enabled = false;
+    m_core.shader = NULL;
+    m_core.vertexArray = 0;
+    m_core.vertexArrayContextId = 0;
+    m_core.streamBuffer = NULL;
+    m_core.program = 0;
+    m_core.projectionLocation = -1;
+    m_core.modelViewLocation = -1;
+    m_core.textureMatrixLocation = -1;
+    m_core.texturedLocation = -1;
+    m_core.dirty = 0;
+    m_core.textured = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    // Don't let a new target created at the same address be mistaken for this one
+    if (activeTarget == this)
+        activeTarget = NULL;
+
+    delete m_frameTimer;
+    delete m_instancing;
+    delete m_ringBuffer;
+    delete m_core.shader;
+    delete m_core.streamBuffer;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
-    if (isActive(m_id) || setActive(true))
+    // Pending geometry must be drawn before it gets cleared
+    flush();
+
+    if (isActive(this, m_activationId) || setActive(true))
     {
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
@@ -158,6 +405,9 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Pending geometry was submitted with the previous view
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -250,6 +500,9 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
     if (!vertices || (vertexCount == 0))
         return;
 
+    if (interceptDraw(vertices, vertexCount, type, states))
+        return;
+
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (type == Quads)
@@ -259,8 +512,29 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         }
     #endif
 
-    if (isActive(m_id) || setActive(true))
+    if (m_batch.enabled)
+        batchVertices(vertices, vertexCount, type, states);
+    else
+        drawImmediate(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawImmediate(const Vertex* vertices, std::size_t vertexCount,
+                                 PrimitiveType type, const RenderStates& states)
+{
+    if (isActive(this, m_activationId) || setActive(true))
     {
+        // Make sure that we know which pipeline the context provides
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        if (m_core.enabled)
+        {
+            drawCore(vertices, vertexCount, type, states);
+            return;
+        }
+
         // Check if the vertex count is low enough so that we can pre-transform them
         bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
 
@@ -278,6 +552,19 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
 
         setupDraw(useVertexCache, states);
 
+        // Larger vertex arrays are streamed to the GPU through our ring buffer,
+        // which leaves the buffer bound so that the pointers below become offsets
+        std::size_t firstVertex = 0;
+        bool useRingBuffer = false;
+        if (!useVertexCache)
+        {
+            if (!m_ringBuffer && VertexBuffer::isAvailable())
+                m_ringBuffer = new priv::VertexRingBuffer;
+
+            if (m_ringBuffer)
+                useRingBuffer = m_ringBuffer->push(vertices, vertexCount, firstVertex);
+        }
+
         // Check if texture coordinates array is needed, and update client state accordingly
         bool enableTexCoordsArray = (states.texture || states.shader);
         if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
@@ -298,6 +585,10 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
             if (useVertexCache)
                 data = reinterpret_cast<const char*>(m_cache.vertexCache);
 
+            // If we streamed the vertices, the pointers are relative to the bound buffer
+            if (useRingBuffer)
+                data = NULL;
+
             glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
             glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
             if (enableTexCoordsArray)
@@ -311,7 +602,15 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
             glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
         }
 
-        drawPrimitives(type, 0, vertexCount);
+        drawPrimitives(type, firstVertex, vertexCount);
+
+        // Fence the segments of the ring buffer left by this draw, and unbind it
+        if (useRingBuffer)
+        {
+            m_ringBuffer->fence();
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+        }
+
         cleanupDraw(states);
 
         // Update the cache
@@ -350,6 +649,9 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
     if (!vertexCount || !vertexBuffer.getNativeHandle())
         return;
 
+    if (interceptDraw(vertexBuffer, firstVertex, vertexCount, states))
+        return;
+
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (vertexBuffer.getPrimitiveType() == Quads)
@@ -359,20 +661,33 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
         }
     #endif
 
-    if (isActive(m_id) || setActive(true))
+    // Pending geometry must be drawn first to preserve the drawing order
+    flush();
+
+    if (isActive(this, m_activationId) || setActive(true))
     {
+        // Make sure that we know which pipeline the context provides
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        if (m_core.enabled)
+        {
+            if (vertexBuffer.getPrimitiveType() == Quads)
+            {
+                warnCoreQuads();
+                return;
+            }
+
+            if (!states.shader && !m_core.shader->getNativeHandle())
+                return;
+        }
+
         setupDraw(false, states);
 
         // Bind vertex buffer
         VertexBuffer::bind(&vertexBuffer);
 
-        // Always enable texture coordinates
-        if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
-            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
-
-        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
-        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
-        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+        applyVertexBufferAttributes();
 
         drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
 
@@ -389,208 +704,753 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTarget::setActive(bool active)
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
+                        const Uint32* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
 {
-    // Mark this RenderTarget as active or no longer active in the tracking map
-    {
-        sf::Lock lock(mutex);
-
-        Uint64 contextId = Context::getActiveContextId();
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0) || !indices || (indexCount == 0))
+        return;
 
-        ContextRenderTargetMap::iterator iter = contextRenderTargetMap.find(contextId);
+    // The vertices are streamed every time they are drawn, resolving the
+    // indices here costs no more and lets them be batched and recorded
+    m_indexedVertices.clear();
+    m_indexedVertices.reserve(indexCount);
 
-        if (active)
+    for (std::size_t i = 0; i < indexCount; ++i)
+    {
+        if (indices[i] >= vertexCount)
         {
-            if (iter == contextRenderTargetMap.end())
-            {
-                contextRenderTargetMap[contextId] = m_id;
-
-                m_cache.enable = false;
-            }
-            else if (iter->second != m_id)
-            {
-                iter->second = m_id;
-
-                m_cache.enable = false;
-            }
+            err() << "Vertex index " << indices[i] << " is out of range, drawing skipped" << std::endl;
+            return;
         }
-        else
-        {
-            if (iter != contextRenderTargetMap.end())
-                contextRenderTargetMap.erase(iter);
 
-            m_cache.enable = false;
-        }
+        m_indexedVertices.push_back(vertices[indices[i]]);
     }
 
-    return true;
+    draw(&m_indexedVertices[0], m_indexedVertices.size(), type, states);
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::pushGLStates()
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states)
 {
-    if (isActive(m_id) || setActive(true))
-    {
-        #ifdef SFML_DEBUG
-            // make sure that the user didn't leave an unchecked OpenGL error
-            GLenum error = glGetError();
-            if (error != GL_NO_ERROR)
-            {
-                err() << "OpenGL error (" << error << ") detected in user code, "
-                      << "you should check for errors with glGetError()"
-                      << std::endl;
-            }
-        #endif
-
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-            glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
-        #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
-    }
-
-    resetGLStates();
+    draw(vertexBuffer, indexBuffer, 0, indexBuffer.getIndexCount(), states);
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::popGLStates()
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer,
+                        std::size_t firstIndex, std::size_t indexCount, const RenderStates& states)
 {
-    if (isActive(m_id) || setActive(true))
-    {
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPopMatrix());
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPopClientAttrib());
-            glCheck(glPopAttrib());
-        #endif
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
     }
-}
 
+    // Sanity check
+    if (firstIndex > indexBuffer.getIndexCount())
+        return;
 
-////////////////////////////////////////////////////////////
-void RenderTarget::resetGLStates()
-{
-    // Check here to make sure a context change does not happen after activate(true)
-    bool shaderAvailable = Shader::isAvailable();
-    bool vertexBufferAvailable = VertexBuffer::isAvailable();
+    // Clamp indexCount to something that makes sense
+    indexCount = std::min(indexCount, indexBuffer.getIndexCount() - firstIndex);
 
-    // Workaround for states not being properly reset on
-    // macOS unless a context switch really takes place
-    #if defined(SFML_SYSTEM_MACOS)
-        setActive(false);
-    #endif
+    // Nothing to draw?
+    if (!indexCount || !vertexBuffer.getNativeHandle() || !indexBuffer.getNativeHandle())
+        return;
 
-    if (isActive(m_id) || setActive(true))
-    {
-        // Make sure that extensions are initialized
-        priv::ensureExtensionsInit();
+    if (interceptDraw(vertexBuffer, indexBuffer, firstIndex, indexCount, states))
+        return;
 
-        // Make sure that the texture unit which is active is the number 0
-        if (GLEXT_multitexture)
+    // GL_QUADS and 32-bit indices are unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
-            glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
         }
 
-        // Define the default OpenGL states
-        glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
-        glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glLoadIdentity());
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
-        m_cache.glStatesSet = true;
+        if (indexBuffer.getType() == IndexBuffer::Index32)
+        {
+            err() << "32-bit indices are not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
 
-        // Apply the default SFML states
-        applyBlendMode(BlendAlpha);
-        applyTexture(NULL);
-        if (shaderAvailable)
-            applyShader(NULL);
+    // Pending geometry must be drawn first to preserve the drawing order
+    flush();
 
-        if (vertexBufferAvailable)
-            glCheck(VertexBuffer::bind(NULL));
+    if (isActive(this, m_activationId) || setActive(true))
+    {
+        // Make sure that we know which pipeline the context provides
+        if (!m_cache.glStatesSet)
+            resetGLStates();
 
-        m_cache.texCoordsArrayEnabled = true;
+        if (m_core.enabled)
+        {
+            if (vertexBuffer.getPrimitiveType() == Quads)
+            {
+                warnCoreQuads();
+                return;
+            }
 
-        m_cache.useVertexCache = false;
+            if (!states.shader && !m_core.shader->getNativeHandle())
+                return;
+        }
 
-        // Set the default view
-        setView(getView());
+        setupDraw(false, states);
 
-        m_cache.enable = true;
-    }
-}
+        // Bind the buffers; the index buffer binding is part of the
+        // vertex array object in core profiles, so it comes second
+        VertexBuffer::bind(&vertexBuffer);
 
+        applyVertexBufferAttributes();
 
-////////////////////////////////////////////////////////////
-void RenderTarget::initialize()
-{
-    // Setup the default and current views
-    m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
-    m_view = m_defaultView;
+        IndexBuffer::bind(&indexBuffer);
 
-    // Set GL states only on first draw, so that we don't pollute user's states
-    m_cache.glStatesSet = false;
+        // Find the OpenGL primitive and index types
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+        GLenum mode = modes[vertexBuffer.getPrimitiveType()];
 
-    // Generate a unique ID for this RenderTarget to track
-    // whether it is active within a specific context
-    m_id = getUniqueId();
-}
+        bool shortIndices = (indexBuffer.getType() == IndexBuffer::Index16);
+        GLenum indexType = shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        std::size_t offset = firstIndex * (shortIndices ? sizeof(Uint16) : sizeof(Uint32));
 
+        glCheck(glDrawElements(mode, static_cast<GLsizei>(indexCount), indexType, reinterpret_cast<const void*>(offset)));
 
-////////////////////////////////////////////////////////////
-void RenderTarget::applyCurrentView()
-{
-    // Set the viewport
-    IntRect viewport = getViewport(m_view);
-    int top = getSize().y - (viewport.top + viewport.height);
-    glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
+        ++m_stats.drawCalls;
+        m_stats.vertices += static_cast<unsigned int>(indexCount);
 
-    // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+        // Unbind the buffers
+        IndexBuffer::bind(NULL);
+        VertexBuffer::bind(NULL);
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+        cleanupDraw(states);
 
-    m_cache.viewChanged = false;
+        // Update the cache
+        m_cache.useVertexCache = false;
+        m_cache.texCoordsArrayEnabled = true;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyBlendMode(const BlendMode& mode)
+void RenderTarget::drawInstanced(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states)
 {
-    // Apply the blend mode, falling back to the non-separate versions if necessary
-    if (GLEXT_blend_func_separate)
+    // Targets recording the draw calls must not query OpenGL, they may run on any thread
+    if (interceptDraw(vertexBuffer, instanceBuffer, states))
+        return;
+
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
     {
-        glCheck(GLEXT_glBlendFuncSeparate(
-            factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
-            factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
     }
-    else
+
+    // Nothing to draw?
+    if (!vertexBuffer.getVertexCount() || !vertexBuffer.getNativeHandle() || !instanceBuffer.getInstanceCount())
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    // Custom shaders don't know about the instance attributes
+    if (states.shader || !InstanceBuffer::isAvailable())
     {
-        glCheck(glBlendFunc(
-            factorToGlConstant(mode.colorSrcFactor),
-            factorToGlConstant(mode.colorDstFactor)));
+        drawInstancesOnCpu(vertexBuffer, instanceBuffer, states);
+        return;
     }
 
-    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+#ifndef SFML_OPENGL_ES
+
+    // Pending geometry must be drawn first to preserve the drawing order
+    flush();
+
+    if (isActive(this, m_activationId) || setActive(true))
+    {
+        // The instancing shader relies on the fixed-function inputs
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        if (m_core.enabled)
+        {
+            drawInstancesOnCpu(vertexBuffer, instanceBuffer, states);
+            return;
+        }
+
+        // Compile the instancing shader the first time it is needed
+        if (!m_instancing)
+        {
+            m_instancing = new Shader;
+            if (m_instancing->loadFromMemory(instancingVertexShader, instancingFragmentShader))
+                m_instancing->setUniform("texture", Shader::CurrentTexture);
+            else
+                err() << "Failed to compile the instancing shader, instances will be expanded on the CPU" << std::endl;
+        }
+
+        if (!m_instancing->getNativeHandle())
+        {
+            drawInstancesOnCpu(vertexBuffer, instanceBuffer, states);
+            return;
+        }
+
+        m_instancing->setUniform("textured", states.texture ? 1.f : 0.f);
+
+        RenderStates instancingStates(states);
+        instancingStates.shader = m_instancing;
+
+        setupDraw(false, instancingStates);
+
+        // Set up the per-vertex attributes, like a regular vertex buffer
+        VertexBuffer::bind(&vertexBuffer);
+
+        applyVertexBufferAttributes();
+
+        // Set up the per-instance attributes
+        const std::size_t attributeCount = sizeof(instanceAttributes) / sizeof(instanceAttributes[0]);
+        GLint locations[attributeCount];
+
+        if (InstanceBuffer::bind(&instanceBuffer))
+        {
+            for (std::size_t i = 0; i < attributeCount; ++i)
+            {
+                const InstanceAttribute& attribute = instanceAttributes[i];
+
+                glCheck(locations[i] = GLEXT_glGetAttribLocation(castToGlHandle(m_instancing->getNativeHandle()), attribute.name));
+
+                if (locations[i] >= 0)
+                {
+                    GLuint location = static_cast<GLuint>(locations[i]);
+
+                    glCheck(GLEXT_glEnableVertexAttribArray(location));
+                    glCheck(GLEXT_glVertexAttribPointer(location, attribute.size, attribute.type, attribute.normalized, instanceStride, reinterpret_cast<const void*>(attribute.offset)));
+                    glCheck(GLEXT_glVertexAttribDivisor(location, 1));
+                }
+            }
+
+            static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                           GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+
+            glCheck(GLEXT_glDrawArraysInstanced(modes[vertexBuffer.getPrimitiveType()], 0,
+                                                static_cast<GLsizei>(vertexBuffer.getVertexCount()),
+                                                static_cast<GLsizei>(instanceBuffer.getInstanceCount())));
+
+            ++m_stats.drawCalls;
+            m_stats.vertices += static_cast<unsigned int>(vertexBuffer.getVertexCount() * instanceBuffer.getInstanceCount());
+
+            // Restore the attributes, they are shared with other draws
+            for (std::size_t i = 0; i < attributeCount; ++i)
+            {
+                if (locations[i] >= 0)
+                {
+                    glCheck(GLEXT_glVertexAttribDivisor(static_cast<GLuint>(locations[i]), 0));
+                    glCheck(GLEXT_glDisableVertexAttribArray(static_cast<GLuint>(locations[i])));
+                }
+            }
+        }
+
+        // Unbind the buffers
+        VertexBuffer::bind(NULL);
+
+        cleanupDraw(instancingStates);
+
+        // Update the cache
+        m_cache.useVertexCache = false;
+        m_cache.texCoordsArrayEnabled = true;
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flush();
+
+    m_batch.enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    if (m_batch.vertices.empty())
+        return;
+
+    // Take the pending vertices out of the batch first, so that
+    // functions called while drawing them see an empty batch
+    std::vector<Vertex> vertices;
+    vertices.swap(m_batch.vertices);
+
+    RenderStates states(m_batch.blendMode, Transform::Identity, m_batch.texture, m_batch.shader);
+    drawImmediate(&vertices[0], vertices.size(), m_batch.type, states);
+
+    // Give the storage back to the batch to avoid reallocating it every frame
+    vertices.clear();
+    m_batch.vertices.swap(vertices);
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderTarget::Statistics& RenderTarget::getStatistics() const
+{
+    return m_frameStats;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setGpuTimingEnabled(bool enabled)
+{
+    if (enabled && !m_frameTimer)
+    {
+        m_frameTimer = new GpuTimer("frame");
+        m_frameTimer->begin(*this);
+    }
+    else if (!enabled && m_frameTimer)
+    {
+        delete m_frameTimer;
+        m_frameTimer = NULL;
+        m_frameStats.gpuTime = Time::Zero;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isGpuTimingEnabled() const
+{
+    return m_frameTimer != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::setActive(bool active)
+{
+    // Mark this RenderTarget as active or no longer active in the current thread
+    if (active)
+    {
+        Uint64 activationId = Context::getActivationId();
+
+        if ((activeTarget != this) || (m_activationId != activationId))
+        {
+            activeTarget = this;
+            m_contextId = Context::getActiveContextId();
+            m_activationId = activationId;
+
+            m_cache.enable = false;
+        }
+    }
+    else
+    {
+        activeTarget = NULL;
+        m_contextId = 0;
+        m_activationId = 0;
+
+        m_cache.enable = false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::pushGLStates()
+{
+    flush();
+
+    if (isActive(this, m_activationId) || setActive(true))
+    {
+        #ifdef SFML_DEBUG
+            // make sure that the user didn't leave an unchecked OpenGL error
+            GLenum error = glGetError();
+            if (error != GL_NO_ERROR)
+            {
+                err() << "OpenGL error (" << error << ") detected in user code, "
+                      << "you should check for errors with glGetError()"
+                      << std::endl;
+            }
+        #endif
+
+        // Core profiles have neither attribute nor matrix stacks
+        if (!priv::isCoreProfile())
+        {
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
+                glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+            #endif
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+        }
+    }
+
+    resetGLStates();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::popGLStates()
+{
+    flush();
+
+    if (isActive(this, m_activationId) || setActive(true))
+    {
+        if (priv::isCoreProfile())
+        {
+            // Nothing was saved, leave a clean state to the user
+            // and set ours up again before the next draw
+            #ifndef SFML_OPENGL_ES
+                glCheck(GLEXT_glUseProgramObject(0));
+                glCheck(GLEXT_glBindVertexArray(0));
+            #endif
+            glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+
+            m_cache.glStatesSet = false;
+        }
+        else
+        {
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPopMatrix());
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPopClientAttrib());
+                glCheck(glPopAttrib());
+            #endif
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetGLStates()
+{
+    flush();
+
+    // Check here to make sure a context change does not happen after activate(true)
+    bool shaderAvailable = Shader::isAvailable();
+    bool vertexBufferAvailable = VertexBuffer::isAvailable();
+
+    // Workaround for states not being properly reset on
+    // macOS unless a context switch really takes place
+    #if defined(SFML_SYSTEM_MACOS)
+        setActive(false);
+    #endif
+
+    if (isActive(this, m_activationId) || setActive(true))
+    {
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        // Core profile contexts have no fixed-function pipeline, we draw through our own shader
+        m_core.enabled = priv::isCoreProfile();
+
+        // Make sure that the texture unit which is active is the number 0
+        if (GLEXT_multitexture)
+        {
+            if (!m_core.enabled && GLEXT_client_multitexture)
+                glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+            glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+        }
+
+        // Define the default OpenGL states
+        if (m_core.enabled)
+        {
+            glCheck(glDisable(GL_CULL_FACE));
+            glCheck(glDisable(GL_DEPTH_TEST));
+            glCheck(glEnable(GL_BLEND));
+
+            // Compile the built-in shader the first time it is needed
+            if (!m_core.shader)
+            {
+                m_core.shader = new Shader;
+                if (m_core.shader->loadFromMemory(coreVertexShader, coreFragmentShader))
+                    m_core.shader->setUniform("sf_texture", Shader::CurrentTexture);
+                else
+                    err() << "Failed to compile the core profile shader, only custom shaders can be used for drawing" << std::endl;
+            }
+
+            // Our program and its uniforms will be set up again on next draw
+            m_core.program = 0;
+        }
+        else
+        {
+            glCheck(glDisable(GL_CULL_FACE));
+            glCheck(glDisable(GL_LIGHTING));
+            glCheck(glDisable(GL_DEPTH_TEST));
+            glCheck(glDisable(GL_ALPHA_TEST));
+            glCheck(glEnable(GL_TEXTURE_2D));
+            glCheck(glEnable(GL_BLEND));
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glLoadIdentity());
+            glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
+        m_cache.glStatesSet = true;
+
+        // Apply the default SFML states
+        applyBlendMode(BlendAlpha);
+        applyTexture(NULL);
+        if (shaderAvailable && !m_core.enabled)
+            applyShader(NULL);
+
+        if (vertexBufferAvailable)
+            glCheck(VertexBuffer::bind(NULL));
+
+        m_cache.texCoordsArrayEnabled = true;
+
+        m_cache.useVertexCache = false;
+
+        // Set the default view
+        setView(getView());
+
+        m_cache.enable = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::initialize()
+{
+    // Setup the default and current views
+    m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
+    m_view = m_defaultView;
+
+    // Set GL states only on first draw, so that we don't pollute user's states
+    m_cache.glStatesSet = false;
+
+    // The target is not active in any context yet
+    m_contextId = 0;
+    m_activationId = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::finishFrame()
+{
+    flush();
+
+    Time gpuTime = m_frameStats.gpuTime;
+
+    // Measure the next frame from here, so that no GPU work is missed
+    if (m_frameTimer)
+    {
+        m_frameTimer->end(*this);
+        gpuTime = m_frameTimer->getElapsedTime();
+        m_frameTimer->begin(*this);
+    }
+
+    m_frameStats = m_stats;
+    m_frameStats.gpuTime = gpuTime;
+    m_stats = Statistics();
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::interceptDraw(const Vertex*, std::size_t, PrimitiveType, const RenderStates&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::interceptDraw(const VertexBuffer&, std::size_t, std::size_t, const RenderStates&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::interceptDraw(const VertexBuffer&, const IndexBuffer&, std::size_t, std::size_t, const RenderStates&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::interceptDraw(const VertexBuffer&, const InstanceBuffer&, const RenderStates&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstancesOnCpu(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states)
+{
+#ifdef SFML_OPENGL_ES
+
+    err() << "Instanced drawing requires reading back vertex buffers, which is not supported on OpenGL ES, drawing skipped" << std::endl;
+
+#else
+
+    if (!isActive(this, m_activationId) && !setActive(true))
+        return;
+
+    // Read back the geometry of a single instance, unless the instance buffer
+    // already holds a copy of the current contents of the vertex buffer
+    std::vector<Vertex>& geometry = instanceBuffer.m_geometry;
+    if (instanceBuffer.m_geometryId != vertexBuffer.m_cacheId)
+    {
+        geometry.resize(vertexBuffer.getVertexCount());
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer.getNativeHandle()));
+
+        void* source = 0;
+        glCheck(source = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_READ_ONLY));
+
+        if (source)
+        {
+            std::memcpy(&geometry[0], source, sizeof(Vertex) * geometry.size());
+            glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+        }
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+        if (!source)
+        {
+            instanceBuffer.m_geometryId = 0;
+            err() << "Failed to read back the vertex buffer, instanced drawing skipped" << std::endl;
+            return;
+        }
+
+        instanceBuffer.m_geometryId = vertexBuffer.m_cacheId;
+    }
+
+    // Expand the instances, in list form so that they can be concatenated
+    PrimitiveType type = vertexBuffer.getPrimitiveType();
+    std::vector<Vertex> vertices;
+
+    for (std::size_t i = 0; i < instanceBuffer.getInstanceCount(); ++i)
+    {
+        const InstanceBuffer::Instance& instance = instanceBuffer[i];
+        std::size_t first = vertices.size();
+
+        appendAsList(vertices, &geometry[0], geometry.size(), type);
+
+        for (std::size_t j = first; j < vertices.size(); ++j)
+        {
+            Vertex& vertex = vertices[j];
+            vertex.position = instance.transform.transformPoint(vertex.position);
+            vertex.color = vertex.color * instance.color;
+            vertex.texCoords.x = instance.textureRect.left + vertex.texCoords.x * instance.textureRect.width;
+            vertex.texCoords.y = instance.textureRect.top + vertex.texCoords.y * instance.textureRect.height;
+        }
+    }
+
+    if (!vertices.empty())
+        draw(&vertices[0], vertices.size(), listType(type), states);
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::batchVertices(const Vertex* vertices, std::size_t vertexCount,
+                                 PrimitiveType type, const RenderStates& states)
+{
+    // Strips and fans cannot be concatenated, they are converted to lists
+    PrimitiveType batchType = listType(type);
+
+    // Start a new batch if the render states are not compatible with the pending ones
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (!m_batch.vertices.empty() &&
+        ((batchType          != m_batch.type)      ||
+         (states.texture     != m_batch.texture)   ||
+         (textureId          != m_batch.textureId) ||
+         (states.shader      != m_batch.shader)    ||
+         (states.blendMode   != m_batch.blendMode)))
+    {
+        flush();
+    }
+
+    m_batch.type      = batchType;
+    m_batch.blendMode = states.blendMode;
+    m_batch.texture   = states.texture;
+    m_batch.textureId = textureId;
+    m_batch.shader    = states.shader;
+
+    // Append the vertices to the batch, in list form
+    std::size_t first = m_batch.vertices.size();
+    appendAsList(m_batch.vertices, vertices, vertexCount, type);
+
+    // Pre-transform the new vertices, the batch is drawn with an identity transform
+    if (states.transform != Transform::Identity)
+    {
+        for (std::size_t i = first; i < m_batch.vertices.size(); ++i)
+            m_batch.vertices[i].position = states.transform * m_batch.vertices[i].position;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyCurrentView()
+{
+    // Set the viewport
+    IntRect viewport = getViewport(m_view);
+    int top = getSize().y - (viewport.top + viewport.height);
+    glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
+
+    // The projection matrix is a uniform of the core profile shader
+    if (m_core.enabled)
+    {
+        m_core.dirty |= CoreProfile::ProjectionDirty;
+        m_cache.viewChanged = false;
+        return;
+    }
+
+    // Set the projection matrix
+    glCheck(glMatrixMode(GL_PROJECTION));
+    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+
+    // Go back to model-view mode
+    glCheck(glMatrixMode(GL_MODELVIEW));
+
+    m_cache.viewChanged = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyBlendMode(const BlendMode& mode)
+{
+    // Apply the blend mode, falling back to the non-separate versions if necessary
+    if (GLEXT_blend_func_separate)
+    {
+        glCheck(GLEXT_glBlendFuncSeparate(
+            factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
+            factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+    }
+    else
+    {
+        glCheck(glBlendFunc(
+            factorToGlConstant(mode.colorSrcFactor),
+            factorToGlConstant(mode.colorDstFactor)));
+    }
+
+    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
     {
         if (GLEXT_blend_equation_separate)
         {
@@ -618,12 +1478,26 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
     }
 
     m_cache.lastBlendMode = mode;
+
+    ++m_stats.blendModeChanges;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
+    // The model-view matrix is a uniform of the core profile shader
+    if (m_core.enabled)
+    {
+        if (transform != m_core.modelView)
+        {
+            m_core.modelView = transform;
+            m_core.dirty |= CoreProfile::ModelViewDirty;
+        }
+
+        return;
+    }
+
     // No need to call glMatrixMode(GL_MODELVIEW), it is always the
     // current mode (for optimization purpose, since it's the most used)
     if (transform == Transform::Identity)
@@ -638,7 +1512,36 @@ void RenderTarget::applyTexture(const Texture* texture)
 {
     Texture::bind(texture, Texture::Pixels);
 
+    // The texture matrix is a uniform of the core profile shader,
+    // computed like the one set up by Texture::bind
+    if (m_core.enabled)
+    {
+        m_core.textureMatrix = Transform::Identity;
+        m_core.textured = (texture != NULL);
+
+        if (texture && texture->m_actualSize.x && texture->m_actualSize.y)
+        {
+            float scaleX = 1.f / texture->m_actualSize.x;
+            float scaleY = 1.f / texture->m_actualSize.y;
+            float offsetY = 0.f;
+
+            if (texture->m_pixelsFlipped)
+            {
+                scaleY = -scaleY;
+                offsetY = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
+            }
+
+            m_core.textureMatrix = Transform(scaleX, 0.f,    0.f,
+                                             0.f,    scaleY, offsetY,
+                                             0.f,    0.f,    1.f);
+        }
+
+        m_core.dirty |= CoreProfile::TextureDirty;
+    }
+
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+
+    ++m_stats.textureBinds;
 }
 
 
@@ -646,6 +1549,200 @@ void RenderTarget::applyTexture(const Texture* texture)
 void RenderTarget::applyShader(const Shader* shader)
 {
     Shader::bind(shader);
+
+    if (shader)
+        ++m_stats.shaderBinds;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyCoreProgram(const Shader* shader)
+{
+#ifndef SFML_OPENGL_ES
+
+    const Shader* program = shader ? shader : m_core.shader;
+    unsigned int handle = program->getNativeHandle();
+
+    // Custom shaders are always bound, so that their textures are bound as well
+    if (shader || !m_cache.enable || (handle != m_core.program))
+        Shader::bind(program);
+
+    if (shader)
+        ++m_stats.shaderBinds;
+
+    // Find the uniforms of a new program, and give them their values
+    if (!m_cache.enable || (handle != m_core.program))
+    {
+        GLEXT_GLhandle glHandle = castToGlHandle(handle);
+
+        glCheck(m_core.projectionLocation = GLEXT_glGetUniformLocation(glHandle, "sf_projectionMatrix"));
+        glCheck(m_core.modelViewLocation = GLEXT_glGetUniformLocation(glHandle, "sf_modelViewMatrix"));
+        glCheck(m_core.textureMatrixLocation = GLEXT_glGetUniformLocation(glHandle, "sf_textureMatrix"));
+        glCheck(m_core.texturedLocation = GLEXT_glGetUniformLocation(glHandle, "sf_textured"));
+
+        m_core.program = handle;
+        m_core.dirty = CoreProfile::ProjectionDirty | CoreProfile::ModelViewDirty | CoreProfile::TextureDirty;
+    }
+
+    if ((m_core.dirty & CoreProfile::ProjectionDirty) && (m_core.projectionLocation >= 0))
+        glCheck(GLEXT_glUniformMatrix4fv(m_core.projectionLocation, 1, GL_FALSE, m_view.getTransform().getMatrix()));
+
+    if ((m_core.dirty & CoreProfile::ModelViewDirty) && (m_core.modelViewLocation >= 0))
+        glCheck(GLEXT_glUniformMatrix4fv(m_core.modelViewLocation, 1, GL_FALSE, m_core.modelView.getMatrix()));
+
+    if (m_core.dirty & CoreProfile::TextureDirty)
+    {
+        if (m_core.textureMatrixLocation >= 0)
+            glCheck(GLEXT_glUniformMatrix4fv(m_core.textureMatrixLocation, 1, GL_FALSE, m_core.textureMatrix.getMatrix()));
+
+        if (m_core.texturedLocation >= 0)
+            glCheck(GLEXT_glUniform1f(m_core.texturedLocation, m_core.textured ? 1.f : 0.f));
+    }
+
+    m_core.dirty = 0;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyCoreAttributes()
+{
+#ifndef SFML_OPENGL_ES
+
+    // Look up the vertex array object of the current context only when it changed
+    if (!m_core.vertexArray || (m_core.vertexArrayContextId != m_contextId))
+    {
+        Lock lock(vertexArraysMutex);
+
+        std::map<Uint64, unsigned int>::iterator iter = vertexArrays.find(m_contextId);
+
+        if (iter != vertexArrays.end())
+        {
+            m_core.vertexArray = iter->second;
+            glCheck(GLEXT_glBindVertexArray(m_core.vertexArray));
+        }
+        else
+        {
+            // Make sure that the vertex array object is deleted along with its context
+            VertexArrayResource::registerCallback();
+
+            GLuint vertexArray = 0;
+            glCheck(GLEXT_glGenVertexArrays(1, &vertexArray));
+            glCheck(GLEXT_glBindVertexArray(vertexArray));
+
+            glCheck(GLEXT_glEnableVertexAttribArray(PositionAttribute));
+            glCheck(GLEXT_glEnableVertexAttribArray(ColorAttribute));
+            glCheck(GLEXT_glEnableVertexAttribArray(TexCoordsAttribute));
+
+            m_core.vertexArray = static_cast<unsigned int>(vertexArray);
+            vertexArrays.insert(std::make_pair(m_contextId, m_core.vertexArray));
+        }
+
+        m_core.vertexArrayContextId = m_contextId;
+    }
+    else
+    {
+        glCheck(GLEXT_glBindVertexArray(m_core.vertexArray));
+    }
+
+    // The pointers are offsets in the bound buffer
+    glCheck(GLEXT_glVertexAttribPointer(PositionAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+    glCheck(GLEXT_glVertexAttribPointer(ColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+    glCheck(GLEXT_glVertexAttribPointer(TexCoordsAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawCore(const Vertex* vertices, std::size_t vertexCount,
+                            PrimitiveType type, const RenderStates& states)
+{
+    if (!states.shader && !m_core.shader->getNativeHandle())
+        return;
+
+    // Quads don't exist in core profiles, they are split into triangles
+    if (type == Quads)
+    {
+        m_core.triangles.clear();
+
+        for (std::size_t i = 0; i + 3 < vertexCount; i += 4)
+        {
+            m_core.triangles.push_back(vertices[i]);
+            m_core.triangles.push_back(vertices[i + 1]);
+            m_core.triangles.push_back(vertices[i + 2]);
+            m_core.triangles.push_back(vertices[i]);
+            m_core.triangles.push_back(vertices[i + 2]);
+            m_core.triangles.push_back(vertices[i + 3]);
+        }
+
+        if (m_core.triangles.empty())
+            return;
+
+        vertices = &m_core.triangles[0];
+        vertexCount = m_core.triangles.size();
+        type = Triangles;
+    }
+
+    setupDraw(false, states);
+
+    // Client-side arrays don't exist in core profiles either, the vertices are always
+    // streamed; the ones too large for the ring buffer go to a dedicated buffer
+    if (!m_ringBuffer)
+        m_ringBuffer = new priv::VertexRingBuffer;
+
+    std::size_t firstVertex = 0;
+    bool useRingBuffer = m_ringBuffer->push(vertices, vertexCount, firstVertex);
+    if (!useRingBuffer)
+    {
+        if (!m_core.streamBuffer)
+        {
+            m_core.streamBuffer = new VertexBuffer(Points, VertexBuffer::Stream);
+            m_core.streamBuffer->create(vertexCount);
+        }
+
+        if (!m_core.streamBuffer->update(vertices, vertexCount, 0))
+        {
+            err() << "Failed to stream the vertices to the GPU, drawing skipped" << std::endl;
+            cleanupDraw(states);
+            return;
+        }
+
+        VertexBuffer::bind(m_core.streamBuffer);
+    }
+
+    applyCoreAttributes();
+
+    drawPrimitives(type, firstVertex, vertexCount);
+
+    // Fence the segments of the ring buffer left by this draw
+    if (useRingBuffer)
+        m_ringBuffer->fence();
+
+    // Unbind the vertex buffer
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    cleanupDraw(states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyVertexBufferAttributes()
+{
+    if (m_core.enabled)
+    {
+        applyCoreAttributes();
+        return;
+    }
+
+    // Always enable texture coordinates
+    if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
+        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+    glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+    glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+    glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
 }
 
 
@@ -656,6 +1753,9 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     if (!m_cache.glStatesSet)
         resetGLStates();
 
+    if (!m_cache.enable)
+        ++m_stats.cacheMisses;
+
     if (useVertexCache)
     {
         // Since vertices are transformed, we must use an identity transform to render them
@@ -694,7 +1794,9 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     }
 
     // Apply the shader
-    if (states.shader)
+    if (m_core.enabled)
+        applyCoreProgram(states.shader);
+    else if (states.shader)
         applyShader(states.shader);
 }
 
@@ -709,14 +1811,18 @@ void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, s
 
     // Draw the primitives
     glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+
+    ++m_stats.drawCalls;
+    m_stats.vertices += static_cast<unsigned int>(vertexCount);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::cleanupDraw(const RenderStates& states)
 {
-    // Unbind the shader, if any
-    if (states.shader)
+    // Unbind the shader, if any; the core profile backend
+    // always binds the program it needs before drawing
+    if (states.shader && !m_core.enabled)
         applyShader(NULL);
 
     // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
@@ -766,4 +1872,20 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 //   do is that we avoid setting a null shader if there was
 //   already none for the previous draw.
 //
+// * Batching
+//   When enabled, consecutive vertex arrays drawn with the
+//   same texture, shader, blend mode and primitive type are
+//   pre-transformed and concatenated, exactly like the small
+//   vertex cache above but without size limit. This removes
+//   both the transform changes and the per-draw overhead of
+//   the driver, at the cost of transforming on the CPU.
+//
+// * Vertex streaming
+//   Vertex arrays too large for the vertex cache are copied
+//   into a ring buffer owned by the target instead of being
+//   read from client memory by the driver at draw time. The
+//   ring is fenced per segment when sync objects exist, and
+//   orphaned on wrap-around otherwise, so writing never
+//   stalls on the GPU still reading older vertices.
+//
 ////////////////////////////////////////////////////////////
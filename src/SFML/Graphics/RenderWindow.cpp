@@ -130,4 +130,12 @@ void RenderWindow::onResize()
     setView(getView());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    // Draw the pending geometry and complete the statistics before presenting the frame
+    finishFrame();
+}
+
 } // namespace sf
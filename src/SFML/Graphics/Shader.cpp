@@ -942,6 +942,12 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         glCheck(GLEXT_glDeleteObject(fragmentShader));
     }
 
+    // Give the vertex attributes of the core profile backend of sf::RenderTarget
+    // the same locations in every program (unused names are simply ignored)
+    glCheck(GLEXT_glBindAttribLocation(shaderProgram, 0, "sf_position"));
+    glCheck(GLEXT_glBindAttribLocation(shaderProgram, 1, "sf_color"));
+    glCheck(GLEXT_glBindAttribLocation(shaderProgram, 2, "sf_texCoords"));
+
     // Link the program
     glCheck(GLEXT_glLinkProgram(shaderProgram));
 
@@ -256,7 +256,10 @@ void Shape::draw(RenderTarget& target, RenderStates states) const
     // Render the inside
     states.texture = m_texture;
 
-    if (VertexBuffer::isAvailable())
+    // Prefer the vertex arrays when batching, so that they can be merged
+    bool useVertexBuffer = !target.isBatchingEnabled() && VertexBuffer::isAvailable();
+
+    if (useVertexBuffer)
     {
         target.draw(m_verticesBuffer, states);
     }
@@ -270,7 +273,7 @@ void Shape::draw(RenderTarget& target, RenderStates states) const
     {
         states.texture = NULL;
 
-        if (VertexBuffer::isAvailable())
+        if (useVertexBuffer)
         {
             target.draw(m_outlineVerticesBuffer, states);
         }
@@ -160,7 +160,7 @@ void Sprite::draw(RenderTarget& target, RenderStates states) const
         states.transform *= getTransform();
         states.texture = m_texture;
 
-        if (VertexBuffer::isAvailable())
+        if (!target.isBatchingEnabled() && VertexBuffer::isAvailable())
         {
             target.draw(m_verticesBuffer, states);
         }
@@ -28,46 +28,58 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/TextGeometry.hpp>
+#include <algorithm>
 #include <cmath>
 
 
 namespace
 {
-    // Add an underline or strikethrough line to the vertex array
-    void addLine(sf::VertexArray& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness, float outlineThickness = 0)
+    // Write vertices to a vertex buffer, starting at the given vertex; full updates size
+    // the buffer exactly, appends make it grow geometrically so that it isn't recreated each time
+    void uploadVertices(sf::VertexBuffer& buffer, const sf::VertexArray& vertices, std::size_t first)
     {
-        float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
-        float bottom = top + std::floor(thickness + 0.5f);
-
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        std::size_t count = vertices.getVertexCount();
+
+        if ((first == 0) ? (buffer.getVertexCount() != count) : (buffer.getVertexCount() < count))
+        {
+            buffer.create((first == 0) ? count : std::max(count, buffer.getVertexCount() * 2));
+            first = 0;
+        }
+
+        if (count > first)
+            buffer.update(&vertices[first], count - first, static_cast<unsigned int>(first));
     }
 
-    // Add a glyph quad to the vertex array
-    void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness = 0)
+    // Draw a text geometry, one font page at a time
+    void drawPages(sf::RenderTarget& target, sf::RenderStates states, const sf::Font& font, const sf::VertexArray& vertices, const sf::VertexBuffer& buffer,
+                   const std::vector<std::pair<unsigned int, std::size_t> >& ranges, bool useVertexBuffer)
     {
-        float padding = 1.0;
-
-        float left   = glyph.bounds.left - padding;
-        float top    = glyph.bounds.top - padding;
-        float right  = glyph.bounds.left + glyph.bounds.width + padding;
-        float bottom = glyph.bounds.top  + glyph.bounds.height + padding;
-
-        float u1 = static_cast<float>(glyph.textureRect.left) - padding;
-        float v1 = static_cast<float>(glyph.textureRect.top) - padding;
-        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
-        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height) + padding;
-
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u1, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
+        if (ranges.size() == 1)
+        {
+            states.texture = &font.getPageTexture(ranges[0].first);
+
+            // The buffer may be larger than the geometry
+            if (useVertexBuffer)
+                target.draw(buffer, 0, ranges[0].second, states);
+            else
+                target.draw(vertices, states);
+
+            return;
+        }
+
+        std::size_t first = 0;
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+            states.texture = &font.getPageTexture(ranges[i].first);
+
+            if (useVertexBuffer)
+                target.draw(buffer, first, ranges[i].second, states);
+            else
+                target.draw(&vertices[first], ranges[i].second, vertices.getPrimitiveType(), states);
+
+            first += ranges[i].second;
+        }
     }
 }
 
@@ -76,22 +88,30 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Text::Text() :
-m_string               (),
-m_font                 (NULL),
-m_characterSize        (30),
-m_letterSpacingFactor  (1.f),
-m_lineSpacingFactor    (1.f),
-m_style                (Regular),
-m_fillColor            (255, 255, 255),
-m_outlineColor         (0, 0, 0),
-m_outlineThickness     (0),
-m_vertices             (Triangles),
-m_outlineVertices      (Triangles),
-m_verticesBuffer       (Triangles, VertexBuffer::Static),
-m_outlineVerticesBuffer(Triangles, VertexBuffer::Static),
-m_bounds               (),
-m_geometryNeedUpdate   (false),
-m_fontTextureId        (0)
+m_string                 (),
+m_font                   (NULL),
+m_characterSize          (30),
+m_letterSpacingFactor    (1.f),
+m_lineSpacingFactor      (1.f),
+m_style                  (Regular),
+m_fillColor              (255, 255, 255),
+m_outlineColor           (0, 0, 0),
+m_outlineThickness       (0),
+m_vertices               (Triangles),
+m_outlineVertices        (Triangles),
+m_verticesBuffer         (Triangles, VertexBuffer::Static),
+m_outlineVerticesBuffer  (Triangles, VertexBuffer::Static),
+m_fillPages              (),
+m_outlinePages           (),
+m_bounds                 (),
+m_geometryNeedUpdate     (false),
+m_layout                 (),
+m_fontTextureId          (0),
+m_fontPageEvictions      (0),
+m_textLayout             (),
+m_textLayoutNeedUpdate   (true),
+m_textLayoutTextureId    (0),
+m_textLayoutPageEvictions(0)
 {
 
 }
@@ -99,22 +119,30 @@ m_fontTextureId        (0)
 
 ////////////////////////////////////////////////////////////
 Text::Text(const String& string, const Font& font, unsigned int characterSize) :
-m_string               (string),
-m_font                 (&font),
-m_characterSize        (characterSize),
-m_letterSpacingFactor  (1.f),
-m_lineSpacingFactor    (1.f),
-m_style                (Regular),
-m_fillColor            (255, 255, 255),
-m_outlineColor         (0, 0, 0),
-m_outlineThickness     (0),
-m_vertices             (Triangles),
-m_outlineVertices      (Triangles),
-m_verticesBuffer       (Triangles, VertexBuffer::Static),
-m_outlineVerticesBuffer(Triangles, VertexBuffer::Static),
-m_bounds               (),
-m_geometryNeedUpdate   (true),
-m_fontTextureId        (0)
+m_string                 (string),
+m_font                   (&font),
+m_characterSize          (characterSize),
+m_letterSpacingFactor    (1.f),
+m_lineSpacingFactor      (1.f),
+m_style                  (Regular),
+m_fillColor              (255, 255, 255),
+m_outlineColor           (0, 0, 0),
+m_outlineThickness       (0),
+m_vertices               (Triangles),
+m_outlineVertices        (Triangles),
+m_verticesBuffer         (Triangles, VertexBuffer::Static),
+m_outlineVerticesBuffer  (Triangles, VertexBuffer::Static),
+m_fillPages              (),
+m_outlinePages           (),
+m_bounds                 (),
+m_geometryNeedUpdate     (true),
+m_layout                 (),
+m_fontTextureId          (0),
+m_fontPageEvictions      (0),
+m_textLayout             (),
+m_textLayoutNeedUpdate   (true),
+m_textLayoutTextureId    (0),
+m_textLayoutPageEvictions(0)
 {
 
 }
@@ -123,10 +151,16 @@ m_fontTextureId        (0)
 ////////////////////////////////////////////////////////////
 void Text::setString(const String& string)
 {
-    if (m_string != string)
+    if ((string.getSize() > m_string.getSize()) && std::equal(m_string.begin(), m_string.end(), string.begin()))
+    {
+        // Characters appended at the end: only these will have to be laid out
+        m_string = string;
+    }
+    else if (m_string != string)
     {
         m_string = string;
         m_geometryNeedUpdate = true;
+        m_textLayoutNeedUpdate = true;
     }
 }
 
@@ -138,6 +172,7 @@ void Text::setFont(const Font& font)
     {
         m_font = &font;
         m_geometryNeedUpdate = true;
+        m_textLayoutNeedUpdate = true;
     }
 }
 
@@ -149,6 +184,7 @@ void Text::setCharacterSize(unsigned int size)
     {
         m_characterSize = size;
         m_geometryNeedUpdate = true;
+        m_textLayoutNeedUpdate = true;
     }
 }
 
@@ -160,6 +196,7 @@ void Text::setLetterSpacing(float spacingFactor)
     {
         m_letterSpacingFactor = spacingFactor;
         m_geometryNeedUpdate = true;
+        m_textLayoutNeedUpdate = true;
     }
 }
 
@@ -171,6 +208,7 @@ void Text::setLineSpacing(float spacingFactor)
     {
         m_lineSpacingFactor = spacingFactor;
         m_geometryNeedUpdate = true;
+        m_textLayoutNeedUpdate = true;
     }
 }
 
@@ -182,6 +220,7 @@ void Text::setStyle(Uint32 style)
     {
         m_style = style;
         m_geometryNeedUpdate = true;
+        m_textLayoutNeedUpdate = true;
     }
 }
 
@@ -208,13 +247,7 @@ void Text::setFillColor(const Color& color)
                 m_vertices[i].color = m_fillColor;
 
             if (VertexBuffer::isAvailable())
-            {
-                if (m_verticesBuffer.getVertexCount() != m_vertices.getVertexCount())
-                    m_verticesBuffer.create(m_vertices.getVertexCount());
-
-                if (m_vertices.getVertexCount() > 0)
-                    m_verticesBuffer.update(&m_vertices[0]);
-            }
+                uploadVertices(m_verticesBuffer, m_vertices, 0);
         }
     }
 }
@@ -235,13 +268,7 @@ void Text::setOutlineColor(const Color& color)
                 m_outlineVertices[i].color = m_outlineColor;
 
             if (VertexBuffer::isAvailable())
-            {
-                if (m_outlineVerticesBuffer.getVertexCount() != m_outlineVertices.getVertexCount())
-                    m_outlineVerticesBuffer.create(m_outlineVertices.getVertexCount());
-
-                if (m_outlineVertices.getVertexCount() > 0)
-                    m_outlineVerticesBuffer.update(&m_outlineVertices[0]);
-            }
+                uploadVertices(m_outlineVerticesBuffer, m_outlineVertices, 0);
         }
     }
 }
@@ -335,44 +362,37 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (!m_font)
         return Vector2f();
 
-    // Adjust the index if it's out of range
-    if (index > m_string.getSize())
-        index = m_string.getSize();
-
-    // Precompute the variables needed by the algorithm
-    bool  isBold          = m_style & Bold;
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
-    float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
-    whitespaceWidth      += letterSpacing;
-    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
-
-    // Compute the position
-    Vector2f position;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < index; ++i)
-    {
-        Uint32 curChar = m_string[i];
+    // Transform the position to global coordinates
+    return getTransform().transformPoint(getLayout().getCaretPosition(index));
+}
 
-        // Apply the kerning offset
-        position.x += m_font->getKerning(prevChar, curChar, m_characterSize);
-        prevChar = curChar;
 
-        // Handle special characters
-        switch (curChar)
+////////////////////////////////////////////////////////////
+const TextLayout& Text::getLayout() const
+{
+    if (m_font)
+    {
+        // The layout must also be computed again if the font was reloaded, or if it has
+        // evicted glyphs to stay within its memory budget (their texture rects are no longer valid)
+        if (m_textLayoutNeedUpdate || (m_font->getTexture(m_characterSize).m_cacheId != m_textLayoutTextureId) ||
+            (m_font->m_cache->pageEvictions != m_textLayoutPageEvictions))
+        {
+            // Evictions caused by loading the glyphs of the text itself may remove some of them, so they are saved beforehand
+            m_textLayoutPageEvictions = m_font->m_cache->pageEvictions;
+            m_textLayout.update(*this);
+            m_textLayoutNeedUpdate = false;
+        }
+        else if (m_textLayout.getCharacterCount() < m_string.getSize())
         {
-            case ' ':  position.x += whitespaceWidth;             continue;
-            case '\t': position.x += whitespaceWidth * 4;         continue;
-            case '\n': position.y += lineSpacing; position.x = 0; continue;
+            // Characters were only appended to the string
+            m_textLayout.extend(m_string);
         }
 
-        // For regular characters, add the advance offset of the glyph
-        position.x += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
+        // Save the texture id once the glyphs of the text are loaded
+        m_textLayoutTextureId = m_font->getTexture(m_characterSize).m_cacheId;
     }
 
-    // Transform the position to global coordinates
-    position = getTransform().transformPoint(position);
-
-    return position;
+    return m_textLayout;
 }
 
 
@@ -400,29 +420,27 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         ensureGeometryUpdate();
 
         states.transform *= getTransform();
-        states.texture = &m_font->getTexture(m_characterSize);
 
-        // Only draw the outline if there is something to draw
-        if (m_outlineThickness != 0)
-        {
-            if (VertexBuffer::isAvailable())
-            {
-                target.draw(m_outlineVerticesBuffer, states);
-            }
-            else
-            {
-                target.draw(m_outlineVertices, states);
-            }
-        }
+        // Prefer the vertex arrays when batching, so that they can be merged
+        bool useVertexBuffer = !target.isBatchingEnabled() && VertexBuffer::isAvailable();
 
-        if (VertexBuffer::isAvailable())
-        {
-            target.draw(m_verticesBuffer, states);
-        }
-        else
+        // Distance field glyphs need the built-in shader (unless a custom one is provided);
+        // the bold and outline shapes are obtained by moving the edge threshold
+        RenderStates outlineStates(states);
+        if (m_font->isDistanceField() && !states.shader)
         {
-            target.draw(m_vertices, states);
+            float fieldScale = static_cast<float>(Font::DistanceFieldSize) / (2.f * Font::DistanceFieldSpread * m_characterSize);
+            float threshold = 0.5f - ((m_style & Bold) ? 0.5f * fieldScale : 0.f);
+
+            states.shader = m_font->getDistanceFieldShader(threshold);
+            outlineStates.shader = m_font->getDistanceFieldShader(threshold - m_outlineThickness * fieldScale);
         }
+
+        // Only draw the outline if there is something to draw
+        if (m_outlineThickness != 0)
+            drawPages(target, outlineStates, *m_font, m_outlineVertices, m_outlineVerticesBuffer, m_outlinePages, useVertexBuffer);
+
+        drawPages(target, states, *m_font, m_vertices, m_verticesBuffer, m_fillPages, useVertexBuffer);
     }
 }
 
@@ -433,25 +451,70 @@ void Text::ensureGeometryUpdate() const
     if (!m_font)
         return;
 
-    // Do nothing, if geometry has not changed and the font texture has not changed
-    if (!m_geometryNeedUpdate && m_font->getTexture(m_characterSize).m_cacheId == m_fontTextureId)
+    // Do nothing, if geometry has not changed, no character was appended and the font texture has not changed
+    // (nor has the font evicted glyphs to stay within its memory budget)
+    bool textureChanged = (m_font->getTexture(m_characterSize).m_cacheId != m_fontTextureId) ||
+                          (m_font->m_cache->pageEvictions != m_fontPageEvictions);
+    if (!m_geometryNeedUpdate && !textureChanged && (m_layout.length == m_string.getSize()))
         return;
 
-    // Save the current fonts texture id
-    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    // If characters were only appended, add the quads of the new glyphs after the existing geometry
+    // (geometry spanning several font pages has been reordered, and is rebuilt instead)
+    bool append = !m_geometryNeedUpdate && !textureChanged && (m_layout.length > 0) &&
+                  (m_fillPages.size() <= 1) && (m_outlinePages.size() <= 1);
 
-    // Mark geometry as updated
+    // Mark geometry as updated; evictions caused by loading the glyphs of
+    // the text itself may remove some of them, so they are saved beforehand
     m_geometryNeedUpdate = false;
 
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_outlineVertices.clear();
+    // Keep the glyphs of the text loaded until its geometry is built, including the
+    // ones already in the geometry when characters are appended
+    m_font->beginLayout();
+    m_fontPageEvictions = m_font->m_cache->pageEvictions;
+    if (append)
+    {
+        for (std::size_t i = 0; i < m_fillPages.size(); ++i)
+            m_font->usePage(m_fillPages[i].first);
+        for (std::size_t i = 0; i < m_outlinePages.size(); ++i)
+            m_font->usePage(m_outlinePages[i].first);
+    }
+
+    // Lay out the new characters, or the whole string; the geometry is built from the layout
+    const TextLayout& layout = getLayout();
 
+    if (append)
+    {
+        // Remove the trailing underline and strike through, they will be extended to the new end
+        m_vertices.resize(m_layout.fillEnd);
+        m_outlineVertices.resize(m_layout.outlineEnd);
+    }
+    else
+    {
+        // Clear the previous geometry
+        m_vertices.clear();
+        m_outlineVertices.clear();
+        m_layout = LayoutState();
+        m_layout.min = Vector2f(static_cast<float>(m_characterSize), static_cast<float>(m_characterSize));
+    }
+
+    std::size_t fillFirst = m_vertices.getVertexCount();
+    std::size_t outlineFirst = m_outlineVertices.getVertexCount();
+
+    // Font page of each quad, to group them by texture once the geometry is built
+    // (the quads of an appended geometry were all in a single page)
+    std::vector<unsigned int> fillPages(fillFirst / 6, m_fillPages.empty() ? 0 : m_fillPages[0].first);
+    std::vector<unsigned int> outlinePages(outlineFirst / 6, m_outlinePages.empty() ? 0 : m_outlinePages[0].first);
+
+    m_fillPages.clear();
+    m_outlinePages.clear();
     m_bounds = FloatRect();
 
     // No text: nothing to draw
     if (m_string.isEmpty())
     {
+        m_font->endLayout();
+        m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+
         if (VertexBuffer::isAvailable())
         {
             if (m_verticesBuffer.getVertexCount())
@@ -464,170 +527,108 @@ void Text::ensureGeometryUpdate() const
         return;
     }
 
-    // Compute values related to the text style
-    bool  isBold             = m_style & Bold;
-    bool  isUnderlined       = m_style & Underlined;
-    bool  isStrikeThrough    = m_style & StrikeThrough;
-    float italicShear        = (m_style & Italic) ? 0.209f : 0.f; // 12 degrees in radians
-    float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
-    float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
-
-    // Compute the location of the strike through dynamically
-    // We use the center point of the lowercase 'x' glyph as the reference
-    // We reuse the underline thickness as the thickness of the strike through as well
-    FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, isBold).bounds;
-    float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
-
-    // Precompute the variables needed by the algorithm
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
-    float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
-    whitespaceWidth      += letterSpacing;
-    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
-    float x               = 0.f;
-    float y               = static_cast<float>(m_characterSize);
-
-    // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
-    {
-        Uint32 curChar = m_string[i];
-
-        // Skip the \r char to avoid weird graphical issues
-        if (curChar == '\r')
-            continue;
-
-        // Apply the kerning offset
-        x += m_font->getKerning(prevChar, curChar, m_characterSize);
-
-        // If we're using the underlined style and there's a new line, draw a line
-        if (isUnderlined && (curChar == L'\n' && prevChar != L'\n'))
-        {
-            addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+    const std::vector<TextLayout::GlyphInfo>& glyphs = layout.getGlyphs();
+    const std::vector<TextLayout::Line>& lines = layout.getLines();
 
-            if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
-        }
-
-        // If we're using the strike through style and there's a new line, draw a line across all characters
-        if (isStrikeThrough && (curChar == L'\n' && prevChar != L'\n'))
-        {
-            addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
-
-            if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
-        }
-
-        prevChar = curChar;
-
-        // Handle special characters
-        if ((curChar == L' ') || (curChar == L'\n') || (curChar == L'\t'))
-        {
-            // Update the current bounds (min coordinates)
-            minX = std::min(minX, x);
-            minY = std::min(minY, y);
-
-            switch (curChar)
-            {
-                case L' ':  x += whitespaceWidth;     break;
-                case L'\t': x += whitespaceWidth * 4; break;
-                case L'\n': y += lineSpacing; x = 0;  break;
-            }
-
-            // Update the current bounds (max coordinates)
-            maxX = std::max(maxX, x);
-            maxY = std::max(maxY, y);
-
-            // Next glyph, no need to create a quad for whitespace
-            continue;
-        }
-
-        // Apply the outline
-        if (m_outlineThickness != 0)
+    // Add the outline of the new glyphs, and compute its bounds
+    if (m_outlineThickness != 0)
+    {
+        bool  isBold        = (m_style & Bold) != 0;
+        bool  distanceField = m_font->isDistanceField();
+        float italicShear   = layout.m_italicShear;
+        float minX          = m_layout.min.x;
+        float minY          = m_layout.min.y;
+        float maxX          = m_layout.max.x;
+        float maxY          = m_layout.max.y;
+
+        for (std::size_t i = m_layout.glyphCount; i < glyphs.size(); ++i)
         {
-            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold, m_outlineThickness);
-
-            float left   = glyph.bounds.left;
-            float top    = glyph.bounds.top;
-            float right  = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top  + glyph.bounds.height;
+            const TextLayout::GlyphInfo& info = glyphs[i];
+            const Glyph& glyph = m_font->getGlyph(info.codePoint, m_characterSize, isBold, m_outlineThickness);
 
             // Add the outline glyph to the vertices
-            addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear, m_outlineThickness);
+            // Distance field outlines are drawn by the shader, from the field of the fill glyph
+            if (distanceField)
+                priv::addGlyphQuad(m_outlineVertices, outlinePages, info.page, info.position, m_outlineColor, info.bounds, info.textureRect,
+                                   italicShear, layout.m_padding, layout.m_texturePadding);
+            else
+                priv::addGlyphQuad(m_outlineVertices, outlinePages, glyph.page, info.position, m_outlineColor, glyph.bounds, glyph.textureRect,
+                                   italicShear, layout.m_padding, layout.m_texturePadding, m_outlineThickness);
 
             // Update the current bounds with the outlined glyph bounds
-            minX = std::min(minX, x + left   - italicShear * bottom - m_outlineThickness);
-            maxX = std::max(maxX, x + right  - italicShear * top    - m_outlineThickness);
-            minY = std::min(minY, y + top    - m_outlineThickness);
-            maxY = std::max(maxY, y + bottom - m_outlineThickness);
-        }
-
-        // Extract the current glyph's description
-        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold);
-
-        // Add the glyph to the vertices
-        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italicShear);
-
-        // Update the current bounds with the non outlined glyph bounds
-        if (m_outlineThickness == 0)
-        {
             float left   = glyph.bounds.left;
             float top    = glyph.bounds.top;
             float right  = glyph.bounds.left + glyph.bounds.width;
             float bottom = glyph.bounds.top  + glyph.bounds.height;
 
-            minX = std::min(minX, x + left  - italicShear * bottom);
-            maxX = std::max(maxX, x + right - italicShear * top);
-            minY = std::min(minY, y + top);
-            maxY = std::max(maxY, y + bottom);
+            minX = std::min(minX, info.position.x + left   - italicShear * bottom - m_outlineThickness);
+            maxX = std::max(maxX, info.position.x + right  - italicShear * top    - m_outlineThickness);
+            minY = std::min(minY, info.position.y + top    - m_outlineThickness);
+            maxY = std::max(maxY, info.position.y + bottom - m_outlineThickness);
         }
 
-        // Advance to the next character
-        x += glyph.advance + letterSpacing;
+        m_layout.min = Vector2f(minX, minY);
+        m_layout.max = Vector2f(maxX, maxY);
+
+        layout.addLineQuads(m_outlineVertices, outlinePages, m_layout.lineCount, lines.size() - 1, m_outlineColor, Vector2f(), m_outlineThickness);
     }
 
-    // If we're using the underlined style, add the last line
-    if (isUnderlined && (x > 0))
+    // Add the new glyphs, and the underline and strike through of the lines they closed
+    layout.addGlyphQuads(m_vertices, fillPages, m_layout.glyphCount, m_fillColor, Vector2f());
+    layout.addLineQuads(m_vertices, fillPages, m_layout.lineCount, lines.size() - 1, m_fillColor, Vector2f());
+
+    // Save the geometry state, so that appended characters can continue from here
+    m_layout.length     = m_string.getSize();
+    m_layout.glyphCount = glyphs.size();
+    m_layout.lineCount  = lines.size() - 1;
+    m_layout.fillEnd    = m_vertices.getVertexCount();
+    m_layout.outlineEnd = m_outlineVertices.getVertexCount();
+
+    // Add the underline and strike through of the last line, which is still open
+    layout.addLineQuads(m_vertices, fillPages, lines.size() - 1, lines.size(), m_fillColor, Vector2f());
+    if (m_outlineThickness != 0)
+        layout.addLineQuads(m_outlineVertices, outlinePages, lines.size() - 1, lines.size(), m_outlineColor, Vector2f(), m_outlineThickness);
+
+    // Update the bounding rectangle; the outline extends the bounds of the glyphs
+    m_bounds = layout.getBounds();
+    if (m_outlineThickness != 0)
     {
-        addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
-
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+        float minX = std::min(m_bounds.left, m_layout.min.x);
+        float minY = std::min(m_bounds.top, m_layout.min.y);
+        float maxX = std::max(m_bounds.left + m_bounds.width, m_layout.max.x);
+        float maxY = std::max(m_bounds.top + m_bounds.height, m_layout.max.y);
+        m_bounds = FloatRect(minX, minY, maxX - minX, maxY - minY);
     }
 
-    // If we're using the strike through style, add the last line across all characters
-    if (isStrikeThrough && (x > 0))
-    {
-        addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+    // Make sure that each font page is drawn only once
+    priv::groupQuads(m_vertices, fillPages, m_fillPages);
+    priv::groupQuads(m_outlineVertices, outlinePages, m_outlinePages);
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
-    }
+    m_font->endLayout();
 
-    // Update the bounding rectangle
-    m_bounds.left = minX;
-    m_bounds.top = minY;
-    m_bounds.width = maxX - minX;
-    m_bounds.height = maxY - minY;
+    // Save the current font texture id, once the glyphs of the text are loaded
+    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
 
-    // Update the vertex buffer if it is being used
+    // Update the vertex buffer if it is being used, from the first new
+    // vertex unless the geometry was reordered
     if (VertexBuffer::isAvailable())
     {
-        if (m_verticesBuffer.getVertexCount() != m_vertices.getVertexCount())
-            m_verticesBuffer.create(m_vertices.getVertexCount());
-
-        if (m_vertices.getVertexCount() > 0)
-            m_verticesBuffer.update(&m_vertices[0]);
+        uploadVertices(m_verticesBuffer, m_vertices, (m_fillPages.size() > 1) ? 0 : fillFirst);
+        uploadVertices(m_outlineVerticesBuffer, m_outlineVertices, (m_outlinePages.size() > 1) ? 0 : outlineFirst);
+    }
+}
 
-        if (m_outlineVerticesBuffer.getVertexCount() != m_outlineVertices.getVertexCount())
-            m_outlineVerticesBuffer.create(m_outlineVertices.getVertexCount());
 
-        if (m_outlineVertices.getVertexCount() > 0)
-            m_outlineVerticesBuffer.update(&m_outlineVertices[0]);
-    }
+////////////////////////////////////////////////////////////
+Text::LayoutState::LayoutState() :
+length    (0),
+glyphCount(0),
+lineCount (0),
+min       (),
+max       (),
+fillEnd   (0),
+outlineEnd(0)
+{
 }
 
 } // namespace sf
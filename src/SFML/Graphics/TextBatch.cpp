@@ -0,0 +1,515 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextBatch.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/TextGeometry.hpp>
+#include <algorithm>
+#include <map>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch() :
+m_font              (NULL),
+m_characterSize     (30),
+m_entries           (),
+m_layout            (),
+m_vertices          (Triangles),
+m_vertexBuffer      (Triangles, VertexBuffer::Dynamic),
+m_ranges            (),
+m_bounds            (),
+m_geometryNeedUpdate(false),
+m_assembleNeedUpdate(false),
+m_entriesNeedUpdate (false),
+m_fontTextureId     (0),
+m_fontPageEvictions (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch(const Font& font, unsigned int characterSize) :
+m_font              (&font),
+m_characterSize     (characterSize),
+m_entries           (),
+m_layout            (),
+m_vertices          (Triangles),
+m_vertexBuffer      (Triangles, VertexBuffer::Dynamic),
+m_ranges            (),
+m_bounds            (),
+m_geometryNeedUpdate(true),
+m_assembleNeedUpdate(false),
+m_entriesNeedUpdate (false),
+m_fontTextureId     (0),
+m_fontPageEvictions (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setFont(const Font& font)
+{
+    if (m_font != &font)
+    {
+        m_font = &font;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setCharacterSize(unsigned int size)
+{
+    if (m_characterSize != size)
+    {
+        m_characterSize = size;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Font* TextBatch::getFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextBatch::getCharacterSize() const
+{
+    return m_characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextBatch::add(const String& string, const Vector2f& position, const Color& color, Uint32 style)
+{
+    m_entries.push_back(Entry());
+
+    Entry& entry = m_entries.back();
+    entry.string   = string;
+    entry.position = position;
+    entry.color    = color;
+    entry.style    = style;
+
+    // The new entry has no place in the geometry yet
+    m_assembleNeedUpdate = true;
+    m_entriesNeedUpdate = true;
+
+    return m_entries.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::remove(std::size_t index)
+{
+    m_entries.erase(m_entries.begin() + index);
+    m_assembleNeedUpdate = true;
+    m_entriesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::clear()
+{
+    m_entries.clear();
+    m_assembleNeedUpdate = true;
+    m_entriesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextBatch::getEntryCount() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setEntryString(std::size_t index, const String& string)
+{
+    Entry& entry = m_entries[index];
+    if (entry.string != string)
+    {
+        entry.string = string;
+        entry.layoutNeedUpdate = true;
+        m_entriesNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setEntryPosition(std::size_t index, const Vector2f& position)
+{
+    Entry& entry = m_entries[index];
+    if (entry.position != position)
+    {
+        entry.position = position;
+        entry.verticesNeedUpdate = true;
+        m_entriesNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setEntryColor(std::size_t index, const Color& color)
+{
+    Entry& entry = m_entries[index];
+    if (entry.color != color)
+    {
+        entry.color = color;
+        entry.verticesNeedUpdate = true;
+        m_entriesNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setEntryStyle(std::size_t index, Uint32 style)
+{
+    Entry& entry = m_entries[index];
+    if (entry.style != style)
+    {
+        entry.style = style;
+        entry.layoutNeedUpdate = true;
+        m_entriesNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const String& TextBatch::getEntryString(std::size_t index) const
+{
+    return m_entries[index].string;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& TextBatch::getEntryPosition(std::size_t index) const
+{
+    return m_entries[index].position;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& TextBatch::getEntryColor(std::size_t index) const
+{
+    return m_entries[index].color;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TextBatch::getEntryStyle(std::size_t index) const
+{
+    return m_entries[index].style;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextBatch::getEntryBounds(std::size_t index) const
+{
+    ensureGeometryUpdate();
+
+    FloatRect bounds = m_entries[index].bounds;
+    bounds.left += m_entries[index].position.x;
+    bounds.top += m_entries[index].position.y;
+
+    return bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextBatch::getLocalBounds() const
+{
+    ensureGeometryUpdate();
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextBatch::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_font)
+        return;
+
+    ensureGeometryUpdate();
+
+    states.transform *= getTransform();
+
+    // Prefer the vertex array when batching, so that it can be merged with other draws
+    bool useVertexBuffer = !target.isBatchingEnabled() && VertexBuffer::isAvailable();
+
+    // Distance field glyphs need the built-in shader (unless a custom one is provided);
+    // bold strings have their own draw key, since they use a different edge threshold
+    bool distanceField = m_font->isDistanceField() && !states.shader;
+    float fieldScale = static_cast<float>(Font::DistanceFieldSize) / (2.f * Font::DistanceFieldSpread * m_characterSize);
+
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < m_ranges.size(); ++i)
+    {
+        unsigned int key = m_ranges[i].first;
+        std::size_t count = m_ranges[i].second;
+
+        states.texture = &m_font->getPageTexture(key / 2);
+
+        if (distanceField)
+            states.shader = m_font->getDistanceFieldShader(0.5f - ((key % 2) ? 0.5f * fieldScale : 0.f));
+
+        if (useVertexBuffer)
+            target.draw(m_vertexBuffer, first, count, states);
+        else
+            target.draw(&m_vertices[first], count, Triangles, states);
+
+        first += count;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::ensureGeometryUpdate() const
+{
+    if (!m_font)
+        return;
+
+    // Everything must be laid out again if the font texture has changed, or if
+    // the font has evicted glyphs to stay within its memory budget
+    if ((m_font->getTexture(m_characterSize).m_cacheId != m_fontTextureId) || (m_font->m_cache->pageEvictions != m_fontPageEvictions))
+        m_geometryNeedUpdate = true;
+
+    // Do nothing if no entry has changed
+    if (!m_geometryNeedUpdate && !m_entriesNeedUpdate)
+        return;
+
+    // Evictions caused by loading the glyphs of the entries may remove some of them, so they are saved beforehand
+    m_fontPageEvictions = m_font->m_cache->pageEvictions;
+
+    // Lay out the entries whose string or style has changed; if the draw keys or
+    // vertex counts of an entry change, the geometry of the batch must be assembled again
+    bool assemble = m_geometryNeedUpdate || m_assembleNeedUpdate;
+
+    // Keep the glyphs of all the entries loaded while they are laid out, including
+    // the ones of the entries that don't change (the draw key of a range is page * 2 + bold)
+    m_font->beginLayout();
+    if (!m_geometryNeedUpdate)
+    {
+        for (std::size_t i = 0; i < m_ranges.size(); ++i)
+            m_font->usePage(m_ranges[i].first / 2);
+    }
+
+    for (std::vector<Entry>::iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+    {
+        if (entry->layoutNeedUpdate || m_geometryNeedUpdate)
+        {
+            Ranges previous;
+            previous.swap(entry->ranges);
+
+            layout(*entry);
+
+            assemble = assemble || (entry->ranges != previous);
+            entry->layoutNeedUpdate = false;
+            entry->verticesNeedUpdate = true;
+        }
+    }
+
+    m_font->endLayout();
+
+    // Save the current font texture id, once the glyphs of all the entries are loaded
+    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+
+    if (assemble)
+    {
+        // Count the vertices of each draw key, and compute where each group starts
+        std::map<unsigned int, std::size_t> offsets;
+        for (std::vector<Entry>::const_iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+        {
+            for (std::size_t i = 0; i < entry->ranges.size(); ++i)
+                offsets[entry->ranges[i].first] += entry->ranges[i].second;
+        }
+
+        m_ranges.clear();
+        std::size_t vertexCount = 0;
+        for (std::map<unsigned int, std::size_t>::iterator it = offsets.begin(); it != offsets.end(); ++it)
+        {
+            m_ranges.push_back(std::make_pair(it->first, it->second));
+            it->second = vertexCount;
+            vertexCount += m_ranges.back().second;
+        }
+
+        // Give each group of each entry its place in the geometry, and fill it
+        m_vertices.resize(vertexCount);
+        for (std::vector<Entry>::iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+        {
+            entry->offsets.resize(entry->ranges.size());
+            for (std::size_t i = 0; i < entry->ranges.size(); ++i)
+            {
+                std::size_t& offset = offsets[entry->ranges[i].first];
+                entry->offsets[i] = offset;
+                offset += entry->ranges[i].second;
+            }
+
+            writeEntry(*entry, false);
+            entry->verticesNeedUpdate = false;
+        }
+
+        // Write the whole geometry to the vertex buffer
+        if (VertexBuffer::isAvailable())
+        {
+            if (m_vertexBuffer.getVertexCount() != vertexCount)
+                m_vertexBuffer.create(vertexCount);
+
+            if (vertexCount > 0)
+                m_vertexBuffer.update(&m_vertices[0]);
+        }
+    }
+    else
+    {
+        // Only write the entries that changed, in place
+        for (std::vector<Entry>::iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+        {
+            if (entry->verticesNeedUpdate)
+            {
+                writeEntry(*entry, VertexBuffer::isAvailable());
+                entry->verticesNeedUpdate = false;
+            }
+        }
+    }
+
+    // Update the bounding rectangle
+    bool empty = true;
+    float minX = 0.f;
+    float minY = 0.f;
+    float maxX = 0.f;
+    float maxY = 0.f;
+    for (std::vector<Entry>::const_iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+    {
+        if (entry->string.isEmpty())
+            continue;
+
+        float left = entry->position.x + entry->bounds.left;
+        float top = entry->position.y + entry->bounds.top;
+
+        minX = empty ? left : std::min(minX, left);
+        minY = empty ? top : std::min(minY, top);
+        maxX = empty ? left + entry->bounds.width : std::max(maxX, left + entry->bounds.width);
+        maxY = empty ? top + entry->bounds.height : std::max(maxY, top + entry->bounds.height);
+        empty = false;
+    }
+
+    m_bounds = FloatRect(minX, minY, maxX - minX, maxY - minY);
+
+    m_geometryNeedUpdate = false;
+    m_assembleNeedUpdate = false;
+    m_entriesNeedUpdate = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::layout(Entry& entry) const
+{
+    entry.vertices.clear();
+    entry.bounds = FloatRect();
+
+    if (entry.string.isEmpty())
+        return;
+
+    // Lay out the string like sf::Text, the color is applied when writing the quads to the batch
+    m_layout.update(entry.string, *m_font, m_characterSize, entry.style);
+
+    std::vector<unsigned int> keys;
+    m_layout.addGlyphQuads(entry.vertices, keys, 0, Color::White, Vector2f());
+    m_layout.addLineQuads(entry.vertices, keys, 0, m_layout.getLines().size(), Color::White, Vector2f());
+
+    // Distance field glyphs are drawn with a shader that depends on the
+    // bold style, so bold ones get their own draw key in each font page
+    unsigned int boldKey = (m_font->isDistanceField() && (entry.style & Text::Bold)) ? 1 : 0;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        keys[i] = keys[i] * 2 + boldKey;
+
+    entry.bounds = m_layout.getBounds();
+
+    // Group the quads by draw key, so that each key is a single range of the batch
+    priv::groupQuads(entry.vertices, keys, entry.ranges);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::writeEntry(const Entry& entry, bool upload) const
+{
+    std::size_t source = 0;
+    for (std::size_t i = 0; i < entry.ranges.size(); ++i)
+    {
+        std::size_t offset = entry.offsets[i];
+        std::size_t count = entry.ranges[i].second;
+
+        // Move the vertices to the position of the entry, and apply its color
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            Vertex& vertex = m_vertices[offset + j];
+            vertex = entry.vertices[source + j];
+            vertex.position += entry.position;
+            vertex.color = entry.color;
+        }
+
+        if (upload)
+            m_vertexBuffer.update(&m_vertices[offset], count, static_cast<unsigned int>(offset));
+
+        source += count;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TextBatch::Entry::Entry() :
+string            (),
+position          (),
+color             (Color::White),
+style             (Text::Regular),
+vertices          (Triangles),
+ranges            (),
+offsets           (),
+bounds            (),
+layoutNeedUpdate  (true),
+verticesNeedUpdate(true)
+{
+}
+
+} // namespace sf
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextGeometry.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void addTextLine(VertexArray& vertices, std::vector<unsigned int>& keys, unsigned int key, float lineLength, float lineTop,
+                 const Color& color, float offset, float thickness, float outlineThickness)
+{
+    float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
+    float bottom = top + std::floor(thickness + 0.5f);
+
+    vertices.append(Vertex(Vector2f(-outlineThickness,             top    - outlineThickness), color, Vector2f(1, 1)));
+    vertices.append(Vertex(Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, Vector2f(1, 1)));
+    vertices.append(Vertex(Vector2f(-outlineThickness,             bottom + outlineThickness), color, Vector2f(1, 1)));
+    vertices.append(Vertex(Vector2f(-outlineThickness,             bottom + outlineThickness), color, Vector2f(1, 1)));
+    vertices.append(Vertex(Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, Vector2f(1, 1)));
+    vertices.append(Vertex(Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, Vector2f(1, 1)));
+
+    // Lines use the white square found at the top-left corner of every page
+    keys.push_back(key);
+}
+
+
+////////////////////////////////////////////////////////////
+void addGlyphQuad(VertexArray& vertices, std::vector<unsigned int>& keys, unsigned int key, Vector2f position, const Color& color,
+                  const FloatRect& bounds, const IntRect& textureRect, float italicShear, float padding, float texturePadding,
+                  float outlineThickness)
+{
+    float left   = bounds.left - padding;
+    float top    = bounds.top - padding;
+    float right  = bounds.left + bounds.width + padding;
+    float bottom = bounds.top  + bounds.height + padding;
+
+    float u1 = static_cast<float>(textureRect.left) - texturePadding;
+    float v1 = static_cast<float>(textureRect.top) - texturePadding;
+    float u2 = static_cast<float>(textureRect.left + textureRect.width) + texturePadding;
+    float v2 = static_cast<float>(textureRect.top  + textureRect.height) + texturePadding;
+
+    vertices.append(Vertex(Vector2f(position.x + left  - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, Vector2f(u1, v1)));
+    vertices.append(Vertex(Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, Vector2f(u2, v1)));
+    vertices.append(Vertex(Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, Vector2f(u1, v2)));
+    vertices.append(Vertex(Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, Vector2f(u1, v2)));
+    vertices.append(Vertex(Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, Vector2f(u2, v1)));
+    vertices.append(Vertex(Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, Vector2f(u2, v2)));
+
+    keys.push_back(key);
+}
+
+
+////////////////////////////////////////////////////////////
+void groupQuads(VertexArray& vertices, const std::vector<unsigned int>& keys, QuadRanges& ranges)
+{
+    ranges.clear();
+    if (keys.empty())
+        return;
+
+    // Most of the time, all the quads have the same key
+    unsigned int lastKey = 0;
+    bool singleKey = true;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        lastKey = std::max(lastKey, keys[i]);
+        singleKey = singleKey && (keys[i] == keys[0]);
+    }
+
+    if (singleKey)
+    {
+        ranges.push_back(std::make_pair(keys[0], vertices.getVertexCount()));
+        return;
+    }
+
+    // Stable counting sort of the quads by key
+    std::vector<std::size_t> offsets(lastKey + 2, 0);
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        offsets[keys[i] + 1] += 6;
+
+    for (unsigned int key = 0; key <= lastKey; ++key)
+    {
+        if (offsets[key + 1] > 0)
+            ranges.push_back(std::make_pair(key, offsets[key + 1]));
+
+        offsets[key + 1] += offsets[key];
+    }
+
+    std::vector<Vertex> sorted(vertices.getVertexCount());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        std::size_t& offset = offsets[keys[i]];
+        for (std::size_t j = 0; j < 6; ++j)
+            sorted[offset++] = vertices[i * 6 + j];
+    }
+
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+        vertices[i] = sorted[i];
+}
+
+} // namespace priv
+
+} // namespace sf
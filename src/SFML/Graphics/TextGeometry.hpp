@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTGEOMETRY_HPP
+#define SFML_TEXTGEOMETRY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Group of consecutive quads drawn with the same font
+///        page (and state), and the number of vertices in it
+///
+////////////////////////////////////////////////////////////
+typedef std::vector<std::pair<unsigned int, std::size_t> > QuadRanges;
+
+////////////////////////////////////////////////////////////
+/// \brief Add an underline or strike through line to a text geometry
+///
+/// \param vertices         Vertex array (triangles) to append the line to
+/// \param keys             Key of each quad, to which the key of the line is appended
+/// \param key              Key of the line
+/// \param lineLength       Length of the line
+/// \param lineTop          Vertical position of the baseline
+/// \param color            Color of the line
+/// \param offset           Offset of the line from the baseline
+/// \param thickness        Thickness of the line
+/// \param outlineThickness Thickness of the outline around the line
+///
+////////////////////////////////////////////////////////////
+void addTextLine(VertexArray& vertices, std::vector<unsigned int>& keys, unsigned int key, float lineLength, float lineTop,
+                 const Color& color, float offset, float thickness, float outlineThickness = 0);
+
+////////////////////////////////////////////////////////////
+/// \brief Add the quad of a glyph to a text geometry
+///
+/// \param vertices         Vertex array (triangles) to append the quad to
+/// \param keys             Key of each quad, to which the key of the glyph is appended
+/// \param key              Key of the glyph
+/// \param position         Position of the glyph on the baseline
+/// \param color            Color of the glyph
+/// \param bounds           Bounding rectangle of the glyph, relative to its position
+/// \param textureRect      Texture coordinates of the glyph
+/// \param italicShear      Horizontal shear applied to the quad
+/// \param padding          Margin added around the glyph bounds
+/// \param texturePadding   Margin added around the glyph texture rectangle
+/// \param outlineThickness Thickness of the glyph outline
+///
+////////////////////////////////////////////////////////////
+void addGlyphQuad(VertexArray& vertices, std::vector<unsigned int>& keys, unsigned int key, Vector2f position, const Color& color,
+                  const FloatRect& bounds, const IntRect& textureRect, float italicShear, float padding, float texturePadding,
+                  float outlineThickness = 0);
+
+////////////////////////////////////////////////////////////
+/// \brief Reorder the quads of a text geometry by key
+///
+/// The quads of a same key (typically, a font page) become
+/// contiguous, so that each key can be drawn in a single call.
+/// The sort is stable, and does nothing when all the quads
+/// have the same key.
+///
+/// \param vertices Vertex array (triangles) whose quads must be reordered
+/// \param keys     Key of each quad
+/// \param ranges   Filled with the key and vertex count of each group, in order
+///
+////////////////////////////////////////////////////////////
+void groupQuads(VertexArray& vertices, const std::vector<unsigned int>& keys, QuadRanges& ranges);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TEXTGEOMETRY_HPP
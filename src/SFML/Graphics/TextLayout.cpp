@@ -0,0 +1,452 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextLayout.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/TextGeometry.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Compare the first character of a line with a character index, for binary searches
+    bool lineStartsAfter(std::size_t index, const sf::TextLayout::Line& line)
+    {
+        return index < line.first;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextLayout::TextLayout() :
+m_font               (NULL),
+m_characterSize      (0),
+m_style              (0),
+m_glyphs             (),
+m_lines              (1),
+m_carets             (1, 0.f),
+m_lineSpacing        (0.f),
+m_letterSpacing      (0.f),
+m_whitespaceWidth    (0.f),
+m_italicShear        (0.f),
+m_padding            (0.f),
+m_texturePadding     (0.f),
+m_underlineOffset    (0.f),
+m_underlineThickness (0.f),
+m_strikeThroughOffset(0.f),
+m_linePage           (0),
+m_prevChar           (0),
+m_min                (),
+m_max                (),
+m_bounds             ()
+{
+    m_lines[0].first  = 0;
+    m_lines[0].length = 0;
+    m_lines[0].top    = 0.f;
+    m_lines[0].width  = 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+TextLayout::TextLayout(const String& string, const Font& font, unsigned int characterSize, Uint32 style,
+                       float letterSpacingFactor, float lineSpacingFactor) :
+m_font               (NULL),
+m_characterSize      (0),
+m_style              (0),
+m_glyphs             (),
+m_lines              (),
+m_carets             (),
+m_lineSpacing        (0.f),
+m_letterSpacing      (0.f),
+m_whitespaceWidth    (0.f),
+m_italicShear        (0.f),
+m_padding            (0.f),
+m_texturePadding     (0.f),
+m_underlineOffset    (0.f),
+m_underlineThickness (0.f),
+m_strikeThroughOffset(0.f),
+m_linePage           (0),
+m_prevChar           (0),
+m_min                (),
+m_max                (),
+m_bounds             ()
+{
+    update(string, font, characterSize, style, letterSpacingFactor, lineSpacingFactor);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::update(const String& string, const Font& font, unsigned int characterSize, Uint32 style,
+                        float letterSpacingFactor, float lineSpacingFactor)
+{
+    m_font          = &font;
+    m_characterSize = characterSize;
+    m_style         = style;
+
+    // Keep the glyphs of the text loaded while it is laid out
+    font.beginLayout();
+
+    m_glyphs.clear();
+    m_lines.clear();
+    m_carets.clear();
+    m_carets.reserve(string.getSize() + 1);
+
+    // Precompute the variables needed by the algorithm (the same as sf::Text)
+    bool isBold        = (style & Text::Bold) != 0;
+    m_italicShear      = (style & Text::Italic) ? 0.209f : 0.f; // 12 degrees in radians
+    m_whitespaceWidth  = font.getGlyph(L' ', characterSize, isBold).advance;
+    m_letterSpacing    = ( m_whitespaceWidth / 3.f ) * ( letterSpacingFactor - 1.f );
+    m_whitespaceWidth += m_letterSpacing;
+    m_lineSpacing      = font.getLineSpacing(characterSize) * lineSpacingFactor;
+
+    // Distance field glyphs are scaled from the reference size, and their quads include
+    // the margin where the shader draws the bold and outline shapes
+    bool distanceField = font.isDistanceField();
+    m_texturePadding   = distanceField ? static_cast<float>(Font::DistanceFieldSpread) : 1.f;
+    m_padding          = distanceField ? m_texturePadding * characterSize / Font::DistanceFieldSize : 1.f;
+
+    // The underline and strike through use the texture of the lowercase 'x' glyph, whose
+    // center gives the location of the strike through; the underline thickness is reused
+    if (style & (Text::Underlined | Text::StrikeThrough))
+    {
+        const Glyph& xGlyph   = font.getGlyph(L'x', characterSize, isBold);
+        m_underlineOffset     = font.getUnderlinePosition(characterSize);
+        m_underlineThickness  = font.getUnderlineThickness(characterSize);
+        m_strikeThroughOffset = xGlyph.bounds.top + xGlyph.bounds.height / 2.f;
+        m_linePage            = xGlyph.page;
+    }
+
+    // Start with an empty first line
+    Line line;
+    line.first  = 0;
+    line.length = 0;
+    line.top    = 0.f;
+    line.width  = 0.f;
+    m_lines.push_back(line);
+    m_carets.push_back(0.f);
+
+    m_prevChar = 0;
+    m_min      = Vector2f(static_cast<float>(characterSize), static_cast<float>(characterSize));
+    m_max      = Vector2f(0.f, 0.f);
+
+    layoutCharacters(string);
+
+    font.endLayout();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::update(const Text& text)
+{
+    if (text.getFont())
+    {
+        update(text.getString(), *text.getFont(), text.getCharacterSize(), text.getStyle(),
+               text.getLetterSpacing(), text.getLineSpacing());
+    }
+    else
+    {
+        *this = TextLayout();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::extend(const String& string)
+{
+    if (m_font && (string.getSize() > getCharacterCount()))
+    {
+        m_font->beginLayout();
+        layoutCharacters(string);
+        m_font->endLayout();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::getCharacterCount() const
+{
+    return m_carets.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<TextLayout::GlyphInfo>& TextLayout::getGlyphs() const
+{
+    return m_glyphs;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<TextLayout::Line>& TextLayout::getLines() const
+{
+    return m_lines;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::getLineIndex(std::size_t index) const
+{
+    // Last line whose first character is not after the index
+    std::vector<Line>::const_iterator it = std::upper_bound(m_lines.begin(), m_lines.end(), index, lineStartsAfter);
+
+    return static_cast<std::size_t>(it - m_lines.begin()) - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TextLayout::getCaretPosition(std::size_t index) const
+{
+    // Adjust the index if it's out of range
+    index = std::min(index, getCharacterCount());
+
+    return Vector2f(m_carets[index], m_lines[getLineIndex(index)].top);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::hitTest(const Vector2f& point) const
+{
+    // Find the line from the vertical position
+    std::size_t lineIndex = 0;
+    if ((m_lineSpacing > 0) && (point.y > 0))
+        lineIndex = std::min(static_cast<std::size_t>(point.y / m_lineSpacing), m_lines.size() - 1);
+
+    const Line& line = m_lines[lineIndex];
+
+    // Find the first caret of the line after the point (carets increase along a line)
+    std::vector<float>::const_iterator begin = m_carets.begin() + line.first;
+    std::vector<float>::const_iterator end   = begin + line.length + 1;
+    std::vector<float>::const_iterator after = std::upper_bound(begin, end, point.x);
+
+    if (after == begin)
+        return line.first;
+    if (after == end)
+        return line.first + line.length;
+
+    // Keep the closest of the carets around the point
+    std::vector<float>::const_iterator before = after - 1;
+    if (point.x - *before <= *after - point.x)
+        return static_cast<std::size_t>(before - m_carets.begin());
+    else
+        return static_cast<std::size_t>(after - m_carets.begin());
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextLayout::getBounds() const
+{
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::appendVertices(VertexArray& vertices, const Color& color, const Vector2f& offset) const
+{
+    // Keys are only needed by sf::Text and sf::TextBatch, the quads are appended in order
+    std::vector<unsigned int> keys;
+
+    addGlyphQuads(vertices, keys, 0, color, offset);
+    addLineQuads(vertices, keys, 0, m_lines.size(), color, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::appendVertices(VertexArray& vertices, const Color& color, const Vector2f& offset, unsigned int page) const
+{
+    std::vector<unsigned int> keys;
+
+    addGlyphQuads(vertices, keys, 0, color, offset, false, page);
+    addLineQuads(vertices, keys, 0, m_lines.size(), color, offset, 0, false, page);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::layoutCharacters(const String& string)
+{
+    const Font&  font          = *m_font;
+    unsigned int characterSize = m_characterSize;
+    bool         isBold        = (m_style & Text::Bold) != 0;
+
+    // Continue from the end of the current layout, the last line is still open
+    Line line = m_lines.back();
+    m_lines.pop_back();
+
+    float x = m_carets.back();
+    float y = line.top + static_cast<float>(characterSize);
+    m_carets.pop_back();
+
+    float minX = m_min.x;
+    float minY = m_min.y;
+    float maxX = m_max.x;
+    float maxY = m_max.y;
+
+    Uint32 prevChar = m_prevChar;
+    std::size_t count = string.getSize();
+    for (std::size_t i = m_carets.size(); i < count; ++i)
+    {
+        Uint32 curChar = string[i];
+
+        // The caret before a character doesn't include its kerning
+        m_carets.push_back(x);
+
+        // Skip the \r char, it has no width
+        if (curChar == '\r')
+            continue;
+
+        // Apply the kerning offset
+        x += font.getKerning(prevChar, curChar, characterSize);
+        prevChar = curChar;
+
+        // Handle special characters
+        if ((curChar == L' ') || (curChar == L'\n') || (curChar == L'\t'))
+        {
+            // Update the current bounds (min coordinates)
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+
+            switch (curChar)
+            {
+                case L' ':  x += m_whitespaceWidth;     break;
+                case L'\t': x += m_whitespaceWidth * 4; break;
+                case L'\n':
+                {
+                    // Close the current line, the line break belongs to it
+                    line.length = i - line.first;
+                    line.width  = x;
+                    m_lines.push_back(line);
+
+                    line.first = i + 1;
+                    line.top  += m_lineSpacing;
+                    y         += m_lineSpacing;
+                    x          = 0;
+                    break;
+                }
+            }
+
+            // Update the current bounds (max coordinates)
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+
+            continue;
+        }
+
+        const Glyph& glyph = font.getGlyph(curChar, characterSize, isBold);
+
+        GlyphInfo info;
+        info.codePoint   = curChar;
+        info.index       = i;
+        info.position    = Vector2f(x, y);
+        info.bounds      = glyph.bounds;
+        info.textureRect = glyph.textureRect;
+        info.page        = glyph.page;
+        m_glyphs.push_back(info);
+
+        // Update the current bounds with the glyph bounds
+        float left   = glyph.bounds.left;
+        float top    = glyph.bounds.top;
+        float right  = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+        minX = std::min(minX, x + left  - m_italicShear * bottom);
+        maxX = std::max(maxX, x + right - m_italicShear * top);
+        minY = std::min(minY, y + top);
+        maxY = std::max(maxY, y + bottom);
+
+        // Advance to the next character
+        x += glyph.advance + m_letterSpacing;
+    }
+
+    // Caret at the end of the string, and last line (left open for the characters appended later)
+    m_carets.push_back(x);
+
+    line.length = count - line.first;
+    line.width  = x;
+    m_lines.push_back(line);
+
+    m_prevChar = prevChar;
+    m_min      = Vector2f(minX, minY);
+    m_max      = Vector2f(maxX, maxY);
+
+    // An empty string has no bounds
+    if (count > 0)
+        m_bounds = FloatRect(minX, minY, maxX - minX, maxY - minY);
+    else
+        m_bounds = FloatRect();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::addGlyphQuads(VertexArray& vertices, std::vector<unsigned int>& keys, std::size_t first, const Color& color,
+                               const Vector2f& offset, bool allPages, unsigned int page) const
+{
+    for (std::size_t i = first; i < m_glyphs.size(); ++i)
+    {
+        const GlyphInfo& glyph = m_glyphs[i];
+        if (allPages || (glyph.page == page))
+            priv::addGlyphQuad(vertices, keys, glyph.page, glyph.position + offset, color, glyph.bounds, glyph.textureRect,
+                               m_italicShear, m_padding, m_texturePadding);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::addLineQuads(VertexArray& vertices, std::vector<unsigned int>& keys, std::size_t first, std::size_t last, const Color& color,
+                              const Vector2f& offset, float outlineThickness, bool allPages, unsigned int page) const
+{
+    bool isUnderlined    = (m_style & Text::Underlined) != 0;
+    bool isStrikeThrough = (m_style & Text::StrikeThrough) != 0;
+
+    if ((!isUnderlined && !isStrikeThrough) || (!allPages && (m_linePage != page)))
+        return;
+
+    for (std::size_t i = first; i < last; ++i)
+    {
+        // Empty lines have no underline nor strike through
+        const Line& line = m_lines[i];
+        if (line.width <= 0)
+            continue;
+
+        float baseline = line.top + m_characterSize + offset.y;
+        std::size_t firstVertex = vertices.getVertexCount();
+
+        if (isUnderlined)
+            priv::addTextLine(vertices, keys, m_linePage, line.width, baseline, color, m_underlineOffset, m_underlineThickness, outlineThickness);
+        if (isStrikeThrough)
+            priv::addTextLine(vertices, keys, m_linePage, line.width, baseline, color, m_strikeThroughOffset, m_underlineThickness, outlineThickness);
+
+        // The lines start at the origin of the layout
+        for (std::size_t j = firstVertex; j < vertices.getVertexCount(); ++j)
+            vertices[j].position.x += offset.x;
+    }
+}
+
+} // namespace sf
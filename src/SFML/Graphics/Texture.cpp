@@ -27,13 +27,17 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -53,6 +57,34 @@ namespace
 
         return id++;
     }
+
+    // Get the OpenGL internal format of a compressed texture format
+    GLenum getCompressedFormat(sf::Texture::Format format, bool sRgb, bool opaque)
+    {
+        // Opaque BC1 images use the RGB variant, which draws the transparent color as black
+        if ((format == sf::Texture::Bc1) && opaque)
+            return sRgb ? GLEXT_GL_COMPRESSED_SRGB_S3TC_DXT1 : GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1;
+
+        switch (format)
+        {
+            case sf::Texture::Bc1:      return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1;
+            case sf::Texture::Bc2:      return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3;
+            case sf::Texture::Bc3:      return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5;
+            case sf::Texture::Etc2Rgb:  return sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ETC2 : GLEXT_GL_COMPRESSED_RGB8_ETC2;
+            case sf::Texture::Etc2Rgba: return sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC : GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC;
+            default:                    break;
+        }
+
+        // The ASTC formats are consecutive, in the order of sf::Texture::Format
+        GLenum astc4x4 = sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4 : GLEXT_GL_COMPRESSED_RGBA_ASTC_4x4;
+        return astc4x4 + (format - sf::Texture::Astc4x4);
+    }
+
+    // Release pixels decompressed for an image
+    void deletePixels(sf::Uint8* pixels)
+    {
+        delete[] pixels;
+    }
 }
 
 
@@ -69,6 +101,7 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
+m_format       (Rgba8),
 m_cacheId      (getUniqueId())
 {
 }
@@ -85,6 +118,7 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
+m_format       (Rgba8),
 m_cacheId      (getUniqueId())
 {
     if (copy.m_texture)
@@ -154,6 +188,7 @@ bool Texture::create(unsigned int width, unsigned int height)
     m_actualSize    = actualSize;
     m_pixelsFlipped = false;
     m_fboAttachment = false;
+    m_format        = Rgba8;
 
     // Create the OpenGL texture if it doesn't exist yet
     if (!m_texture)
@@ -310,6 +345,166 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadFromImage(const Image& image, const std::vector<Image>& mipmaps)
+{
+    // Check the levels before touching the texture
+    Vector2u size = image.getSize();
+    for (std::size_t i = 0; i < mipmaps.size(); ++i)
+    {
+        size = Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+        if (mipmaps[i].getSize() != size)
+        {
+            err() << "Failed to load texture, mipmap level " << (i + 1) << " has an invalid size ("
+                  << mipmaps[i].getSize().x << "x" << mipmaps[i].getSize().y << ", expected "
+                  << size.x << "x" << size.y << ")" << std::endl;
+            return false;
+        }
+    }
+
+    if ((size.x > 1) || (size.y > 1))
+    {
+        err() << "Failed to load texture, the mipmap levels stop at " << size.x << "x" << size.y << " instead of 1x1" << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if ((getValidSize(image.getSize().x) != image.getSize().x) || (getValidSize(image.getSize().y) != image.getSize().y))
+    {
+        err() << "Failed to load texture, the graphics driver requires power of two sizes for mipmapped textures ("
+              << image.getSize().x << "x" << image.getSize().y << ")" << std::endl;
+        return false;
+    }
+
+    if (!loadFromImage(image))
+        return false;
+
+    uploadMipmap(mipmaps);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedFile(const std::string& filename)
+{
+    FileInputStream stream;
+    if (!stream.open(filename))
+    {
+        err() << "Failed to load compressed texture \"" << filename << "\", failed to open the file" << std::endl;
+        return false;
+    }
+
+    return loadFromCompressedStream(stream);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedMemory(const void* data, std::size_t size)
+{
+    priv::CompressedImage image;
+    return priv::loadCompressedImage(data, size, image) && loadFromCompressedImage(image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedStream(InputStream& stream)
+{
+    // Read the whole file, the levels are stored one after the other
+    Int64 size = stream.getSize();
+    if ((size <= 0) || (stream.seek(0) != 0))
+    {
+        err() << "Failed to load compressed texture from stream, the stream is empty" << std::endl;
+        return false;
+    }
+
+    std::vector<Uint8> data(static_cast<std::size_t>(size));
+    if (stream.read(&data[0], size) != size)
+    {
+        err() << "Failed to load compressed texture from stream, failed to read the data" << std::endl;
+        return false;
+    }
+
+    return loadFromCompressedMemory(&data[0], data.size());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedImage(const priv::CompressedImage& image)
+{
+    const Vector2u size = image.levels[0].size;
+
+    // The mipmap levels are only usable if they go down to 1x1
+    const bool        completeChain = (image.levels.back().size == Vector2u(1, 1));
+    const std::size_t levelCount    = completeChain ? image.levels.size() : 1;
+
+    // Note: isFormatSupported initializes the extensions that getValidSize needs
+    const bool supported = isFormatSupported(image.format);
+    const bool validSize = (getValidSize(size.x) == size.x) && (getValidSize(size.y) == size.y);
+
+    // Upload the blocks directly if the graphics driver supports them; they
+    // can't be padded, so the texture must have the size of the image
+    if (supported && validSize)
+    {
+        if (!create(size.x, size.y))
+            return false;
+
+        TransientContextLock lock;
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        GLenum internalFormat = getCompressedFormat(image.format, m_sRgb, image.opaque);
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        for (std::size_t i = 0; i < levelCount; ++i)
+        {
+            const priv::CompressedImage::Level& level = image.levels[i];
+            glCheck(GLEXT_glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), internalFormat, level.size.x, level.size.y, 0,
+                                                 static_cast<GLsizei>(level.byteCount), &image.data[level.offset]));
+        }
+
+        m_hasMipmap = (levelCount > 1);
+        m_format    = image.format;
+        if (m_hasMipmap)
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+
+        // Force an OpenGL flush, so that the texture will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+
+        return true;
+    }
+
+    // Otherwise decompress the levels and load them as a regular image
+    std::vector<Image> levels(levelCount);
+    for (std::size_t i = 0; i < levelCount; ++i)
+    {
+        const Vector2u levelSize = image.levels[i].size;
+        Uint8*         pixels    = new Uint8[static_cast<std::size_t>(levelSize.x) * levelSize.y * 4];
+
+        if (!priv::decompressLevel(image, i, pixels))
+        {
+            delete[] pixels;
+            err() << "Failed to load compressed texture, its format (" << image.format << ") is not supported by the graphics driver"
+                  << " and can't be decompressed" << std::endl;
+            return false;
+        }
+
+        levels[i].adoptPixels(levelSize.x, levelSize.y, pixels, &deletePixels);
+    }
+
+    if ((levelCount == 1) || !validSize)
+        return loadFromImage(levels[0]);
+
+    std::vector<Image> mipmaps(levels.begin() + 1, levels.end());
+    return loadFromImage(levels[0], mipmaps);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2u Texture::getSize() const
 {
@@ -317,6 +512,13 @@ Vector2u Texture::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+Texture::Format Texture::getFormat() const
+{
+    return m_format;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image Texture::copyToImage() const
 {
@@ -413,7 +615,7 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
     assert(x + width <= m_size.x);
     assert(y + height <= m_size.y);
 
-    if (pixels && m_texture)
+    if (pixels && m_texture && (m_format == Rgba8))
     {
         TransientContextLock lock;
 
@@ -435,6 +637,41 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::update(const Uint8* pixels, const IntRect* rects, std::size_t count)
+{
+    if (pixels && rects && (count > 0) && m_texture && (m_format == Rgba8))
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // Copy the pixels of each area, which are stored one after the other
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const IntRect& rect = rects[i];
+            assert((rect.left >= 0) && (rect.top >= 0));
+            assert(static_cast<unsigned int>(rect.left + rect.width) <= m_size.x);
+            assert(static_cast<unsigned int>(rect.top + rect.height) <= m_size.y);
+
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, rect.left, rect.top, rect.width, rect.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+            pixels += static_cast<std::size_t>(rect.width) * rect.height * 4;
+        }
+
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        m_hasMipmap = false;
+        m_pixelsFlipped = false;
+        m_cacheId = getUniqueId();
+
+        // Force an OpenGL flush, so that the texture data will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Texture& texture)
 {
@@ -449,7 +686,7 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
     assert(x + texture.m_size.x <= m_size.x);
     assert(y + texture.m_size.y <= m_size.y);
 
-    if (!m_texture || !texture.m_texture)
+    if (!m_texture || !texture.m_texture || (m_format != Rgba8))
         return;
 
 #ifndef SFML_OPENGL_ES
@@ -572,7 +809,15 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
     assert(x + window.getSize().x <= m_size.x);
     assert(y + window.getSize().y <= m_size.y);
 
-    if (m_texture && window.setActive(true))
+    if (!m_texture || (m_format != Rgba8))
+        return;
+
+    // Draw the geometry still pending in the batch of a render window, so that it is copied too
+    const RenderWindow* renderWindow = dynamic_cast<const RenderWindow*>(&window);
+    if (renderWindow)
+        const_cast<RenderWindow*>(renderWindow)->flush();
+
+    if (window.setActive(true))
     {
         TransientContextLock lock;
 
@@ -693,7 +938,8 @@ bool Texture::isRepeated() const
 ////////////////////////////////////////////////////////////
 bool Texture::generateMipmap()
 {
-    if (!m_texture)
+    // Compressed textures can't be rendered to, and come with their own levels
+    if (!m_texture || (m_format != Rgba8))
         return false;
 
     TransientContextLock lock;
@@ -702,7 +948,26 @@ bool Texture::generateMipmap()
     priv::ensureExtensionsInit();
 
     if (!GLEXT_framebuffer_object)
-        return false;
+    {
+        // Without glGenerateMipmap, compute the levels on the CPU; they
+        // must match the texture exactly, so it can't be padded
+        if (m_actualSize != m_size)
+            return false;
+
+        Image image = copyToImage();
+        if (image.getSize() != m_size)
+            return false;
+
+        // The levels must be stored in the same orientation as the base level
+        if (m_pixelsFlipped)
+            image.flipVertically();
+
+        std::vector<Image> levels;
+        image.generateMipChain(levels);
+        uploadMipmap(levels);
+
+        return true;
+    }
 
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
@@ -717,6 +982,30 @@ bool Texture::generateMipmap()
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::uploadMipmap(const std::vector<Image>& levels)
+{
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        Vector2u size = levels[i].getSize();
+        glCheck(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i + 1), (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA), size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, levels[i].getPixelsPtr()));
+    }
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+
+    m_hasMipmap = true;
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::invalidateMipmap()
 {
@@ -812,6 +1101,37 @@ unsigned int Texture::getMaximumSize()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::isFormatSupported(Format format)
+{
+    if (format == Rgba8)
+        return true;
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_texture_compression)
+        return false;
+
+    switch (format)
+    {
+        case Bc1:
+        case Bc2:
+        case Bc3:
+            return GLEXT_texture_compression_s3tc;
+
+        case Etc2Rgb:
+        case Etc2Rgba:
+            return GLEXT_texture_compression_etc2;
+
+        default:
+            return GLEXT_texture_compression_astc;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Texture& Texture::operator =(const Texture& right)
 {
@@ -835,6 +1155,7 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_format,        right.m_format);
 
     m_cacheId = getUniqueId();
     right.m_cacheId = getUniqueId();
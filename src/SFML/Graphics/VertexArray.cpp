@@ -34,6 +34,7 @@ namespace sf
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray() :
 m_vertices     (),
+m_indices      (),
 m_primitiveType(Points)
 {
 }
@@ -42,6 +43,7 @@ m_primitiveType(Points)
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray(PrimitiveType type, std::size_t vertexCount) :
 m_vertices     (vertexCount),
+m_indices      (),
 m_primitiveType(type)
 {
 }
@@ -72,6 +74,7 @@ const Vertex& VertexArray::operator [](std::size_t index) const
 void VertexArray::clear()
 {
     m_vertices.clear();
+    m_indices.clear();
 }
 
 
@@ -89,6 +92,48 @@ void VertexArray::append(const Vertex& vertex)
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t VertexArray::getIndexCount() const
+{
+    return m_indices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32* VertexArray::getIndices()
+{
+    return m_indices.empty() ? NULL : &m_indices[0];
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint32* VertexArray::getIndices() const
+{
+    return m_indices.empty() ? NULL : &m_indices[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::clearIndices()
+{
+    m_indices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::resizeIndices(std::size_t indexCount)
+{
+    m_indices.resize(indexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::appendIndex(Uint32 index)
+{
+    m_indices.push_back(index);
+}
+
+
 ////////////////////////////////////////////////////////////
 void VertexArray::setPrimitiveType(PrimitiveType type)
 {
@@ -143,8 +188,13 @@ FloatRect VertexArray::getBounds() const
 ////////////////////////////////////////////////////////////
 void VertexArray::draw(RenderTarget& target, RenderStates states) const
 {
-    if (!m_vertices.empty())
+    if (m_vertices.empty())
+        return;
+
+    if (m_indices.empty())
         target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
+    else
+        target.draw(&m_vertices[0], m_vertices.size(), &m_indices[0], m_indices.size(), m_primitiveType, states);
 }
 
 } // namespace sf
@@ -37,6 +37,18 @@
 namespace
 {
     sf::Mutex isAvailableMutex;
+    sf::Mutex idMutex;
+
+    // Thread-safe unique identifier generator, used to
+    // detect changes of the contents of the buffers
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(idMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no contents"
+
+        return id++;
+    }
 
     GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
     {
@@ -57,7 +69,8 @@ VertexBuffer::VertexBuffer() :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (Stream)
+m_usage        (Stream),
+m_cacheId      (0)
 {
 }
 
@@ -67,7 +80,8 @@ VertexBuffer::VertexBuffer(PrimitiveType type) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (Stream)
+m_usage        (Stream),
+m_cacheId      (0)
 {
 }
 
@@ -77,7 +91,8 @@ VertexBuffer::VertexBuffer(VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (usage)
+m_usage        (usage),
+m_cacheId      (0)
 {
 }
 
@@ -87,7 +102,8 @@ VertexBuffer::VertexBuffer(PrimitiveType type, VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (usage)
+m_usage        (usage),
+m_cacheId      (0)
 {
 }
 
@@ -97,7 +113,8 @@ VertexBuffer::VertexBuffer(const VertexBuffer& copy) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(copy.m_primitiveType),
-m_usage        (copy.m_usage)
+m_usage        (copy.m_usage),
+m_cacheId      (0)
 {
     if (copy.m_buffer && copy.m_size)
     {
@@ -147,6 +164,7 @@ bool VertexBuffer::create(std::size_t vertexCount)
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
     m_size = vertexCount;
+    m_cacheId = getUniqueId();
 
     return true;
 }
@@ -195,6 +213,8 @@ bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsig
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
+    m_cacheId = getUniqueId();
+
     return true;
 }
 
@@ -216,6 +236,8 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     // Make sure that extensions are initialized
     sf::priv::ensureExtensionsInit();
 
+    m_cacheId = getUniqueId();
+
     if (GLEXT_copy_buffer)
     {
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, vertexBuffer.m_buffer));
@@ -279,6 +301,7 @@ void VertexBuffer::swap(VertexBuffer& right)
     std::swap(m_buffer,        right.m_buffer);
     std::swap(m_primitiveType, right.m_primitiveType);
     std::swap(m_usage,         right.m_usage);
+    std::swap(m_cacheId,       right.m_cacheId);
 }
 
 
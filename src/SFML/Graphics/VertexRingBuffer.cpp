@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VertexRingBuffer.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+VertexRingBuffer::VertexRingBuffer() :
+m_buffer (0),
+m_offset (0),
+m_segment(0),
+m_useSync(false)
+{
+    for (std::size_t i = 0; i < SegmentCount; ++i)
+    {
+        m_fences[i] = NULL;
+        m_retired[i] = false;
+    }
+
+    // Make sure that extensions are initialized
+    ensureExtensionsInit();
+
+    if (!GLEXT_vertex_buffer_object)
+        return;
+
+    glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create streaming vertex buffer, generation failed" << std::endl;
+        return;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * SegmentCount * SegmentSize, 0, GLEXT_GL_STREAM_DRAW));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    m_useSync = GLEXT_sync;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexRingBuffer::~VertexRingBuffer()
+{
+    if (m_buffer)
+    {
+        TransientContextLock contextLock;
+
+#ifndef SFML_OPENGL_ES
+
+        for (std::size_t i = 0; i < SegmentCount; ++i)
+        {
+            if (m_fences[i])
+                glCheck(GLEXT_glDeleteSync(static_cast<GLsync>(m_fences[i])));
+        }
+
+#endif // SFML_OPENGL_ES
+
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexRingBuffer::push(const Vertex* vertices, std::size_t vertexCount, std::size_t& firstVertex)
+{
+    // Vertex arrays larger than a segment are left to the caller
+    if (!m_buffer || !vertexCount || (vertexCount > SegmentSize))
+        return false;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    // Wrap around if the vertices don't fit in the remaining space
+    if (m_offset + vertexCount > SegmentCount * SegmentSize)
+    {
+        m_offset = 0;
+
+        // Without fences, orphan the storage so that the driver
+        // can hand us fresh memory while the old one is still in use
+        if (!m_useSync)
+            glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * SegmentCount * SegmentSize, 0, GLEXT_GL_STREAM_DRAW));
+    }
+
+    // Enter every segment touched by the new vertices
+    std::size_t first = m_offset / SegmentSize;
+    std::size_t last = (m_offset + vertexCount - 1) / SegmentSize;
+
+    for (std::size_t segment = first; segment <= last; ++segment)
+    {
+        if (segment != m_segment)
+            enterSegment(segment);
+    }
+
+    GLintptr offset = static_cast<GLintptr>(m_offset * sizeof(Vertex));
+    GLsizeiptr size = static_cast<GLsizeiptr>(vertexCount * sizeof(Vertex));
+    bool written = false;
+
+#ifndef SFML_OPENGL_ES
+
+    // The range is known to be unused by the GPU (either fenced or
+    // freshly orphaned), so we can map it without synchronization
+    if (GLEXT_map_buffer_range)
+    {
+        void* destination = 0;
+        glCheck(destination = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, offset, size, GLEXT_GL_MAP_WRITE_BIT |
+                                                                                          GLEXT_GL_MAP_INVALIDATE_RANGE_BIT |
+                                                                                          GLEXT_GL_MAP_UNSYNCHRONIZED_BIT));
+
+        if (destination)
+        {
+            std::memcpy(destination, vertices, static_cast<std::size_t>(size));
+
+            GLboolean result = GL_FALSE;
+            glCheck(result = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+
+            written = (result == GL_TRUE);
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    if (!written)
+        glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, offset, size, vertices));
+
+    firstVertex = m_offset;
+    m_offset += vertexCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexRingBuffer::fence()
+{
+#ifndef SFML_OPENGL_ES
+
+    for (std::size_t i = 0; i < SegmentCount; ++i)
+    {
+        if (!m_retired[i])
+            continue;
+
+        // Mark the end of the commands reading the segment we have left
+        if (m_fences[i])
+            glCheck(GLEXT_glDeleteSync(static_cast<GLsync>(m_fences[i])));
+
+        GLsync fence = 0;
+        glCheck(fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        m_fences[i] = fence;
+        m_retired[i] = false;
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VertexRingBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexRingBuffer::enterSegment(std::size_t segment)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_useSync)
+    {
+        // The segment we are leaving may still be read by the draw of the
+        // vertices being pushed, it is fenced once that draw is issued
+        m_retired[m_segment] = true;
+
+        // Wait until the GPU is done with the segment we are entering
+        if (m_fences[segment])
+        {
+            GLsync previous = static_cast<GLsync>(m_fences[segment]);
+            GLenum status = GLEXT_GL_TIMEOUT_EXPIRED;
+
+            while (status == GLEXT_GL_TIMEOUT_EXPIRED)
+                glCheck(status = GLEXT_glClientWaitSync(previous, GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000));
+
+            if (status == GLEXT_GL_WAIT_FAILED)
+                err() << "Failed to wait for streaming vertex buffer segment" << std::endl;
+
+            glCheck(GLEXT_glDeleteSync(previous));
+            m_fences[segment] = NULL;
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    m_segment = segment;
+}
+
+} // namespace priv
+
+} // namespace sf
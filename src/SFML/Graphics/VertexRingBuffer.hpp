@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VERTEXRINGBUFFER_HPP
+#define SFML_VERTEXRINGBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class Vertex;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Streaming vertex buffer used for immediate-mode draws
+///
+/// The buffer is written sequentially and wraps around when
+/// its end is reached. It is split into a few segments; when
+/// sync objects are available, a fence is inserted after the
+/// last draw reading a segment that was left, and waited for
+/// before the segment is written again. Otherwise the whole
+/// storage is orphaned on wrap-around, and the driver takes
+/// care of the rest.
+///
+////////////////////////////////////////////////////////////
+class VertexRingBuffer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Must be called with an active OpenGL context.
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexRingBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VertexRingBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append vertices to the buffer
+    ///
+    /// On success, the buffer is left bound to GL_ARRAY_BUFFER
+    /// so that attribute pointers can be set up right away.
+    /// Vertex arrays that are too big to be streamed are
+    /// rejected, the caller must then fall back to client arrays.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param firstVertex Receives the index of the first vertex written
+    ///
+    /// \return True if the vertices were written to the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const Vertex* vertices, std::size_t vertexCount, std::size_t& firstVertex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fence the segments that are no longer written
+    ///
+    /// Must be called after the draw that reads the vertices
+    /// of the last call to push, so that the fences cover
+    /// every command sourcing the segments that were left.
+    ///
+    ////////////////////////////////////////////////////////////
+    void fence();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenGL handle of the buffer
+    ///
+    /// \return OpenGL handle of the buffer, or 0 if not created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start writing to another segment of the buffer
+    ///
+    /// \param segment Index of the segment to write to
+    ///
+    ////////////////////////////////////////////////////////////
+    void enterSegment(std::size_t segment);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        SegmentCount = 4,    ///< Number of fenced regions in the buffer
+        SegmentSize  = 65536 ///< Number of vertices in a single segment
+    };
+
+    unsigned int m_buffer;                ///< Internal buffer identifier
+    std::size_t  m_offset;                ///< Index of the next vertex to write
+    std::size_t  m_segment;               ///< Index of the segment currently written
+    bool         m_useSync;               ///< Use fences rather than orphaning?
+    void*        m_fences[SegmentCount];  ///< Sync object guarding each segment (GLsync)
+    bool         m_retired[SegmentCount]; ///< Segments left but not fenced yet
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXRINGBUFFER_HPP
@@ -87,6 +87,13 @@ Uint64 Context::getActiveContextId()
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 Context::getActivationId()
+{
+    return priv::GlContext::getActivationId();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Context::isExtensionAvailable(const char* name)
 {
@@ -150,6 +150,9 @@ namespace
     // Unique identifier, used for identifying contexts when managing unshareable OpenGL resources
     sf::Uint64 id = 1; // start at 1, zero is "no context"
 
+    // Unique identifier, used for detecting when a context has been released and activated again
+    sf::Uint64 activationId = 1; // start at 1, zero is "no context"
+
     // Set containing callback functions to be called whenever a
     // context is going to be destroyed
     // Unshareable OpenGL resources rely on this to clean up properly
@@ -538,6 +541,13 @@ Uint64 GlContext::getActiveContextId()
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 GlContext::getActivationId()
+{
+    return currentContext ? currentContext->m_activationId : 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::~GlContext()
 {
@@ -571,6 +581,7 @@ bool GlContext::setActive(bool active)
             {
                 // Set it as the new current context for this thread
                 currentContext = this;
+                m_activationId = activationId++;
                 return true;
             }
             else
@@ -612,7 +623,8 @@ bool GlContext::setActive(bool active)
 
 ////////////////////////////////////////////////////////////
 GlContext::GlContext() :
-m_id(id++)
+m_id          (id++),
+m_activationId(0)
 {
     // Nothing to do
 }
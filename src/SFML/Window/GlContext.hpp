@@ -168,6 +168,14 @@ public:
     ////////////////////////////////////////////////////////////
     static Uint64 getActiveContextId();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of the current activation of the active context
+    ///
+    /// \return The activation number or 0 if no context is currently active
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActivationId();
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -294,7 +302,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Uint64 m_id; ///< Unique number that identifies the context
+    const Uint64 m_id;           ///< Unique number that identifies the context
+    Uint64       m_activationId; ///< Unique number that identifies the last activation of the context
 };
 
 } // namespace priv
@@ -0,0 +1,99 @@
+#include <SFML/Graphics/AssetLoader.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Path of a file in the temporary directory of the system
+    std::string getTempPath(const std::string& name)
+    {
+        const char* variables[] = {"TMPDIR", "TEMP", "TMP"};
+        for (std::size_t i = 0; i < sizeof(variables) / sizeof(*variables); ++i)
+        {
+            const char* directory = std::getenv(variables[i]);
+            if (directory && *directory)
+                return std::string(directory) + "/" + name;
+        }
+
+        return "/tmp/" + name;
+    }
+
+    // Files removed when the test ends, even if it fails
+    struct TempFiles
+    {
+        ~TempFiles()
+        {
+            for (std::size_t i = 0; i < paths.size(); ++i)
+                std::remove(paths[i].c_str());
+        }
+
+        std::vector<std::string> paths;
+    };
+}
+
+TEST_CASE("sf::AssetLoader class", "[graphics]")
+{
+    // Write a few small images to decode; only images are loaded, so that no OpenGL context is needed
+    TempFiles temp;
+    std::vector<std::string>& files = temp.paths;
+    for (int i = 0; i < 6; ++i)
+    {
+        std::ostringstream name;
+        name << "sfml-asset-loader-test-" << i << ".png";
+
+        sf::Image image;
+        image.create(8 + i, 4, sf::Color(static_cast<sf::Uint8>(i * 10), 20, 30));
+        files.push_back(getTempPath(name.str()));
+        REQUIRE(image.saveToFile(files.back()));
+    }
+
+    SECTION("Load images in parallel")
+    {
+        sf::AssetLoader loader(3);
+
+        std::vector<std::size_t> assets;
+        for (std::size_t i = 0; i < files.size(); ++i)
+            assets.push_back(loader.loadImage(files[i]));
+
+        std::size_t missing = loader.loadImage(getTempPath("sfml-asset-loader-test-missing.png"));
+
+        loader.wait();
+        CHECK(loader.getPendingCount() == 0);
+        CHECK(loader.uploadTextures(sf::Time::Zero));
+
+        for (std::size_t i = 0; i < assets.size(); ++i)
+        {
+            REQUIRE(loader.getStatus(assets[i]) == sf::AssetLoader::Ready);
+            CHECK(loader.getImage(assets[i]).getSize() == sf::Vector2u(8 + static_cast<unsigned int>(i), 4));
+            CHECK(loader.getImage(assets[i]).getPixel(1, 1) == sf::Color(static_cast<sf::Uint8>(i * 10), 20, 30));
+        }
+
+        CHECK(loader.getStatus(missing) == sf::AssetLoader::Failed);
+        CHECK(loader.getImage(missing).getSize() == sf::Vector2u(0, 0));
+    }
+
+    SECTION("Load more files once the workers are idle")
+    {
+        sf::AssetLoader loader(2);
+
+        std::size_t first = loader.loadImage(files[0]);
+        loader.wait();
+        CHECK(loader.getStatus(first) == sf::AssetLoader::Ready);
+
+        std::size_t second = loader.loadImage(files[1]);
+        loader.wait();
+        CHECK(loader.getStatus(second) == sf::AssetLoader::Ready);
+    }
+
+    SECTION("Destruction with pending files")
+    {
+        sf::AssetLoader loader(1);
+        for (std::size_t i = 0; i < files.size(); ++i)
+            loader.loadImage(files[i]);
+    }
+}
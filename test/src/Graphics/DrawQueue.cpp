@@ -0,0 +1,183 @@
+#include <SFML/Graphics/DrawQueue.hpp>
+#include <SFML/Graphics/InstanceBuffer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    // Render target that stores the first vertex of each draw call instead of drawing it
+    class CaptureTarget : public sf::RenderTarget
+    {
+    public:
+
+        CaptureTarget()
+        {
+            initialize();
+        }
+
+        virtual sf::Vector2u getSize() const
+        {
+            return sf::Vector2u(0, 0);
+        }
+
+        virtual bool setActive(bool)
+        {
+            return false;
+        }
+
+        std::vector<sf::Vertex> vertices;
+        std::vector<sf::BlendMode> blendModes;
+        std::vector<const sf::InstanceBuffer*> instanceBuffers;
+
+    protected:
+
+        virtual bool interceptDraw(const sf::Vertex* vertices, std::size_t, sf::PrimitiveType, const sf::RenderStates& states)
+        {
+            this->vertices.push_back(vertices[0]);
+            blendModes.push_back(states.blendMode);
+            return true;
+        }
+
+        virtual bool interceptDraw(const sf::VertexBuffer&, const sf::InstanceBuffer& instanceBuffer, const sf::RenderStates& states)
+        {
+            instanceBuffers.push_back(&instanceBuffer);
+            blendModes.push_back(states.blendMode);
+            return true;
+        }
+    };
+
+    // Drawable made of instances of a vertex buffer
+    struct Instances : sf::Drawable
+    {
+        sf::VertexBuffer   vertexBuffer;
+        sf::InstanceBuffer instanceBuffer;
+
+        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const
+        {
+            target.drawInstanced(vertexBuffer, instanceBuffer, states);
+        }
+    };
+
+    sf::Vertex makeVertex(float x)
+    {
+        return sf::Vertex(sf::Vector2f(x, 0));
+    }
+}
+
+TEST_CASE("sf::DrawQueue class", "[graphics]")
+{
+    SECTION("Construction")
+    {
+        sf::DrawQueue queue;
+        CHECK(queue.getLayer() == 0);
+        CHECK(queue.getDrawCount() == 0);
+    }
+
+    SECTION("Layers are replayed from lowest to highest")
+    {
+        sf::DrawQueue queue;
+        sf::Vertex vertex;
+
+        queue.setLayer(2);
+        vertex = makeVertex(2);
+        queue.draw(&vertex, 1, sf::Points);
+        queue.setLayer(-1);
+        vertex = makeVertex(-1);
+        queue.draw(&vertex, 1, sf::Points);
+        queue.setLayer(0);
+        vertex = makeVertex(0);
+        queue.draw(&vertex, 1, sf::Points);
+
+        CaptureTarget target;
+        queue.replay(target);
+
+        REQUIRE(target.vertices.size() == 3);
+        CHECK(target.vertices[0].position.x == -1);
+        CHECK(target.vertices[1].position.x == 0);
+        CHECK(target.vertices[2].position.x == 2);
+    }
+
+    SECTION("Draw calls are grouped by state within a layer")
+    {
+        sf::DrawQueue queue;
+        sf::Vertex vertex;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            vertex = makeVertex(static_cast<float>(i));
+            queue.draw(&vertex, 1, sf::Points, (i % 2) ? sf::BlendAdd : sf::BlendAlpha);
+        }
+
+        CaptureTarget target;
+        queue.replay(target);
+
+        // Recording order is kept among draw calls with the same states
+        REQUIRE(target.vertices.size() == 4);
+        CHECK(target.vertices[0].position.x == 0);
+        CHECK(target.vertices[1].position.x == 2);
+        CHECK(target.vertices[2].position.x == 1);
+        CHECK(target.vertices[3].position.x == 3);
+        CHECK(target.blendModes[0] == sf::BlendAlpha);
+        CHECK(target.blendModes[3] == sf::BlendAdd);
+    }
+
+    SECTION("Drawables are captured when recorded")
+    {
+        sf::DrawQueue queue;
+        sf::VertexArray array(sf::Points, 1);
+        array[0] = makeVertex(5);
+
+        queue.draw(array);
+        array[0] = makeVertex(6);
+
+        CaptureTarget target;
+        queue.replay(target);
+
+        REQUIRE(target.vertices.size() == 1);
+        CHECK(target.vertices[0].position.x == 5);
+    }
+
+    SECTION("Instanced draws are recorded")
+    {
+        sf::DrawQueue queue;
+        Instances instances;
+        instances.instanceBuffer.resize(3);
+        sf::Vertex vertex = makeVertex(1);
+
+        queue.setLayer(1);
+        queue.draw(instances, sf::BlendAdd);
+        queue.setLayer(0);
+        queue.draw(&vertex, 1, sf::Points);
+        CHECK(queue.getDrawCount() == 2);
+
+        CaptureTarget target;
+        queue.replay(target);
+
+        REQUIRE(target.vertices.size() == 1);
+        REQUIRE(target.instanceBuffers.size() == 1);
+        CHECK(target.instanceBuffers[0] == &instances.instanceBuffer);
+        REQUIRE(target.blendModes.size() == 2);
+        CHECK(target.blendModes[1] == sf::BlendAdd);
+    }
+
+    SECTION("Clear")
+    {
+        sf::DrawQueue queue;
+        sf::Vertex vertex;
+
+        queue.setLayer(3);
+        queue.draw(&vertex, 1, sf::Points);
+        CHECK(queue.getDrawCount() == 1);
+
+        queue.clear();
+        CHECK(queue.getDrawCount() == 0);
+        CHECK(queue.getLayer() == 0);
+
+        CaptureTarget target;
+        queue.replay(target);
+        CHECK(target.vertices.empty());
+    }
+}
@@ -0,0 +1,478 @@
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include "GraphicsUtil.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    int deletedCount = 0;
+
+    void countDeletion(sf::Uint8* pixels)
+    {
+        delete[] pixels;
+        ++deletedCount;
+    }
+
+    // 2x1 uncompressed true color TGA, top-left origin, pixels stored as BGRA
+    const sf::Uint8 tgaFile[] =
+    {
+        0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 1, 0, 32, 0x28,
+        30, 20, 10, 255,
+        60, 50, 40, 128
+    };
+
+    // Append a little endian 32-bit value
+    void append32(std::vector<sf::Uint8>& data, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            data.push_back(static_cast<sf::Uint8>(value >> (i * 8)));
+    }
+
+    // DDS file holding a single level of blocks, in a format identified by its FourCC code
+    std::vector<sf::Uint8> ddsFile(const char* fourCC, sf::Uint32 width, sf::Uint32 height, const sf::Uint8* blocks, std::size_t size)
+    {
+        std::vector<sf::Uint8> data;
+        append32(data, 0x20534444); // "DDS "
+        append32(data, 124);        // header size
+        append32(data, 0x1007);     // flags
+        append32(data, height);
+        append32(data, width);
+        data.resize(84, 0);
+        data.insert(data.end(), fourCC, fourCC + 4);
+        data.resize(128, 0);
+        data.insert(data.end(), blocks, blocks + size);
+        return data;
+    }
+
+    // KTX file holding a single level of blocks, in a format identified by its OpenGL internal format
+    std::vector<sf::Uint8> ktxFile(sf::Uint32 internalFormat, sf::Uint32 width, sf::Uint32 height, const sf::Uint8* blocks, std::size_t size)
+    {
+        const sf::Uint8 identifier[] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+        const sf::Uint32 header[] = {0x04030201, 0, 1, 0, internalFormat, 0x1908, width, height, 0, 0, 1, 1, 0};
+
+        std::vector<sf::Uint8> data(identifier, identifier + sizeof(identifier));
+        for (std::size_t i = 0; i < sizeof(header) / sizeof(header[0]); ++i)
+            append32(data, header[i]);
+        append32(data, static_cast<sf::Uint32>(size));
+        data.insert(data.end(), blocks, blocks + size);
+        return data;
+    }
+
+    // Image whose pixels cover every pair of color component and alpha values
+    sf::Image allAlphas()
+    {
+        sf::Image image;
+        image.create(256, 256);
+        for (unsigned int x = 0; x < 256; ++x)
+            for (unsigned int y = 0; y < 256; ++y)
+                image.setPixel(x, y, sf::Color(x, 255 - x, (x * 7 + y) & 0xFF, y));
+        return image;
+    }
+
+    // Image of an odd size filled with arbitrary pixels
+    sf::Image noise(unsigned int width, unsigned int height, unsigned int seed)
+    {
+        sf::Image image;
+        image.create(width, height);
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                image.setPixel(x, y, sf::Color(seed >> 24, seed >> 16, seed >> 8, (x + y * width) & 0xFF));
+            }
+        }
+        return image;
+    }
+}
+
+TEST_CASE("sf::Image class", "[graphics]")
+{
+    SECTION("Construction")
+    {
+        sf::Image image;
+        CHECK(image.getSize() == sf::Vector2u(0, 0));
+    }
+
+    SECTION("Create with a color")
+    {
+        sf::Image image;
+        image.create(3, 2, sf::Color(1, 2, 3, 4));
+        CHECK(image.getSize() == sf::Vector2u(3, 2));
+        CHECK(image.getPixel(2, 1) == sf::Color(1, 2, 3, 4));
+
+        image.create(0, 2, sf::Color::Red);
+        CHECK(image.getSize() == sf::Vector2u(0, 0));
+    }
+
+    SECTION("Adopt pixels")
+    {
+        deletedCount = 0;
+
+        sf::Uint8* pixels = new sf::Uint8[2 * 2 * 4]();
+        pixels[4] = 200;
+
+        {
+            sf::Image image;
+            image.adoptPixels(2, 2, pixels, &countDeletion);
+            CHECK(image.getSize() == sf::Vector2u(2, 2));
+            CHECK(image.getPixelsPtr() == pixels);
+            CHECK(image.getPixel(1, 0).r == 200);
+
+            // Changes are made in place
+            image.setPixel(0, 1, sf::Color::Green);
+            CHECK(pixels[9] == 255);
+
+            // Copies own their pixels
+            sf::Image copy(image);
+            CHECK(copy.getPixelsPtr() != pixels);
+            CHECK(copy.getPixel(0, 1) == sf::Color::Green);
+
+            CHECK(deletedCount == 0);
+        }
+
+        CHECK(deletedCount == 1);
+    }
+
+    SECTION("Adopt pixels without ownership")
+    {
+        deletedCount = 0;
+
+        sf::Uint8 pixels[4] = {1, 2, 3, 4};
+        sf::Image image;
+        image.adoptPixels(1, 1, pixels, NULL);
+        CHECK(image.getPixel(0, 0) == sf::Color(1, 2, 3, 4));
+
+        // Recreating the image releases adopted pixels
+        sf::Uint8* owned = new sf::Uint8[4]();
+        image.adoptPixels(1, 1, owned, &countDeletion);
+        image.create(1, 1, sf::Color::Black);
+        CHECK(deletedCount == 1);
+
+        // Empty images release them immediately
+        image.adoptPixels(0, 0, new sf::Uint8[4], &countDeletion);
+        CHECK(deletedCount == 2);
+        CHECK(image.getSize() == sf::Vector2u(0, 0));
+    }
+
+    SECTION("Load from memory")
+    {
+        sf::Image image;
+        REQUIRE(image.loadFromMemory(tgaFile, sizeof(tgaFile)));
+        CHECK(image.getSize() == sf::Vector2u(2, 1));
+        CHECK(image.getPixel(0, 0) == sf::Color(10, 20, 30, 255));
+        CHECK(image.getPixel(1, 0) == sf::Color(40, 50, 60, 128));
+
+        // Failing to load leaves the image unchanged
+        const sf::Uint8 garbage[] = {1, 2, 3};
+        CHECK(!image.loadFromMemory(garbage, sizeof(garbage)));
+        CHECK(image.getSize() == sf::Vector2u(2, 1));
+        CHECK(image.getPixel(1, 0) == sf::Color(40, 50, 60, 128));
+    }
+
+    SECTION("Load compressed from memory")
+    {
+        sf::Image image;
+
+        // BC1: the first block interpolates between red and blue, the second one
+        // uses the transparent color, and the columns beyond the width are dropped
+        const sf::Uint8 bc1[] = {0x00, 0xF8, 0x1F, 0x00, 0x24, 0x00, 0x00, 0x00,
+                                 0x1F, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF};
+        std::vector<sf::Uint8> file = ddsFile("DXT1", 5, 3, bc1, sizeof(bc1));
+        REQUIRE(image.loadFromMemory(&file[0], file.size()));
+        CHECK(image.getSize() == sf::Vector2u(5, 3));
+        CHECK(image.getPixel(0, 0) == sf::Color(255, 0, 0));
+        CHECK(image.getPixel(1, 0) == sf::Color(0, 0, 255));
+        CHECK(image.getPixel(2, 0) == sf::Color(170, 0, 85));
+        CHECK(image.getPixel(3, 2) == sf::Color(255, 0, 0));
+        CHECK(image.getPixel(4, 0) == sf::Color(0, 0, 0, 0));
+
+        // BC1 without alpha (GL_COMPRESSED_RGB_S3TC_DXT1_EXT): the transparent color is opaque black
+        file = ktxFile(0x83F0, 5, 3, bc1, sizeof(bc1));
+        REQUIRE(image.loadFromMemory(&file[0], file.size()));
+        CHECK(image.getPixel(2, 0) == sf::Color(170, 0, 85));
+        CHECK(image.getPixel(4, 0) == sf::Color(0, 0, 0, 255));
+
+        // BC3: interpolated alpha, on white
+        const sf::Uint8 bc3[] = {0xFF, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00};
+        file = ddsFile("DXT5", 4, 4, bc3, sizeof(bc3));
+        REQUIRE(image.loadFromMemory(&file[0], file.size()));
+        CHECK(image.getPixel(0, 0) == sf::Color(255, 255, 255, 0));
+        CHECK(image.getPixel(1, 0) == sf::Color(255, 255, 255, 218));
+        CHECK(image.getPixel(2, 0) == sf::Color(255, 255, 255, 255));
+
+        // ETC2 individual mode: a red left half and a black right half, plus the modifier
+        const sf::Uint8 etcIndividual[] = {0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+        file = ktxFile(0x9274, 4, 4, etcIndividual, sizeof(etcIndividual));
+        REQUIRE(image.loadFromMemory(&file[0], file.size()));
+        CHECK(image.getPixel(0, 3) == sf::Color(255, 2, 2));
+        CHECK(image.getPixel(3, 0) == sf::Color(2, 2, 2));
+
+        // ETC2 planar mode: blue fading towards the bottom-right corner
+        const sf::Uint8 etcPlanar[] = {0x00, 0x00, 0xF9, 0x02, 0x00, 0x00, 0x00, 0x00};
+        file = ktxFile(0x9274, 4, 4, etcPlanar, sizeof(etcPlanar));
+        REQUIRE(image.loadFromMemory(&file[0], file.size()));
+        CHECK(image.getPixel(0, 0) == sf::Color(0, 0, 105));
+        CHECK(image.getPixel(1, 0) == sf::Color(0, 0, 79));
+        CHECK(image.getPixel(0, 2) == sf::Color(0, 0, 53));
+        CHECK(image.getPixel(3, 3) == sf::Color(0, 0, 0));
+
+        // ETC2 with EAC alpha: the first pixel uses the largest modifier of the table
+        const sf::Uint8 etcAlpha[] = {0x80, 0x10, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                      0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+        file = ktxFile(0x9278, 4, 4, etcAlpha, sizeof(etcAlpha));
+        REQUIRE(image.loadFromMemory(&file[0], file.size()));
+        CHECK(image.getPixel(0, 0) == sf::Color(255, 2, 2, 142));
+        CHECK(image.getPixel(1, 0) == sf::Color(255, 2, 2, 125));
+
+        // ASTC can't be decompressed, and truncated files are rejected
+        const sf::Uint8 astc[16] = {0};
+        file = ktxFile(0x93B0, 4, 4, astc, sizeof(astc));
+        CHECK(!image.loadFromMemory(&file[0], file.size()));
+        file = ddsFile("DXT1", 8, 4, bc1, sizeof(bc1) - 1);
+        CHECK(!image.loadFromMemory(&file[0], file.size()));
+        file = ktxFile(0x83F1, 4, 4, bc1, 8);
+        file[60] = file[61] = file[62] = file[63] = 0xFF; // key/value data larger than the file
+        CHECK(!image.loadFromMemory(&file[0], file.size()));
+        CHECK(image.getSize() == sf::Vector2u(4, 4));
+        CHECK(image.getPixel(0, 0) == sf::Color(255, 2, 2, 142));
+    }
+
+    SECTION("Copy with alpha")
+    {
+        const sf::Image source = noise(19, 17, 1);
+        const sf::Image background = noise(23, 19, 2);
+
+        sf::Image image = background;
+        image.copy(source, 3, 1, sf::IntRect(), true);
+
+        bool exact = true;
+        for (unsigned int y = 0; y < 17; ++y)
+        {
+            for (unsigned int x = 0; x < 19; ++x)
+            {
+                sf::Color src = source.getPixel(x, y);
+                sf::Color dst = background.getPixel(x + 3, y + 1);
+                unsigned int a = src.a;
+                sf::Color expected((src.r * a + dst.r * (255 - a)) / 255,
+                                   (src.g * a + dst.g * (255 - a)) / 255,
+                                   (src.b * a + dst.b * (255 - a)) / 255,
+                                   a + dst.a * (255 - a) / 255);
+                exact = exact && (image.getPixel(x + 3, y + 1) == expected);
+            }
+        }
+        CHECK(exact);
+        CHECK(image.getPixel(0, 0) == background.getPixel(0, 0));
+    }
+
+    SECTION("Mask from color")
+    {
+        sf::Image image = noise(7, 5, 3);
+        image.setPixel(0, 0, sf::Color(10, 20, 30, 40));
+        image.setPixel(5, 2, sf::Color(10, 20, 30, 40));
+        image.setPixel(6, 4, sf::Color(10, 20, 30, 40));
+        image.setPixel(3, 3, sf::Color(10, 20, 30, 41));
+
+        const sf::Image original = image;
+        image.createMaskFromColor(sf::Color(10, 20, 30, 40), 7);
+
+        bool exact = true;
+        for (unsigned int y = 0; y < 5; ++y)
+        {
+            for (unsigned int x = 0; x < 7; ++x)
+            {
+                sf::Color expected = original.getPixel(x, y);
+                if (expected == sf::Color(10, 20, 30, 40))
+                    expected.a = 7;
+                exact = exact && (image.getPixel(x, y) == expected);
+            }
+        }
+        CHECK(exact);
+        CHECK(image.getPixel(5, 2) == sf::Color(10, 20, 30, 7));
+        CHECK(image.getPixel(3, 3) == sf::Color(10, 20, 30, 41));
+    }
+
+    SECTION("Flip")
+    {
+        for (unsigned int width = 1; width <= 13; ++width)
+        {
+            const sf::Image original = noise(width, 3, width);
+
+            sf::Image horizontal = original;
+            horizontal.flipHorizontally();
+            sf::Image vertical = original;
+            vertical.flipVertically();
+
+            bool exact = true;
+            for (unsigned int y = 0; y < 3; ++y)
+            {
+                for (unsigned int x = 0; x < width; ++x)
+                {
+                    exact = exact && (horizontal.getPixel(x, y) == original.getPixel(width - 1 - x, y));
+                    exact = exact && (vertical.getPixel(x, y) == original.getPixel(x, 2 - y));
+                }
+            }
+            CHECK(exact);
+        }
+    }
+
+    SECTION("Create with a color of odd size")
+    {
+        sf::Image image;
+        image.create(7, 3, sf::Color(1, 2, 3, 4));
+
+        bool exact = true;
+        for (unsigned int y = 0; y < 3; ++y)
+            for (unsigned int x = 0; x < 7; ++x)
+                exact = exact && (image.getPixel(x, y) == sf::Color(1, 2, 3, 4));
+        CHECK(exact);
+    }
+
+    SECTION("Premultiply and unpremultiply alpha")
+    {
+        const sf::Image original = allAlphas();
+
+        sf::Image premultiplied = original;
+        premultiplied.premultiplyAlpha();
+
+        sf::Image unpremultiplied = premultiplied;
+        unpremultiplied.unpremultiplyAlpha();
+
+        // Source pixels, themselves not premultiplied, exercise the clamping
+        sf::Image clamped = original;
+        clamped.unpremultiplyAlpha();
+
+        bool premultiplyExact = true;
+        bool unpremultiplyExact = true;
+        bool clampedExact = true;
+        for (unsigned int y = 0; y < 256; ++y)
+        {
+            for (unsigned int x = 0; x < 256; ++x)
+            {
+                sf::Color color = original.getPixel(x, y);
+                sf::Uint8* components[] = {&color.r, &color.g, &color.b};
+                unsigned int a = color.a;
+
+                sf::Color source = color;
+                for (int i = 0; i < 3; ++i)
+                    *components[i] = static_cast<sf::Uint8>((*components[i] * a + 127) / 255);
+                premultiplyExact = premultiplyExact && (premultiplied.getPixel(x, y) == color);
+
+                for (int i = 0; i < 3; ++i)
+                    *components[i] = a ? static_cast<sf::Uint8>(std::min((*components[i] * 255 + a / 2) / a, 255u)) : 0;
+                unpremultiplyExact = unpremultiplyExact && (unpremultiplied.getPixel(x, y) == color);
+
+                color = source;
+                for (int i = 0; i < 3; ++i)
+                    *components[i] = a ? static_cast<sf::Uint8>(std::min((*components[i] * 255 + a / 2) / a, 255u)) : 0;
+                clampedExact = clampedExact && (clamped.getPixel(x, y) == color);
+            }
+        }
+        CHECK(premultiplyExact);
+        CHECK(unpremultiplyExact);
+        CHECK(clampedExact);
+
+        // Opaque pixels survive the round trip
+        CHECK(unpremultiplied.getPixel(12, 255) == original.getPixel(12, 255));
+        CHECK(unpremultiplied.getPixel(12, 0) == sf::Color(0, 0, 0, 0));
+    }
+
+    SECTION("Resize")
+    {
+        const sf::Image::ResamplingFilter filters[] = {sf::Image::Box, sf::Image::Bilinear, sf::Image::Lanczos};
+        for (int i = 0; i < 3; ++i)
+        {
+            // A uniform image stays uniform, whatever the filter and the scale
+            sf::Image image;
+            image.create(7, 5, sf::Color(200, 100, 50, 150));
+            image.resize(3, 2, filters[i]);
+            CHECK(image.getSize() == sf::Vector2u(3, 2));
+            CHECK(image.getPixel(0, 0) == sf::Color(200, 100, 50, 150));
+            CHECK(image.getPixel(2, 1) == sf::Color(200, 100, 50, 150));
+
+            image.resize(20, 13, filters[i]);
+            CHECK(image.getSize() == sf::Vector2u(20, 13));
+            CHECK(image.getPixel(0, 0) == sf::Color(200, 100, 50, 150));
+            CHECK(image.getPixel(19, 12) == sf::Color(200, 100, 50, 150));
+
+            // Transparent pixels don't bleed their color
+            image.create(8, 8, sf::Color(0, 255, 0, 0));
+            for (unsigned int y = 0; y < 8; ++y)
+                for (unsigned int x = 0; x < 4; ++x)
+                    image.setPixel(x, y, sf::Color(255, 0, 0, 255));
+            image.resize(3, 3, filters[i]);
+            CHECK(image.getPixel(1, 1).r == 255);
+            CHECK(image.getPixel(1, 1).g == 0);
+            CHECK(image.getPixel(0, 0) == sf::Color(255, 0, 0, 255));
+        }
+
+        // Shrinking by two with a box filter averages blocks of 2x2 pixels
+        sf::Image image;
+        image.create(4, 2, sf::Color::Black);
+        image.setPixel(0, 0, sf::Color(100, 0, 0));
+        image.setPixel(1, 1, sf::Color(0, 200, 0));
+        image.setPixel(3, 0, sf::Color(0, 0, 40));
+        image.resize(2, 1, sf::Image::Box);
+        CHECK(image.getPixel(0, 0) == sf::Color(25, 50, 0));
+        CHECK(image.getPixel(1, 0) == sf::Color(0, 0, 10));
+
+        // Enlarging with a box filter repeats the pixels
+        image.resize(6, 2, sf::Image::Box);
+        CHECK(image.getPixel(2, 1) == sf::Color(25, 50, 0));
+        CHECK(image.getPixel(3, 0) == sf::Color(0, 0, 10));
+
+        image.resize(0, 3);
+        CHECK(image.getSize() == sf::Vector2u(0, 0));
+        image.resize(3, 3);
+        CHECK(image.getSize() == sf::Vector2u(0, 0));
+    }
+
+    SECTION("Resize with threads")
+    {
+        const sf::Image original = noise(101, 97, 4);
+
+        sf::Image single = original;
+        single.resize(37, 71, sf::Image::Lanczos);
+
+        sf::Image threaded = original;
+        threaded.resize(37, 71, sf::Image::Lanczos, 4);
+
+        bool identical = true;
+        for (unsigned int y = 0; y < 71; ++y)
+            for (unsigned int x = 0; x < 37; ++x)
+                identical = identical && (single.getPixel(x, y) == threaded.getPixel(x, y));
+        CHECK(identical);
+    }
+
+    SECTION("Generate mip chain")
+    {
+        std::vector<sf::Image> levels(1);
+
+        sf::Image image;
+        image.generateMipChain(levels);
+        CHECK(levels.empty());
+
+        image.create(1, 1, sf::Color::Red);
+        image.generateMipChain(levels);
+        CHECK(levels.empty());
+
+        image.create(13, 4, sf::Color(10, 20, 30, 40));
+        image.generateMipChain(levels, sf::Image::Bilinear, 2);
+        REQUIRE(levels.size() == 3);
+        CHECK(levels[0].getSize() == sf::Vector2u(6, 2));
+        CHECK(levels[1].getSize() == sf::Vector2u(3, 1));
+        CHECK(levels[2].getSize() == sf::Vector2u(1, 1));
+        CHECK(levels[2].getPixel(0, 0) == sf::Color(10, 20, 30, 40));
+
+        // Box levels of a power of two image average the pixels of the base
+        image.create(4, 4, sf::Color::Black);
+        image.setPixel(0, 0, sf::Color(160, 80, 40));
+        image.generateMipChain(levels);
+        REQUIRE(levels.size() == 2);
+        CHECK(levels[0].getPixel(0, 0) == sf::Color(40, 20, 10));
+        CHECK(levels[1].getPixel(0, 0) == sf::Color(10, 5, 3));
+    }
+}
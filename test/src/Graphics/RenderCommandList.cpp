@@ -0,0 +1,210 @@
+#include <SFML/Graphics/InstanceBuffer.hpp>
+#include <SFML/Graphics/RenderCommandList.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/Thread.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    // Render target that stores the vertices of each draw call instead of drawing them
+    class CaptureTarget : public sf::RenderTarget
+    {
+    public:
+
+        CaptureTarget()
+        {
+            initialize();
+        }
+
+        virtual sf::Vector2u getSize() const
+        {
+            return sf::Vector2u(0, 0);
+        }
+
+        virtual bool setActive(bool)
+        {
+            return false;
+        }
+
+        std::vector<sf::Vertex> vertices;
+        std::vector<std::size_t> counts;
+        std::vector<const sf::InstanceBuffer*> instanceBuffers;
+
+    protected:
+
+        virtual bool interceptDraw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType, const sf::RenderStates&)
+        {
+            this->vertices.insert(this->vertices.end(), vertices, vertices + vertexCount);
+            counts.push_back(vertexCount);
+            return true;
+        }
+
+        virtual bool interceptDraw(const sf::VertexBuffer&, const sf::InstanceBuffer& instanceBuffer, const sf::RenderStates&)
+        {
+            instanceBuffers.push_back(&instanceBuffer);
+            return true;
+        }
+    };
+
+    // Drawable made of instances of a vertex buffer
+    struct Instances : sf::Drawable
+    {
+        sf::VertexBuffer   vertexBuffer;
+        sf::InstanceBuffer instanceBuffer;
+
+        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const
+        {
+            target.drawInstanced(vertexBuffer, instanceBuffer, states);
+        }
+    };
+
+    sf::Vertex makeVertex(float x)
+    {
+        return sf::Vertex(sf::Vector2f(x, 0));
+    }
+
+    struct Job
+    {
+        sf::RenderCommandList* list;
+        float                  value;
+    };
+
+    void record(Job* job)
+    {
+        sf::VertexArray array(sf::Points, 1);
+        array[0] = makeVertex(job->value);
+
+        for (int i = 0; i < 100; ++i)
+            job->list->draw(array);
+    }
+
+    struct InstancesJob
+    {
+        sf::RenderCommandList* list;
+        const Instances*       instances;
+    };
+
+    void recordInstances(InstancesJob* job)
+    {
+        job->list->draw(*job->instances);
+    }
+}
+
+TEST_CASE("sf::RenderCommandList class", "[graphics]")
+{
+    SECTION("Construction")
+    {
+        sf::RenderCommandList list;
+        CHECK(list.getCommandCount() == 0);
+        CHECK(list.getVertexCount() == 0);
+    }
+
+    SECTION("Draw calls are replayed in recording order")
+    {
+        sf::RenderCommandList list;
+        sf::Vertex vertices[3] = {makeVertex(3), makeVertex(1), makeVertex(2)};
+
+        list.draw(&vertices[0], 1, sf::Points, sf::BlendAdd);
+        list.draw(&vertices[1], 2, sf::Lines, sf::BlendAlpha);
+        CHECK(list.getCommandCount() == 2);
+        CHECK(list.getVertexCount() == 3);
+
+        CaptureTarget target;
+        list.replay(target);
+
+        REQUIRE(target.counts.size() == 2);
+        CHECK(target.counts[0] == 1);
+        CHECK(target.counts[1] == 2);
+        REQUIRE(target.vertices.size() == 3);
+        CHECK(target.vertices[0].position.x == 3);
+        CHECK(target.vertices[1].position.x == 1);
+        CHECK(target.vertices[2].position.x == 2);
+    }
+
+    SECTION("Drawables are captured when recorded")
+    {
+        sf::RenderCommandList list;
+        sf::VertexArray array(sf::Points, 1);
+        array[0] = makeVertex(5);
+
+        list.draw(array);
+        array[0] = makeVertex(6);
+
+        CaptureTarget target;
+        list.replay(target);
+
+        REQUIRE(target.vertices.size() == 1);
+        CHECK(target.vertices[0].position.x == 5);
+    }
+
+    SECTION("Lists are recorded from worker threads")
+    {
+        sf::RenderCommandList lists[4];
+        Job jobs[4];
+        std::vector<sf::Thread*> threads;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            jobs[i].list = &lists[i];
+            jobs[i].value = static_cast<float>(i);
+            threads.push_back(new sf::Thread(&record, &jobs[i]));
+            threads.back()->launch();
+        }
+
+        for (int i = 0; i < 4; ++i)
+        {
+            threads[i]->wait();
+            delete threads[i];
+        }
+
+        CaptureTarget target;
+        for (int i = 0; i < 4; ++i)
+            lists[i].replay(target);
+
+        REQUIRE(target.vertices.size() == 400);
+        CHECK(target.vertices[0].position.x == 0);
+        CHECK(target.vertices[399].position.x == 3);
+    }
+
+    SECTION("Instanced draws are recorded from worker threads")
+    {
+        sf::RenderCommandList list;
+        Instances instances;
+        instances.instanceBuffer.resize(3);
+
+        InstancesJob job;
+        job.list = &list;
+        job.instances = &instances;
+
+        sf::Thread thread(&recordInstances, &job);
+        thread.launch();
+        thread.wait();
+
+        CHECK(list.getCommandCount() == 1);
+
+        CaptureTarget target;
+        list.replay(target);
+
+        CHECK(target.vertices.empty());
+        REQUIRE(target.instanceBuffers.size() == 1);
+        CHECK(target.instanceBuffers[0] == &instances.instanceBuffer);
+    }
+
+    SECTION("Clear")
+    {
+        sf::RenderCommandList list;
+        sf::Vertex vertex;
+
+        list.draw(&vertex, 1, sf::Points);
+        list.clear();
+        CHECK(list.getCommandCount() == 0);
+        CHECK(list.getVertexCount() == 0);
+
+        CaptureTarget target;
+        list.replay(target);
+        CHECK(target.vertices.empty());
+    }
+}
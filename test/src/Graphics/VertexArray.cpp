@@ -0,0 +1,123 @@
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    // Render target that stores the vertices of each draw call instead of drawing them
+    class CaptureTarget : public sf::RenderTarget
+    {
+    public:
+
+        CaptureTarget()
+        {
+            initialize();
+        }
+
+        virtual sf::Vector2u getSize() const
+        {
+            return sf::Vector2u(0, 0);
+        }
+
+        virtual bool setActive(bool)
+        {
+            return false;
+        }
+
+        std::vector<sf::Vertex> vertices;
+        std::vector<sf::PrimitiveType> types;
+
+    protected:
+
+        virtual bool interceptDraw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type, const sf::RenderStates&)
+        {
+            this->vertices.insert(this->vertices.end(), vertices, vertices + vertexCount);
+            types.push_back(type);
+            return true;
+        }
+    };
+
+    sf::Vertex makeVertex(float x)
+    {
+        return sf::Vertex(sf::Vector2f(x, 0));
+    }
+}
+
+TEST_CASE("sf::VertexArray class", "[graphics]")
+{
+    SECTION("Construction")
+    {
+        sf::VertexArray array(sf::Triangles, 4);
+        CHECK(array.getVertexCount() == 4);
+        CHECK(array.getIndexCount() == 0);
+        CHECK(array.getIndices() == NULL);
+    }
+
+    SECTION("Indices")
+    {
+        sf::VertexArray array(sf::Triangles, 4);
+        array.appendIndex(0);
+        array.appendIndex(2);
+        array.resizeIndices(3);
+        REQUIRE(array.getIndexCount() == 3);
+        CHECK(array.getIndices()[0] == 0);
+        CHECK(array.getIndices()[1] == 2);
+        CHECK(array.getIndices()[2] == 0);
+
+        array.clearIndices();
+        CHECK(array.getIndexCount() == 0);
+        CHECK(array.getVertexCount() == 4);
+
+        array.appendIndex(1);
+        array.clear();
+        CHECK(array.getIndexCount() == 0);
+        CHECK(array.getVertexCount() == 0);
+    }
+
+    SECTION("Drawing without indices")
+    {
+        sf::VertexArray array(sf::Points, 2);
+        array[0] = makeVertex(1);
+        array[1] = makeVertex(2);
+
+        CaptureTarget target;
+        target.draw(array);
+
+        REQUIRE(target.vertices.size() == 2);
+        CHECK(target.vertices[0].position.x == 1);
+        CHECK(target.vertices[1].position.x == 2);
+    }
+
+    SECTION("Drawing with indices")
+    {
+        sf::VertexArray array(sf::Triangles, 4);
+        for (std::size_t i = 0; i < 4; ++i)
+            array[i] = makeVertex(static_cast<float>(i));
+
+        const sf::Uint32 indices[6] = {0, 1, 2, 0, 2, 3};
+        for (std::size_t i = 0; i < 6; ++i)
+            array.appendIndex(indices[i]);
+
+        CaptureTarget target;
+        target.draw(array);
+
+        REQUIRE(target.types.size() == 1);
+        CHECK(target.types[0] == sf::Triangles);
+        REQUIRE(target.vertices.size() == 6);
+        for (std::size_t i = 0; i < 6; ++i)
+            CHECK(target.vertices[i].position.x == static_cast<float>(indices[i]));
+    }
+
+    SECTION("Out of range indices skip drawing")
+    {
+        sf::VertexArray array(sf::Points, 2);
+        array.appendIndex(0);
+        array.appendIndex(2);
+
+        CaptureTarget target;
+        target.draw(array);
+
+        CHECK(target.vertices.empty());
+    }
+}